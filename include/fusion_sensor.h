@@ -112,6 +112,14 @@ public:
 	virtual void set_fusion_sensor_handler(sensor::fusion_sensor_handler* handler)
 	{
 	}
+
+	/* called once the required sensors have updated all the events they
+	 * read at once, e.g. their FIFO bursts. OP_SUCCESS has get_data()
+	 * called as after update() */
+	virtual int update_done(void)
+	{
+		return OP_DEFAULT;
+	}
 };
 
 #endif /* __FUSION_SENSOR_H__ */
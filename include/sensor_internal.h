@@ -223,6 +223,19 @@ bool sensord_is_wakeup_supported(sensor_t sensor);
  */
 int sensord_connect(sensor_t sensor);
 
+/**
+ * @brief Connect several sensors as one listener, whose events are frames of their samples aligned in time.
+ *
+ * The listener is driven like one made by sensord_connect(), with the first sensor as its sensor.
+ * Once per interval, a sensor_events_cb_t gets a frame of count records, in the order of sensors;
+ * a batch holds several frames back to back. See sensord_sync_e for how the samples are aligned.
+ *
+ * @param[in] sensors the sensors, SENSORD_SYNC_MAX_SENSORS at most
+ * @param[in] count the count of sensors
+ * @return a handle of the listener on success, otherwise negative value
+ */
+int sensord_connect_sync(sensor_t *sensors, int count);
+
 /**
  * @brief Disconnect a given sensor.
  *
@@ -469,6 +482,16 @@ bool sensord_send_command(int handle, const char *command, int command_len);
  */
 bool sensord_get_data(int handle, unsigned int data_id, sensor_data_t* sensor_data);
 
+/**
+ * @brief get the latest data of several connected sensors in one call
+ *
+ * @param[in] handles the handles of the connected sensors.
+ * @param[in] count the count of handles.
+ * @param[out] sensor_data count records, in the order of handles; a sensor without new data gets a record whose value_count is 0.
+ * @return the count of records with new data on success, otherwise a negative error value.
+ */
+int sensord_get_data_bulk(const int *handles, int count, sensor_data_t* sensor_data);
+
 /**
  * @brief get sensor data from a connected sensor
  *
@@ -490,6 +513,23 @@ bool sensord_flush(int handle);
 
 bool sensord_set_passive_mode(int handle, bool passive);
 
+typedef struct {
+	unsigned long long count;
+	unsigned long long p50;		/* us */
+	unsigned long long p99;		/* us */
+	unsigned long long p999;	/* us */
+	unsigned long long max;		/* us */
+} sensord_latency_t;
+
+/**
+ * @brief get the latency distribution of a delivery stage, as seen by this process
+ *
+ * @param[in] stage one of sensord_latency_stage_e, the client stages are measured here.
+ * @param[out] latency percentiles of the stage since the process started.
+ * @return 0 on success, otherwise a negative error value.
+ */
+int sensord_get_latency(int stage, sensord_latency_t *latency);
+
 
 /* Sensor Internal API using URI */
 int sensord_get_default_sensor_by_uri(const char *uri, sensor_t *sensor);
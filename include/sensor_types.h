@@ -240,6 +240,15 @@ enum sensord_attribute_e {
 	SENSORD_ATTRIBUTE_MAX_BATCH_LATENCY,
 	SENSORD_ATTRIBUTE_PASSIVE_MODE,
 	SENSORD_ATTRIBUTE_FLUSH,
+	SENSORD_ATTRIBUTE_DECIMATION_MODE,
+	SENSORD_ATTRIBUTE_DELIVERY_MODE,
+	SENSORD_ATTRIBUTE_DELTA_THRESHOLD,
+	SENSORD_ATTRIBUTE_HEARTBEAT,
+	SENSORD_ATTRIBUTE_AGGREGATION,
+	SENSORD_ATTRIBUTE_AGGREGATION_WINDOW,
+	SENSORD_ATTRIBUTE_AGGREGATION_HOP,
+	SENSORD_ATTRIBUTE_SYNC_MODE,
+	SENSORD_ATTRIBUTE_SYNC_TOLERANCE,
 	// 0x50~0x80 Reserved
 };
 
@@ -256,6 +265,72 @@ enum sensord_pause_e {
 	SENSORD_PAUSE_END,
 };
 
+/* how a listener slower than the sensor is thinned out to its interval.
+ * listeners get every sample unless they opt in */
+enum sensord_decimation_e {
+	SENSORD_DECIMATION_NONE = 0,
+	SENSORD_DECIMATION_DROP,
+	SENSORD_DECIMATION_AVERAGE,
+};
+
+/* which samples the server sends to a listener, after the decimation.
+ * a filtered sample never crosses the IPC */
+enum sensord_delivery_e {
+	SENSORD_DELIVERY_ALL = 0,
+	SENSORD_DELIVERY_ON_CHANGE,	/* any value changed */
+	SENSORD_DELIVERY_DELTA,		/* a value moved by a threshold */
+};
+
+/* SENSORD_ATTRIBUTE_DELTA_THRESHOLD is an array of these, one per value,
+ * the last one applies to the rest. a value passes when it moved by
+ * absolute, or by relative times its last delivered magnitude, from the
+ * last delivered sample. a threshold of 0 is not used.
+ * SENSORD_ATTRIBUTE_HEARTBEAT [ms] lets a sample through anyway when
+ * nothing was delivered for that long, 0 to disable. */
+typedef struct sensord_delta_threshold_s {
+	float absolute;
+	float relative;
+} sensord_delta_threshold_s;
+
+/* instead of the samples, the server sends a listener one record per
+ * window of SENSORD_ATTRIBUTE_AGGREGATION_WINDOW [ms], with the function
+ * of each value over the window. windows follow each other, or with a
+ * SENSORD_ATTRIBUTE_AGGREGATION_HOP [ms] shorter than the window, slide
+ * by the hop. the record is stamped with the end of its window. */
+enum sensord_aggregation_e {
+	SENSORD_AGGREGATION_NONE = 0,
+	SENSORD_AGGREGATION_MIN,
+	SENSORD_AGGREGATION_MAX,
+	SENSORD_AGGREGATION_MEAN,
+	SENSORD_AGGREGATION_VARIANCE,
+	SENSORD_AGGREGATION_RMS,
+	SENSORD_AGGREGATION_COUNT,	/* values[0] only */
+};
+
+/* a listener connected by sensord_connect_sync() gets one frame per tick
+ * of its interval, a record per sensor in the order they were given.
+ * NEAREST takes the sample closest to the tick, if it is no further than
+ * SENSORD_ATTRIBUTE_SYNC_TOLERANCE [us] (half the interval by default).
+ * INTERPOLATE takes the samples around the tick, if they are no further
+ * apart than the tolerance (twice the interval by default), and stamps
+ * the record with the tick. a sensor without a sample that fits has a
+ * record with no values. */
+#define SENSORD_SYNC_MAX_SENSORS 8
+
+enum sensord_sync_e {
+	SENSORD_SYNC_NEAREST = 0,
+	SENSORD_SYNC_INTERPOLATE,
+};
+
+enum sensord_latency_stage_e {
+	SENSORD_LATENCY_HAL_TO_NOTIFY = 0,	/* server: HAL read to sensor handler */
+	SENSORD_LATENCY_NOTIFY_TO_WRITE,	/* server: sensor handler to socket write */
+	SENSORD_LATENCY_WRITE_TO_RECEIVE,	/* client: socket write to receive */
+	SENSORD_LATENCY_RECEIVE_TO_DISPATCH,	/* client: receive to callback dispatch */
+	SENSORD_LATENCY_END_TO_END,		/* client: HAL read to callback dispatch */
+	SENSORD_LATENCY_STAGE_MAX,
+};
+
 enum poll_interval_t {
 	POLL_100HZ_MS	= 10,
 	POLL_50HZ_MS	= 20,
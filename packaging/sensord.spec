@@ -67,13 +67,15 @@ Sensor functional testing
 %build
 MAJORVER=`echo %{version} | awk 'BEGIN {FS="."}{print $1}'`
 
-%cmake . -DMAJORVER=${MAJORVER} -DFULLVER=%{version} -DCMAKE_HAL_LIBDIR_PREFIX=%{_hal_libdir}
+%cmake . -DMAJORVER=${MAJORVER} -DFULLVER=%{version} -DCMAKE_HAL_LIBDIR_PREFIX=%{_hal_libdir} \
+	-DLAZY_LOADING=ON
 make %{?_smp_mflags}
 
 %install
 %make_install
 
 mkdir -p %{buildroot}%{_unitdir}
+mkdir -p %{buildroot}%{_localstatedir}/cache/sensord
 
 install -m 0644 %SOURCE1 %{buildroot}%{_unitdir}
 install -m 0644 %SOURCE2 %{buildroot}%{_unitdir}
@@ -105,6 +107,7 @@ echo "You need to reinstall %{name}-dummy to keep using the APIs after uninstall
 %{_unitdir}/sensord.socket
 %{_unitdir}/multi-user.target.wants/sensord.service
 %{_unitdir}/sockets.target.wants/sensord.socket
+%dir %attr(0755,sensor,input) %{_localstatedir}/cache/sensord
 %license LICENSE.APLv2
 
 
@@ -118,6 +118,11 @@ API int sensord_connect(sensor_t sensor)
 	return OP_ERROR;
 }
 
+API int sensord_connect_sync(sensor_t *sensors, int count)
+{
+	return OP_ERROR;
+}
+
 API bool sensord_disconnect(int handle)
 {
 	return false;
@@ -233,6 +238,11 @@ API bool sensord_get_data(int handle, unsigned int data_id, sensor_data_t* senso
 	return false;
 }
 
+API int sensord_get_data_bulk(const int *handles, int count, sensor_data_t* sensor_data)
+{
+	return -ENODATA;
+}
+
 API bool sensord_get_data_list(int handle, unsigned int data_id, sensor_data_t** sensor_data, int* count)
 {
 	return false;
@@ -33,6 +33,7 @@
 #include <thread>
 #include <cmutex.h>
 #include <command_types.h>
+#include <latency_histogram.h>
 
 #include "sensor_reader.h"
 
@@ -49,6 +50,11 @@ typedef struct {
 	char* data;
 	size_t data_size;
 	void *user_data;
+	uint64_t read_stamp;
+	uint64_t receive_stamp;
+	void *acc_cb;		/* raised for the samples whose accuracy changed */
+	void *acc_user_data;
+	int acc_last;		/* accuracy before the first sample */
 } callback_info_s;
 
 typedef GSourceFunc callback_dispatcher_t;
@@ -58,6 +64,36 @@ static std::unordered_map<int, sensor::sensor_listener *> listeners;
 static cmutex lock;
 static uint providerCnt = 0;
 
+static void record_dispatch_latency(callback_info_s *info)
+{
+	uint64_t now = utils::get_timestamp();
+
+	latency_histogram::get(SENSORD_LATENCY_RECEIVE_TO_DISPATCH).record(now - info->receive_stamp);
+
+	if (info->read_stamp)
+		latency_histogram::get(SENSORD_LATENCY_END_TO_END).record(now - info->read_stamp);
+}
+
+/* Called with the lock held, after the event callback, which may have
+ * disconnected the listener */
+static void dispatch_accuracy_changes(callback_info_s *info)
+{
+	ret_if(!info->acc_cb || !info->sensor);
+	ret_if(listeners.find(info->listener_id) == listeners.end());
+
+	sensor_data_t *sensor_data = (sensor_data_t *)info->data;
+	size_t count = info->data_size / sizeof(sensor_data_t);
+	int accuracy = info->acc_last;
+
+	for (size_t i = 0; i < count; ++i) {
+		if (sensor_data[i].accuracy == accuracy)
+			continue;
+
+		accuracy = sensor_data[i].accuracy;
+		((sensor_accuracy_changed_cb_t)info->acc_cb)(info->sensor, sensor_data[i].timestamp, accuracy, info->acc_user_data);
+	}
+}
+
 static gboolean sensor_events_callback_dispatcher(gpointer data)
 {
 	int event_type = 0;
@@ -71,9 +107,12 @@ static gboolean sensor_events_callback_dispatcher(gpointer data)
 	if (info->cb && info->sensor && listeners.find(info->listener_id) != listeners.end()) {
 		size_t element_size =  sizeof(sensor_data_t);
 		size_t count = info->data_size / element_size;
+		record_dispatch_latency(info);
 		((sensor_events_cb_t)info->cb)(info->sensor, event_type, (sensor_data_t*)info->data, count, info->user_data);
 	}
 
+	dispatch_accuracy_changes(info);
+
 	delete [] info->data;
 	delete info;
 	return FALSE;
@@ -90,9 +129,12 @@ static gboolean sensor_event_callback_dispatcher(gpointer data)
 		event_type = CONVERT_TYPE_EVENT(info->sensor->get_type());
 
 	if (info->cb && info->sensor && listeners.find(info->listener_id) != listeners.end()) {
+		record_dispatch_latency(info);
 		((sensor_cb_t)info->cb)(info->sensor, event_type, (sensor_data_t*)info->data, info->user_data);
 	}
 
+	dispatch_accuracy_changes(info);
+
 	delete [] info->data;
 	delete info;
 	return FALSE;
@@ -104,10 +146,7 @@ static gboolean sensor_accuracy_changed_callback_dispatcher(gpointer data)
 
 	AUTOLOCK(lock);
 
-	if (info->cb && info->sensor && listeners.find(info->listener_id) != listeners.end()) {
-		sensor_data_t * sensor_data = (sensor_data_t *)info->data;
-		((sensor_accuracy_changed_cb_t)info->cb)(info->sensor, sensor_data->timestamp, sensor_data->accuracy, info->user_data);
-	}
+	dispatch_accuracy_changes(info);
 
 	delete [] info->data;
 	delete info;
@@ -149,12 +188,14 @@ static gboolean sensor_attribute_str_changed_callback_dispatcher(gpointer data)
 class sensor_listener_channel_handler : public ipc::channel_handler
 {
 public:
-	sensor_listener_channel_handler(int id, sensor_t sensor, void* cb, void *user_data, callback_dispatcher_t dispatcher)
+	sensor_listener_channel_handler(int id, sensor::sensor_listener *listener, void* cb, void *user_data, callback_dispatcher_t dispatcher)
 	: m_listener_id(id)
-	, m_sensor(reinterpret_cast<sensor_info *>(sensor))
+	, m_listener(listener)
+	, m_sensor(reinterpret_cast<sensor_info *>(listener->get_sensor()))
 	, m_cb(cb)
 	, m_user_data(user_data)
 	, m_dispatcher(dispatcher)
+	, m_last_accuracy(SENSOR_ACCURACY_UNDEFINED)
 	{}
 
 	void connected(ipc::channel *ch) {}
@@ -162,18 +203,49 @@ public:
 	void read(ipc::channel *ch, ipc::message &msg)
 	{
 		callback_info_s *info;
+		sensor_listener_channel_handler *acc = NULL;
+		int acc_last = SENSOR_ACCURACY_UNDEFINED;
 		auto size = msg.size();
+		uint64_t now = utils::get_timestamp();
+
+		/* accuracy is carried by the samples, and its callback is raised
+		 * by whichever dispatcher the frame goes to */
+		if (msg.type() == CMD_LISTENER_EVENT) {
+			acc = static_cast<sensor_listener_channel_handler *>(m_listener->get_accuracy_handler());
+			if (acc && !acc->update_accuracy(msg, acc_last))
+				acc = NULL;
+		}
+
+		/* the listener has no event callback, only an unchanged accuracy */
+		ret_if(m_dispatcher == sensor_accuracy_changed_callback_dispatcher && !acc);
+
 		char *data = new(std::nothrow) char[size];
+		retm_if(!data, "Failed to allocate memory");
 
 		memcpy(data, msg.body(), size);
 
+		/* the server stamps event frames, see ipc::message_trailer */
+		if (msg.trailer()->write)
+			latency_histogram::get(SENSORD_LATENCY_WRITE_TO_RECEIVE).record(now - msg.trailer()->write);
+
 		info = new(std::nothrow) callback_info_s();
+		if (!info) {
+			delete [] data;
+			_E("Failed to allocate memory");
+			return;
+		}
+
 		info->listener_id = m_listener_id;
 		info->cb = m_cb;
 		info->sensor = m_sensor;
 		info->data = data;
 		info->data_size = size;
 		info->user_data = m_user_data;
+		info->read_stamp = msg.trailer()->read;
+		info->receive_stamp = now;
+		info->acc_cb = acc ? acc->m_cb : NULL;
+		info->acc_user_data = acc ? acc->m_user_data : NULL;
+		info->acc_last = acc_last;
 
 		g_idle_add(m_dispatcher, info);
 	}
@@ -182,11 +254,32 @@ public:
 	void error_caught(ipc::channel *ch, int error) {}
 
 private:
+	/* keeps the accuracy of the last sample of an event, last is the one
+	 * before it. returns true if any sample of the event changed it */
+	bool update_accuracy(ipc::message &msg, int &last)
+	{
+		sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg.body());
+		int count = msg.size() / sizeof(sensor_data_t);
+		bool changed = false;
+
+		last = m_last_accuracy;
+
+		for (int i = 0; i < count; ++i) {
+			if (data[i].accuracy != m_last_accuracy)
+				changed = true;
+			m_last_accuracy = data[i].accuracy;
+		}
+
+		return changed;
+	}
+
 	int m_listener_id;
+	sensor::sensor_listener *m_listener;
 	sensor_info *m_sensor;
 	void* m_cb;
 	void *m_user_data;
 	callback_dispatcher_t m_dispatcher;
+	int m_last_accuracy;	/* as the accuracy handler of the listener */
 };
 
 /*
@@ -347,6 +440,39 @@ API int sensord_connect(sensor_t sensor)
 	return listener->get_id();
 }
 
+API int sensord_connect_sync(sensor_t *sensors, int count)
+{
+	retvm_if(!sensors || count < 1 || count > SENSORD_SYNC_MAX_SENSORS, -EINVAL, "Invalid parameter");
+
+	int handle = sensord_connect(sensors[0]);
+	retv_if(handle < 0, handle);
+
+	AUTOLOCK(lock);
+
+	auto it = listeners.find(handle);
+	retvm_if(it == listeners.end(), -EIO, "Invalid handle[%d]", handle);
+
+	sensor::sensor_listener *listener = it->second;
+
+	for (int i = 1; i < count; ++i) {
+		int ret = -EINVAL;
+
+		if (manager.is_supported(sensors[i]))
+			ret = listener->add_sync_sensor(sensors[i]);
+
+		if (ret < 0) {
+			_E("Failed to synchronize sensor[%p]", sensors[i]);
+			delete listener;
+			listeners.erase(handle);
+			if (listeners.empty())
+				manager.disconnect();
+			return ret;
+		}
+	}
+
+	return handle;
+}
+
 API bool sensord_disconnect(int handle)
 {
 	sensor::sensor_listener *listener;
@@ -400,9 +526,9 @@ static inline bool sensord_register_event_impl(int handle, unsigned int event_ty
 	}
 
 	if (is_events_callback) {
-		handler = new(std::nothrow)sensor_listener_channel_handler(handle, listener->get_sensor(), (void *)cb, user_data, sensor_events_callback_dispatcher);
+		handler = new(std::nothrow)sensor_listener_channel_handler(handle, listener, (void *)cb, user_data, sensor_events_callback_dispatcher);
 	} else {
-		handler = new(std::nothrow)sensor_listener_channel_handler(handle, listener->get_sensor(), (void *)cb, user_data, sensor_event_callback_dispatcher);
+		handler = new(std::nothrow)sensor_listener_channel_handler(handle, listener, (void *)cb, user_data, sensor_event_callback_dispatcher);
 	}
 
 	if (!handler) {
@@ -470,7 +596,7 @@ API bool sensord_register_accuracy_cb(int handle, sensor_accuracy_changed_cb_t c
 
 	listener = it->second;
 
-	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener->get_sensor(), (void *)cb, user_data, sensor_accuracy_changed_callback_dispatcher);
+	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener, (void *)cb, user_data, sensor_accuracy_changed_callback_dispatcher);
 	retvm_if(!handler, false, "Failed to allocate memory");
 
 	listener->set_accuracy_handler(handler);
@@ -506,7 +632,7 @@ API bool sensord_register_attribute_int_changed_cb(int handle, sensor_attribute_
 
 	listener = it->second;
 
-	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener->get_sensor(), (void *)cb, user_data, sensor_attribute_int_changed_callback_dispatcher);
+	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener, (void *)cb, user_data, sensor_attribute_int_changed_callback_dispatcher);
 	retvm_if(!handler, false, "Failed to allocate memory");
 
 	listener->set_attribute_int_changed_handler(handler);
@@ -542,7 +668,7 @@ API bool sensord_register_attribute_str_changed_cb(int handle, sensor_attribute_
 
 	listener = it->second;
 
-	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener->get_sensor(), (void *)cb, user_data, sensor_attribute_str_changed_callback_dispatcher);
+	handler = new(std::nothrow) sensor_listener_channel_handler(handle, listener, (void *)cb, user_data, sensor_attribute_str_changed_callback_dispatcher);
 	retvm_if(!handler, false, "Failed to allocate memory");
 
 	listener->set_attribute_str_changed_handler(handler);
@@ -789,6 +915,29 @@ API bool sensord_get_data(int handle, unsigned int data_id, sensor_data_t* senso
 	return true;
 }
 
+API int sensord_get_data_bulk(const int *handles, int count, sensor_data_t *sensor_data)
+{
+	int read = 0;
+
+	retvm_if(!handles || !sensor_data || count < 0, -EINVAL, "Invalid parameter");
+
+	AUTOLOCK(lock);
+
+	for (int i = 0; i < count; ++i) {
+		auto it = listeners.find(handles[i]);
+
+		if (it == listeners.end() || it->second->get_sensor_data(&sensor_data[i]) < 0) {
+			sensor_data[i].accuracy = -1;
+			sensor_data[i].value_count = 0;
+			continue;
+		}
+
+		++read;
+	}
+
+	return read;
+}
+
 API bool sensord_get_data_list(int handle, unsigned int data_id, sensor_data_t** sensor_data, int* count)
 {
 	sensor::sensor_listener *listener;
@@ -846,6 +995,23 @@ API bool sensord_set_passive_mode(int handle, bool passive)
 	return true;
 }
 
+API int sensord_get_latency(int stage, sensord_latency_t *latency)
+{
+	retvm_if(!latency, -EINVAL, "Invalid parameter");
+	retvm_if(stage < 0 || stage >= SENSORD_LATENCY_STAGE_MAX, -EINVAL,
+			"Invalid stage[%d]", stage);
+
+	latency_histogram &histogram = latency_histogram::get(stage);
+
+	latency->count = histogram.count();
+	latency->p50 = histogram.percentile(50);
+	latency->p99 = histogram.percentile(99);
+	latency->p999 = histogram.percentile(99.9);
+	latency->max = histogram.max();
+
+	return OP_SUCCESS;
+}
+
 /* Sensor Internal API using URI */
 API int sensord_get_default_sensor_by_uri(const char *uri, sensor_t *sensor)
 {
@@ -1075,7 +1241,6 @@ API int sensord_provider_publish(sensord_provider_h provider, sensor_data_t data
 
 	sensor_provider *p = static_cast<sensor_provider *>(provider);
 
-	/* TODO: synchronous call is enough? */
 	return p->publish(data);
 }
 
@@ -49,12 +49,10 @@ public:
 	{
 		switch (msg.header()->type) {
 		case CMD_LISTENER_EVENT:
+			/* the event handler raises the accuracy callback as well */
 			if (m_listener->get_event_handler()) {
 				m_listener->get_event_handler()->read(ch, msg);
-			}
-			break;
-		case CMD_LISTENER_ACC_EVENT:
-			if (m_listener->get_accuracy_handler()) {
+			} else if (m_listener->get_accuracy_handler()) {
 				m_listener->get_accuracy_handler()->read(ch, msg);
 			}
 			break;
@@ -96,6 +94,9 @@ sensor_listener::sensor_listener(sensor_t sensor)
 , m_attr_str_changed_handler(NULL)
 , m_connected(false)
 , m_started(false)
+, m_shared_seq(0)
+, m_shared_failed(false)
+, m_shared_stale(false)
 {
 	init();
 }
@@ -114,6 +115,9 @@ sensor_listener::sensor_listener(sensor_t sensor, ipc::event_loop *loop)
 , m_loop(loop)
 , m_connected(false)
 , m_started(false)
+, m_shared_seq(0)
+, m_shared_failed(false)
+, m_shared_stale(false)
 {
 	init();
 }
@@ -171,6 +175,8 @@ void sensor_listener::deinit(void)
 
 	m_attributes_int.clear();
 	m_attributes_str.clear();
+	m_sync_sensors.clear();
+	m_shared.detach();
 	_D("Deinitialized..");
 }
 
@@ -196,6 +202,16 @@ void sensor_listener::restore(void)
 
 	_D("Restoring sensor listener");
 
+	/* the segment belonged to the previous daemon, it is remapped by the
+	 * next reader rather than here, under its feet */
+	m_shared_stale.store(true);
+
+	/* the members go first, start() turns them on */
+	std::vector<sensor_info *> sync_sensors;
+	sync_sensors.swap(m_sync_sensors);
+	for (auto it = sync_sensors.begin(); it != sync_sensors.end(); ++it)
+		add_sync_sensor(static_cast<sensor_t>(*it));
+
 	/* Restore attributes/status */
 	if (m_started.load())
 		start();
@@ -212,6 +228,29 @@ void sensor_listener::restore(void)
 	if (power != m_attributes_int.end())
 		set_attribute(SENSORD_ATTRIBUTE_PAUSE_POLICY, m_attributes_int[SENSORD_ATTRIBUTE_PAUSE_POLICY]);
 
+	auto threshold = m_attributes_str.find(SENSORD_ATTRIBUTE_DELTA_THRESHOLD);
+	if (threshold != m_attributes_str.end()) {
+		std::vector<char> value = threshold->second;
+		set_attribute(SENSORD_ATTRIBUTE_DELTA_THRESHOLD, value.data(), value.size());
+	}
+
+	auto heartbeat = m_attributes_int.find(SENSORD_ATTRIBUTE_HEARTBEAT);
+	if (heartbeat != m_attributes_int.end())
+		set_attribute(SENSORD_ATTRIBUTE_HEARTBEAT, m_attributes_int[SENSORD_ATTRIBUTE_HEARTBEAT]);
+
+	const int processing[] = {SENSORD_ATTRIBUTE_AGGREGATION_WINDOW,
+			SENSORD_ATTRIBUTE_AGGREGATION_HOP, SENSORD_ATTRIBUTE_AGGREGATION,
+			SENSORD_ATTRIBUTE_SYNC_MODE, SENSORD_ATTRIBUTE_SYNC_TOLERANCE};
+	for (unsigned int i = 0; i < sizeof(processing) / sizeof(processing[0]); ++i) {
+		auto attr = m_attributes_int.find(processing[i]);
+		if (attr != m_attributes_int.end())
+			set_attribute(processing[i], attr->second);
+	}
+
+	auto delivery = m_attributes_int.find(SENSORD_ATTRIBUTE_DELIVERY_MODE);
+	if (delivery != m_attributes_int.end())
+		set_attribute(SENSORD_ATTRIBUTE_DELIVERY_MODE, m_attributes_int[SENSORD_ATTRIBUTE_DELIVERY_MODE]);
+
 	_D("Restored listener[%d]", get_id());
 }
 
@@ -358,6 +397,35 @@ void sensor_listener::unset_attribute_str_changed_handler(void)
 	m_attr_str_changed_handler = NULL;
 }
 
+/* the server then sends frames of this sensor and the added ones */
+int sensor_listener::add_sync_sensor(sensor_t sensor)
+{
+	ipc::message msg;
+	ipc::message reply;
+	cmd_listener_add_sync_sensor_t buf = {0, };
+	sensor_info *info = reinterpret_cast<sensor_info *>(sensor);
+
+	retvm_if(!m_cmd_channel, -EINVAL, "Failed to connect to server");
+	retvm_if(info->get_uri().size() >= NAME_MAX, -EINVAL, "Invalid sensor");
+
+	buf.listener_id = m_id;
+	memcpy(buf.sensor, info->get_uri().c_str(), info->get_uri().size());
+	msg.set_type(CMD_LISTENER_ADD_SYNC_SENSOR);
+	msg.enclose((char *)&buf, sizeof(buf));
+
+	m_cmd_channel->send_sync(msg);
+	m_cmd_channel->read_sync(reply);
+
+	if (reply.header()->err < 0) {
+		_E("Failed to add sensor[%s] to listener[%d]", info->get_uri().c_str(), get_id());
+		return reply.header()->err;
+	}
+
+	m_sync_sensors.push_back(info);
+
+	return OP_SUCCESS;
+}
+
 int sensor_listener::start(void)
 {
 	ipc::message msg;
@@ -634,8 +702,66 @@ void sensor_listener::update_attribute(int attribute, const char *value, int len
 	_I("Update_attribute(str) listener[%d] attribute[%d] value[%s] attributes size[%zu]", get_id(), attribute, value, m_attributes_int.size());
 }
 
+bool sensor_listener::is_display_oriented(void)
+{
+	auto orientation = m_attributes_int.find(SENSORD_ATTRIBUTE_AXIS_ORIENTATION);
+
+	return orientation == m_attributes_int.end() ||
+			orientation->second == SENSORD_AXIS_DISPLAY_ORIENTED;
+}
+
+/* Asks the daemon for the sensor's shared sample once. The daemon checks
+ * the privileges before handing the fd out; if it refuses, the listener
+ * keeps reading through the socket. */
+bool sensor_listener::attach_shared_sample(void)
+{
+	if (m_shared_stale.exchange(false)) {
+		m_shared.detach();
+		m_shared_seq = 0;
+		m_shared_failed = false;
+	}
+
+	retv_if(m_shared.is_valid(), true);
+	retv_if(m_shared_failed || !m_cmd_channel, false);
+
+	ipc::message msg;
+	ipc::message reply;
+	cmd_listener_get_data_fd_t buf;
+
+	buf.listener_id = m_id;
+	msg.set_type(CMD_LISTENER_GET_DATA_FD);
+	msg.enclose((char *)&buf, sizeof(buf));
+
+	m_shared_failed = true;
+
+	retv_if(!m_cmd_channel->send_sync(msg) || !m_cmd_channel->read_sync(reply), false);
+	retv_if(reply.header()->err < 0, false);
+
+	int fd = m_cmd_channel->read_fd();
+	retvm_if(fd < 0, false, "Failed to receive shared sample of listener[%d]", get_id());
+	retv_if(!m_shared.attach(fd), false);
+
+	m_shared_failed = false;
+
+	_I("Listener[%d] reads sensor data from shared memory", get_id());
+
+	return true;
+}
+
+/* Each listener sees a sample once, as it did when the daemon cleared its
+ * cache on every read */
 int sensor_listener::get_sensor_data(sensor_data_t *data)
 {
+	if (attach_shared_sample()) {
+		if (!m_shared.read(*data, is_display_oriented(), m_shared_seq)) {
+			data->accuracy = -1;
+			data->value_count = 0;
+			return OP_ERROR;
+		}
+
+		return OP_SUCCESS;
+	}
+
 	ipc::message msg;
 	ipc::message reply;
 	cmd_listener_get_data_t buf;
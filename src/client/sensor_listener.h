@@ -26,6 +26,7 @@
 #include <event_loop.h>
 #include <sensor_info.h>
 #include <sensor_types.h>
+#include <shared_sample.h>
 #include <map>
 #include <atomic>
 #include <vector>
@@ -76,6 +77,7 @@ public:
 	void update_attribute(int attribute, const char *value, int len);
 	int get_sensor_data(sensor_data_t *data);
 	int get_sensor_data_list(sensor_data_t **data, int *count);
+	int add_sync_sensor(sensor_t sensor);
 	int flush(void);
 
 	void restore(void);
@@ -88,6 +90,9 @@ private:
 	void disconnect(void);
 	bool is_connected(void);
 
+	bool attach_shared_sample(void);
+	bool is_display_oriented(void);
+
 	int m_id;
 	sensor_info *m_sensor;
 
@@ -105,6 +110,13 @@ private:
 	std::atomic<bool> m_started;
 	std::map<int, int> m_attributes_int;
 	std::map<int, std::vector<char>> m_attributes_str;
+	std::vector<sensor_info *> m_sync_sensors;
+
+	/* the latest sample, mapped on the first get_sensor_data() */
+	shared_sample m_shared;
+	uint32_t m_shared_seq;
+	bool m_shared_failed;
+	std::atomic<bool> m_shared_stale;
 };
 
 }
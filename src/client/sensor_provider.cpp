@@ -28,18 +28,43 @@
 #include <command_types.h>
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 
 #include "sensor_provider_channel_handler.h"
 
 #define DEFAULT_RESOLUTION 0.1
 
+/* frames must stay below MAX_MSG_CAPACITY to be accepted by the channel */
+#define MAX_EVENTS_PER_FRAME ((MAX_MSG_CAPACITY - 1) / sizeof(sensor_data_t))
+#define MAX_PENDING_EVENTS 1024
+
 using namespace sensor;
 
+/* Flushes the pending samples whenever the socket becomes writable again */
+class sensor_provider::publish_handler : public ipc::event_handler
+{
+public:
+	publish_handler(sensor_provider *provider)
+	: m_provider(provider)
+	{}
+
+	bool handle(int fd, ipc::event_condition condition)
+	{
+		/* on hangup the send fails and the pending samples are discarded */
+		return m_provider->flush();
+	}
+
+private:
+	sensor_provider *m_provider;
+};
+
 sensor_provider::sensor_provider(const char *uri)
 : m_client(NULL)
 , m_channel(NULL)
 , m_handler(NULL)
 , m_connected(false)
+, m_publish_event_id(0)
+, m_dropped(0)
 {
 	init(uri);
 }
@@ -156,6 +181,8 @@ bool sensor_provider::disconnect(void)
 	retv_if(!is_connected(), false);
 	m_connected.store(false);
 
+	clear_pending();
+
 	m_channel->disconnect();
 	delete m_channel;
 	m_channel = NULL;
@@ -175,24 +202,107 @@ void sensor_provider::restore(void)
 
 int sensor_provider::publish(const sensor_data_t &data)
 {
-	ipc::message msg;
-	msg.set_type(CMD_PROVIDER_PUBLISH);
-	msg.enclose((const void *)(&data), sizeof(data));
+	return publish(&data, 1);
+}
 
-	m_channel->send_sync(msg);
+/* Samples are written with non-blocking sends, so a slow server never
+ * stalls the caller. Whatever the socket cannot take right now is kept
+ * and coalesced into full frames once it becomes writable again. */
+int sensor_provider::publish(const sensor_data_t data[], const int count)
+{
+	retvm_if(!data || count <= 0, -EINVAL, "Invalid parameter");
+	retvm_if(!is_connected(), -EIO, "Provider is not connected");
+
+	AUTOLOCK(m_publish_lock);
+
+	int sent = 0;
+
+	/* keep the order, earlier samples go out first */
+	if (m_pending.empty()) {
+		sent = send_events(data, count);
+		retv_if(sent < 0, sent);
+		retv_if(sent == count, OP_SUCCESS);
+	}
+
+	m_pending.insert(m_pending.end(), data + sent, data + count);
+
+	if (m_pending.size() > MAX_PENDING_EVENTS) {
+		size_t overflow = m_pending.size() - MAX_PENDING_EVENTS;
+		m_pending.erase(m_pending.begin(), m_pending.begin() + overflow);
+		m_dropped += overflow;
+		_W("Server is too slow, dropped %u events of [%s]", m_dropped, get_uri());
+	}
+
+	retv_if(m_publish_event_id != 0, OP_SUCCESS);
+
+	publish_handler *handler = new(std::nothrow) publish_handler(this);
+	retvm_if(!handler, -ENOMEM, "Failed to allocate memory");
+
+	m_publish_event_id = m_loop.add_event(m_channel->get_fd(),
+			(ipc::EVENT_OUT | ipc::EVENT_HUP | ipc::EVENT_NVAL), handler);
+	if (m_publish_event_id == 0) {
+		delete handler;
+		_E("Failed to add publish event handler");
+		return OP_ERROR;
+	}
 
 	return OP_SUCCESS;
 }
 
-int sensor_provider::publish(const sensor_data_t data[], const int count)
+/* Returns the number of samples the socket took, or a negative error */
+int sensor_provider::send_events(const sensor_data_t data[], int count)
 {
-	ipc::message msg;
-	msg.set_type(CMD_PROVIDER_PUBLISH);
-	msg.enclose((const void *)data, sizeof(sensor_data_t) * count);
+	int sent = 0;
 
-	m_channel->send_sync(msg);
+	while (sent < count) {
+		int n = std::min<int>(count - sent, MAX_EVENTS_PER_FRAME);
+		size_t size = sizeof(sensor_data_t) * n;
 
-	return OP_SUCCESS;
+		ipc::message msg(size);
+		msg.set_type(CMD_PROVIDER_PUBLISH);
+		msg.enclose((const void *)(data + sent), size);
+
+		int ret = m_channel->send_frame(msg);
+		if (ret == -EAGAIN)
+			break;
+		retv_if(ret < 0, ret);
+
+		sent += n;
+	}
+
+	return sent;
+}
+
+/* Returns true while samples are still waiting for the socket */
+bool sensor_provider::flush(void)
+{
+	AUTOLOCK(m_publish_lock);
+
+	if (!m_pending.empty()) {
+		int sent = send_events(m_pending.data(), m_pending.size());
+
+		if (sent < 0)
+			m_pending.clear();
+		else
+			m_pending.erase(m_pending.begin(), m_pending.begin() + sent);
+	}
+
+	retv_if(!m_pending.empty(), true);
+
+	m_publish_event_id = 0;
+	return false;
+}
+
+void sensor_provider::clear_pending(void)
+{
+	AUTOLOCK(m_publish_lock);
+
+	m_pending.clear();
+
+	if (m_publish_event_id != 0) {
+		m_loop.remove_event(m_publish_event_id);
+		m_publish_event_id = 0;
+	}
 }
 
 bool sensor_provider::is_connected(void)
@@ -27,7 +27,9 @@
 #include <sensor_internal.h>
 #include <sensor_info.h>
 #include <sensor_types.h>
+#include <cmutex.h>
 #include <map>
+#include <vector>
 #include <atomic>
 
 namespace sensor {
@@ -54,6 +56,7 @@ public:
 
 private:
 	class channel_handler;
+	class publish_handler;
 
 	bool init(const char *uri);
 	void deinit(void);
@@ -63,6 +66,10 @@ private:
 	int serialize(sensor_info *info, char **bytes);
 	int send_sensor_info(sensor_info *info);
 
+	int send_events(const sensor_data_t data[], int count);
+	bool flush(void);
+	void clear_pending(void);
+
 	sensor_info m_sensor;
 
 	ipc::ipc_client *m_client;
@@ -70,6 +77,12 @@ private:
 	ipc::event_loop m_loop;
 	channel_handler *m_handler;
 	std::atomic<bool> m_connected;
+
+	/* samples the socket could not take yet, coalesced into the next frames */
+	std::vector<sensor_data_t> m_pending;
+	uint64_t m_publish_event_id;
+	unsigned int m_dropped;
+	cmutex m_publish_lock;
 };
 
 }
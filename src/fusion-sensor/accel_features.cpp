@@ -0,0 +1,76 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "accel_features.h"
+
+#include <cmath>
+#include <string.h>
+
+#include "fusion_util.h"
+
+#define STILL_THRESHOLD 0.1f
+#define MOVING_THRESHOLD 0.9f
+
+static __thread accel_features last_features;
+static __thread bool has_last_features;
+
+static void compute_features(const sensor_data_t *data, accel_features &f)
+{
+	float x = data->values[0];
+	float y = data->values[1];
+	float z = data->values[2];
+
+	f.timestamp = data->timestamp;
+	f.raw[0] = x;
+	f.raw[1] = y;
+	f.raw[2] = z;
+
+	f.magnitude = sqrtf(x * x + y * y + z * z);
+	f.roll = FUSION_ATAN2F(x, y);
+
+	if (f.magnitude > 0) {
+		f.unit[0] = x / f.magnitude;
+		f.unit[1] = y / f.magnitude;
+		f.unit[2] = z / f.magnitude;
+		f.pitch = FUSION_ASINF(z / f.magnitude);
+	} else {
+		f.unit[0] = f.unit[1] = f.unit[2] = 0;
+		f.pitch = 0;
+	}
+
+	f.gravity_error = fabsf(f.magnitude - (float)ACCEL_GRAVITY) / (float)ACCEL_GRAVITY;
+
+	f.flags = 0;
+	if (f.gravity_error < STILL_THRESHOLD)
+		f.flags |= ACCEL_FEATURE_STILL;
+	else if (f.gravity_error > MOVING_THRESHOLD)
+		f.flags |= ACCEL_FEATURE_MOVING;
+}
+
+const accel_features &get_accel_features(const sensor_data_t *data)
+{
+	if (has_last_features && last_features.timestamp == data->timestamp &&
+			!memcmp(last_features.raw, data->values, sizeof(last_features.raw)))
+		return last_features;
+
+	compute_features(data, last_features);
+	has_last_features = true;
+
+	return last_features;
+}
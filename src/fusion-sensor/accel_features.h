@@ -0,0 +1,58 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __ACCEL_FEATURES_H__
+#define __ACCEL_FEATURES_H__
+
+#include <sensor_types.h>
+
+#define ACCEL_GRAVITY 9.80665
+
+/* |a| within 10% of g, the device is most likely held still */
+#define ACCEL_FEATURE_STILL  0x1
+/* |a| off g by more than 90%, the device is shaken or falling */
+#define ACCEL_FEATURE_MOVING 0x2
+
+/************************************************************************
+ * features of an accelerometer sample shared by the sensors built on it.
+ *
+ * angles are in radians. pitch is the elevation of the z axis,
+ * asin(z / |a|), and roll the rotation around it, atan2(x, y).
+ */
+struct accel_features {
+	unsigned long long timestamp;
+	float raw[3];
+	float magnitude;
+	float unit[3];
+	float pitch;
+	float roll;
+	float gravity_error;
+	int flags;
+};
+
+/************************************************************************
+ * returns the features of an accelerometer sample.
+ *
+ * every fusion sensor that requires the accelerometer is handed the
+ * same sample, so the features of the last sample are cached per thread and
+ * computed only once however many sensors ask for them.
+ */
+const accel_features &get_accel_features(const sensor_data_t *data);
+
+#endif /* __ACCEL_FEATURES_H__ */
@@ -20,6 +20,8 @@
 #ifndef __AUTO_ROTATION_ALG_H__
 #define __AUTO_ROTATION_ALG_H__
 
+#include <accel_features.h>
+
 class auto_rotation_alg {
 public:
 	auto_rotation_alg();
@@ -29,7 +31,7 @@ public:
 	virtual bool close(void);
 	virtual bool start(void);
 	virtual bool stop(void);
-	virtual bool get_rotation(float acc[3], unsigned long long timestamp, int prev_rotation, int &rotation) = 0;
+	virtual bool get_rotation(const accel_features &acc, int prev_rotation, int &rotation) = 0;
 };
 
 #endif /* __AUTO_ROTATION_ALG_H__ */
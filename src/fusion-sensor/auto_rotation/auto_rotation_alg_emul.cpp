@@ -86,26 +86,17 @@ int auto_rotation_alg_emul::convert_rotation(int prev_rotation,
 	return new_rotation;
 }
 
-bool auto_rotation_alg_emul::get_rotation(float acc[3],
-		unsigned long long timestamp, int prev_rotation, int &cur_rotation)
+bool auto_rotation_alg_emul::get_rotation(const accel_features &acc,
+		int prev_rotation, int &cur_rotation)
 {
 	const int ROTATION_90 = 90;
 	const int RADIAN = 57.29747;
 
-	double atan_value;
 	int acc_theta;
 	int acc_pitch;
-	double realg;
-	float x, y, z;
 
-	x = acc[0];
-	y = acc[1];
-	z = acc[2];
-
-	atan_value = atan2(x, y);
-	acc_theta = (int)(atan_value * (RADIAN) + 360) % 360;
-	realg = (double)sqrt((x * x) + (y * y) + (z * z));
-	acc_pitch = ROTATION_90 - abs((int) (asin(z / realg) * RADIAN));
+	acc_theta = (int)(acc.roll * (double)RADIAN + 360) % 360;
+	acc_pitch = ROTATION_90 - abs((int) (acc.pitch * (double)RADIAN));
 
 	cur_rotation = convert_rotation(prev_rotation, acc_pitch, acc_theta);
 
@@ -27,7 +27,7 @@ public:
 	auto_rotation_alg_emul();
 	virtual ~auto_rotation_alg_emul();
 
-	bool get_rotation(float acc[3], unsigned long long timestamp,
+	bool get_rotation(const accel_features &acc,
 			int prev_rotation, int &cur_rotation);
 
 private:
@@ -94,12 +94,9 @@ int auto_rotation_sensor::get_required_sensors(const required_sensor_s **sensors
 int auto_rotation_sensor::update(uint32_t id, sensor_data_t *data, int len)
 {
 	int rotation;
-	float acc[3];
-	acc[0] = data->values[0];
-	acc[1] = data->values[1];
-	acc[2] = data->values[2];
+	const accel_features &acc = get_accel_features(data);
 
-	if (!m_alg->get_rotation(acc, data->timestamp, m_rotation, rotation))
+	if (!m_alg->get_rotation(acc, m_rotation, rotation))
 		return OP_ERROR;
 
 	_D("Rotation: %d, ACC[0]: %f, ACC[1]: %f, ACC[2]: %f",
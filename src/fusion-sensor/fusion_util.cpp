@@ -98,15 +98,15 @@ int calculate_rotation_matrix(float *accel, float *geo, float *R, float *I)
 	float Hx = Ey*Az - Ez*Ay;
 	float Hy = Ez*Ax - Ex*Az;
 	float Hz = Ex*Ay - Ey*Ax;
-	float normH =  (float)sqrt(Hx*Hx + Hy*Hy + Hz*Hz);
-	if (normH < 0.1f)
+	float sq_normH = Hx*Hx + Hy*Hy + Hz*Hz;
+	if (sq_normH < 0.01f)
 		return -EINVAL;
 
-	float invH = 1.0f / normH;
+	float invH = FUSION_RSQRTF(sq_normH);
 	Hx *= invH;
 	Hy *= invH;
 	Hz *= invH;
-	float invA = 1.0f / (float)sqrt(Ax*Ax + Ay*Ay + Az*Az);
+	float invA = FUSION_RSQRTF(Ax*Ax + Ay*Ay + Az*Az);
 	Ax *= invA;
 	Ay *= invA;
 	Az *= invA;
@@ -118,7 +118,7 @@ int calculate_rotation_matrix(float *accel, float *geo, float *R, float *I)
 	R[3] = Mx;  R[4] = My;  R[5] = Mz;
 	R[6] = Ax;  R[7] = Ay;	R[8] = Az;
 
-	float invE = 1.0 / (float)sqrt(Ex*Ex + Ey*Ey + Ez*Ez);
+	float invE = FUSION_RSQRTF(Ex*Ex + Ey*Ey + Ez*Ez);
 	float c = (Ex*Mx + Ey*My + Ez*Mz) * invE;
 	float s = (Ex*Ax + Ey*Ay + Ez*Az) * invE;
 
@@ -139,9 +139,9 @@ int quat_to_orientation(const float *quat, float &azimuth, float &pitch, float &
 	if (error < 0)
 		return error;
 
-	azimuth = atan2f(-R[3], R[0])  * RAD2DEGREE;
-	pitch = atan2f(-R[7], R[8])    * RAD2DEGREE;
-	roll = asinf (R[6])            * RAD2DEGREE;
+	azimuth = FUSION_ATAN2F(-R[3], R[0]) * RAD2DEGREE;
+	pitch = FUSION_ATAN2F(-R[7], R[8])   * RAD2DEGREE;
+	roll = FUSION_ASINF(R[6])            * RAD2DEGREE;
 	if (azimuth < 0)
 		azimuth += 360;
 
@@ -20,6 +20,20 @@
 #ifndef _FUSION_UTIL_H_
 #define _FUSION_UTIL_H_
 
+#include <math.h>
+
+#ifdef ENABLE_FAST_MATH
+#include <fast_math.h>
+
+#define FUSION_ATAN2F(y, x) sensor::fast_math::atan2f((y), (x))
+#define FUSION_ASINF(x) sensor::fast_math::asinf(x)
+#define FUSION_RSQRTF(x) sensor::fast_math::rsqrtf(x)
+#else
+#define FUSION_ATAN2F(y, x) atan2f((y), (x))
+#define FUSION_ASINF(x) asinf(x)
+#define FUSION_RSQRTF(x) (1.0f / sqrtf(x))
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -52,7 +52,7 @@ void face_down_alg_impl::update(sensor_data_t *data)
 
 void face_down_alg_impl::remove_old_up_time(void)
 {
-	while (m_oldest_up_time.size() > 0 && (m_current_time - m_oldest_up_time.front() > WINDOW_SIZE))
+	while (!m_oldest_up_time.empty() && (m_current_time - m_oldest_up_time.front() > WINDOW_SIZE))
 		m_oldest_up_time.pop();
 }
 
@@ -83,7 +83,7 @@ unsigned long long face_down_alg_impl::is_facing_down(void)
 unsigned long long face_down_alg_impl::was_facing_up(void)
 {
 	remove_old_up_time();
-	if (m_oldest_up_time.size() == 0)
+	if (m_oldest_up_time.empty())
 		return ULLONG_MAX;
 	return m_oldest_up_time.front();
 }
@@ -20,10 +20,13 @@
 #ifndef __FACE_DOWN_ALG_IMPL_H__
 #define __FACE_DOWN_ALG_IMPL_H__
 
-#include <queue>
+#include <ring_buffer.h>
 
 #include "face_down_alg.h"
 
+/* covers the 2s window at up to 250Hz */
+#define FACE_DOWN_HISTORY 512
+
 class face_down_alg_impl : public virtual face_down_alg {
 public:
 	face_down_alg_impl();
@@ -39,7 +42,7 @@ private:
 	unsigned long long m_current_time;
 	unsigned long long m_last_event_time;
 	unsigned long long m_latest_down_time;
-	std::queue<unsigned long long> m_oldest_up_time;
+	ring_buffer<unsigned long long, FACE_DOWN_HISTORY> m_oldest_up_time;
 };
 
 #endif /* __FACE_DOWN_ALG_IMPL_H__ */
@@ -22,6 +22,7 @@
 #include <sensor_log.h>
 #include <sensor_types.h>
 #include <cmath>
+#include <accel_features.h>
 
 #define NAME_SENSOR "http://tizen.org/sensor/general/gravity/tizen_complementary"
 #define NAME_VENDOR "tizen.org"
@@ -75,8 +76,14 @@ gravity_comp_sensor::gravity_comp_sensor()
 , m_accuracy(-1)
 , m_time(0)
 , m_accel_mag(0)
+, m_accel_flags(0)
 , m_time_new(0)
 {
+	for (int i = 0; i < 3; ++i) {
+		m_angle[i] = INV_ANGLE;
+		m_angle_n[i] = 0;
+		m_velocity[i] = 0;
+	}
 }
 
 gravity_comp_sensor::~gravity_comp_sensor()
@@ -118,11 +125,13 @@ int gravity_comp_sensor::update(uint32_t id, sensor_data_t *data, int len)
 
 void gravity_comp_sensor::fusion_set_accel(sensor_data_t *data)
 {
+	const accel_features &acc = get_accel_features(data);
 	double x = data->values[0];
 	double y = data->values[1];
 	double z = data->values[2];
 
-	m_accel_mag = NORM(x, y, z);
+	m_accel_mag = acc.magnitude;
+	m_accel_flags = acc.flags;
 
 	m_angle_n[0] = ARCTAN(z, y);
 	m_angle_n[1] = ARCTAN(x, z);
@@ -203,12 +212,12 @@ void gravity_comp_sensor::fusion_get_gravity(void)
 
 void gravity_comp_sensor::complementary(unsigned long long time_diff)
 {
-	double err = fabs(m_accel_mag - GRAVITY) / GRAVITY;
-	double tau = (err < 0.1 ? TAU_LOW : err > 0.9 ? TAU_HIGH : TAU_MID);
+	double tau = (m_accel_flags & ACCEL_FEATURE_STILL ? TAU_LOW :
+			m_accel_flags & ACCEL_FEATURE_MOVING ? TAU_HIGH : TAU_MID);
 	double delta_t = (double)time_diff/ US_PER_SEC;
 	double alpha = tau / (tau + delta_t);
 
-	_D("mag, err, tau, dt, alpha = %f, %f, %f, %f, %f", m_accel_mag, err, tau, delta_t, alpha);
+	_D("mag, flags, tau, dt, alpha = %f, %#x, %f, %f, %f", m_accel_mag, m_accel_flags, tau, delta_t, alpha);
 
 	m_angle[0] = complementary(m_angle[0], m_angle_n[0], m_velocity[0], delta_t, alpha);
 	m_angle[1] = complementary(m_angle[1], m_angle_n[1], m_velocity[1], delta_t, alpha);
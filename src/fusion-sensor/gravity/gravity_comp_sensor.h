@@ -46,6 +46,7 @@ private:
 	double m_angle[3];
 	double m_angle_n[3];
 	double m_accel_mag;
+	int m_accel_flags;
 	double m_velocity[3];
 	unsigned long long m_time_new;
 
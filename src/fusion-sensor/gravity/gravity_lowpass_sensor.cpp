@@ -22,6 +22,7 @@
 #include <sensor_log.h>
 #include <sensor_types.h>
 #include <cmath>
+#include <accel_features.h>
 
 #define NAME_SENSOR "http://tizen.org/sensor/general/gravity/tizen_lowpass"
 #define NAME_VENDOR "tizen.org"
@@ -82,16 +83,16 @@ int gravity_lowpass_sensor::get_required_sensors(const required_sensor_s **senso
 
 int gravity_lowpass_sensor::update(uint32_t id, sensor_data_t *data, int len)
 {
-	float x, y, z, norm, alpha, tau, err;
+	float x, y, z, norm, alpha, tau;
+	const accel_features &acc = get_accel_features(data);
 
-	norm = NORM(data->values[0], data->values[1], data->values[2]);
-	x = data->values[0] / norm * GRAVITY;
-	y = data->values[1] / norm * GRAVITY;
-	z = data->values[2] / norm * GRAVITY;
+	x = acc.unit[0] * GRAVITY;
+	y = acc.unit[1] * GRAVITY;
+	z = acc.unit[2] * GRAVITY;
 
 	if (m_time > 0) {
-		err = fabs(norm - GRAVITY) / GRAVITY;
-		tau = (err < 0.1 ? TAU_LOW : err > 0.9 ? TAU_HIGH : TAU_MID);
+		tau = (acc.flags & ACCEL_FEATURE_STILL ? TAU_LOW :
+				acc.flags & ACCEL_FEATURE_MOVING ? TAU_HIGH : TAU_MID);
 		alpha = tau / (tau + (float)(data->timestamp - m_time) / US_PER_SEC);
 		x = alpha * m_x + (1 - alpha) * x;
 		y = alpha * m_y + (1 - alpha) * y;
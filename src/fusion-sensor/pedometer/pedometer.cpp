@@ -28,8 +28,9 @@ pedometer::pedometer()
 , m_step_count(0)
 , m_pedometer_filter()
 , m_some_speed(false)
-, m_acceleration_compensator(DESIRED_RATE)
+, m_acceleration_resampler(0, DESIRED_RATE)
 {
+	m_acceleration_stream = m_acceleration_resampler.add_stream(3, 0, RESAMPLE_HOLD);
 }
 
 pedometer::~pedometer()
@@ -48,22 +49,24 @@ void pedometer::reset(void)
 	m_step_detection.reset();
 	m_pedometer_filter.reset();
 	m_some_speed = false;
-	m_acceleration_compensator.reset();
+	m_acceleration_resampler.reset();
 }
 
 bool pedometer::new_acceleration(pedometer_info *info, timestamp_t timestamp, double acc[])
 {
 	bool result = false;
-	m_acceleration_compensator.add(timestamp, acc);
+	float values[] = {(float)acc[0], (float)acc[1], (float)acc[2]};
+	resampler_frame_s frame;
 	step_event event;
 
-	while (m_acceleration_compensator.has_next()) {
-		double acceleration[3];
-		m_acceleration_compensator.get_next(acceleration);
+	m_acceleration_resampler.push(m_acceleration_stream, timestamp, values);
+
+	while (m_acceleration_resampler.pop(frame)) {
+		const float *acceleration = frame.values[m_acceleration_stream];
 		if (m_step_detection.new_acceleration(timestamp,
-				sqrt(acceleration[0] * acceleration[0]
-					+ acceleration[1] * acceleration[1]
-					+ acceleration[2] * acceleration[2]),
+				sqrt((double)acceleration[0] * acceleration[0]
+					+ (double)acceleration[1] * acceleration[1]
+					+ (double)acceleration[2] * acceleration[2]),
 				&event)) {
 			if (event.m_timestamp != UNKNOWN_TIMESTAMP) {
 				m_step_count++;
@@ -20,7 +20,7 @@
 #include "step_detection.h"
 #include "pedometer_info.h"
 #include "pedometer_speed_filter.h"
-#include "sensor_frequency_compensator.h"
+#include "input_resampler.h"
 #include "timestamp.h"
 
 /************************************************************************
@@ -72,7 +72,10 @@ private:
 	/** some non zero speed was detected. */
 	bool m_some_speed;
 
-	sensor_frequency_compensator m_acceleration_compensator;
+	/** resamples acceleration to the rate the detector is tuned for. */
+	input_resampler m_acceleration_resampler;
+
+	int m_acceleration_stream;
 };
 
 #endif /* __PEDOMETER_H__ */
@@ -79,21 +79,29 @@ int pedometer_sensor::get_required_sensors(const required_sensor_s **sensors)
 int pedometer_sensor::update(uint32_t id, sensor_data_t *data, int len)
 {
 	pedometer_info info;
-	double acc[] = {data->values[0], data->values[1], data->values[2]};
+	int count = len / sizeof(sensor_data_t);
+	bool updated = false;
 
-	if (!m_pedometer.new_acceleration(&info, US_TO_NS(data->timestamp), acc))
-		return OP_ERROR;
+	/* a batch of the FIFO is run through in one go,
+	 * the last step of the batch is reported */
+	for (int i = 0; i < count; ++i) {
+		double acc[] = {data[i].values[0], data[i].values[1], data[i].values[2]};
 
-	m_step_count = info.step_count;
-	m_step_length = info.step_length;
-	m_step_total_length = info.total_step_length;
-	m_step_speed = info.step_speed;
-	m_time = data->timestamp;
+		if (!m_pedometer.new_acceleration(&info, US_TO_NS(data[i].timestamp), acc))
+			continue;
 
-	_D("[%lld] %lld %f %f %f", data->timestamp,
-			info.step_count, info.step_length, info.total_step_length, info.step_speed);
+		m_step_count = info.step_count;
+		m_step_length = info.step_length;
+		m_step_total_length = info.total_step_length;
+		m_step_speed = info.step_speed;
+		m_time = data[i].timestamp;
+		updated = true;
 
-	return OP_SUCCESS;
+		_D("[%lld] %lld %f %f %f", data[i].timestamp,
+				info.step_count, info.step_length, info.total_step_length, info.step_speed);
+	}
+
+	return updated ? OP_SUCCESS : OP_ERROR;
 }
 
 int pedometer_sensor::get_data(sensor_data_t **data, int *len)
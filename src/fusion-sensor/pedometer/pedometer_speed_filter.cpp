@@ -19,11 +19,14 @@
 /** default for maximum step duration in [ns]. currently 2s. */
 static const long long STEP_MAX_DURATION = 2000000000L;
 
+/** number of steps the speed is averaged over. */
+static const int SPEED_STEPS = 2;
+
 pedometer_speed_filter::pedometer_speed_filter()
 : m_last_timestamp(UNKNOWN_TIMESTAMP)
 , m_current_speed(0)
-, m_last_step_length(0)
-, m_last_step_duration(0)
+, m_step_lengths(SPEED_STEPS)
+, m_step_durations(SPEED_STEPS)
 , m_step_max_duration(STEP_MAX_DURATION)
 {
 }
@@ -38,8 +41,8 @@ pedometer_speed_filter::~pedometer_speed_filter()
 void pedometer_speed_filter::clear_speed(void)
 {
 	m_current_speed = 0;
-	m_last_step_length = 0;
-	m_last_step_duration = 0;
+	m_step_lengths.reset();
+	m_step_durations.reset();
 }
 
 /************************************************************************
@@ -71,11 +74,9 @@ void pedometer_speed_filter::new_step(timestamp_t timestamp, double step_length)
 	} else if (m_step_max_duration != 0 && timestamp - m_last_timestamp > m_step_max_duration) {
 		clear_speed();
 	} else if (m_last_timestamp < timestamp) {
-		double step_duration = (timestamp - m_last_timestamp) / 1e9;
-		m_current_speed =
-			(step_length + m_last_step_length) / (step_duration + m_last_step_duration);
-		m_last_step_length = step_length;
-		m_last_step_duration = step_duration;
+		m_step_lengths.filter(step_length);
+		m_step_durations.filter((timestamp - m_last_timestamp) / 1e9);
+		m_current_speed = m_step_lengths.sum() / m_step_durations.sum();
 	} else {
 		return;
 	}
@@ -96,8 +97,8 @@ void pedometer_speed_filter::new_speed(timestamp_t timestamp, double speed)
 			|| timestamp > m_last_timestamp) {
 		m_last_timestamp = timestamp;
 		m_current_speed = speed;
-		m_last_step_length = 0;
-		m_last_step_duration = 0;
+		m_step_lengths.reset();
+		m_step_durations.reset();
 	}
 }
 
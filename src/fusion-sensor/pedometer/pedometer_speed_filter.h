@@ -18,6 +18,7 @@
 #define __PEDOMETER_SPEED_FILTER_H__
 
 #include "timestamp.h"
+#include "streaming_filter.h"
 
 /************************************************************************
  * stores pedometer speed filter state.
@@ -105,11 +106,11 @@ private:
 	/** estimated current speed in [m/s]. */
 	double m_current_speed;
 
-	/** length of last step in [m]. */
-	double m_last_step_length;
+	/** lengths of the last steps in [m]. */
+	moving_average m_step_lengths;
 
-	/** duration of last step in [s]. */
-	double m_last_step_duration;
+	/** durations of the last steps in [s]. */
+	moving_average m_step_durations;
 
 	/** maximum step duration in [ns]. 0 to disable step duration checking. */
 	long long m_step_max_duration;
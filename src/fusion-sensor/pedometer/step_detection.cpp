@@ -33,12 +33,23 @@
 
 #define SLOPE_PARAM -0.75
 
+/* Savitzky-Golay smoother of length 15, quadratic fit */
+#define SG_FILTER_SIZE 15
+
+#define SG_SUM_COEF 1105.0
+
+static const double sg_coefs[SG_FILTER_SIZE] = {
+		-78 / SG_SUM_COEF, -13 / SG_SUM_COEF, 42 / SG_SUM_COEF, 87 / SG_SUM_COEF,
+		122 / SG_SUM_COEF, 147 / SG_SUM_COEF, 162 / SG_SUM_COEF, 167 / SG_SUM_COEF,
+		162 / SG_SUM_COEF, 147 / SG_SUM_COEF, 122 / SG_SUM_COEF, 87 / SG_SUM_COEF,
+		42 / SG_SUM_COEF, -13 / SG_SUM_COEF, -78 / SG_SUM_COEF };
+
 step_detection::step_detection()
 : m_average_filter(AV_FILTER_SIZE)
 , m_average_gfilter(AV_GFILTER_SIZE)
 , m_zero_crossing_up(true)
 , m_zero_crossing_down(false)
-, m_zc_filter()
+, m_zc_filter(sg_coefs, SG_FILTER_SIZE)
 , m_peak_threshold(FAST_PEAK_THRESHOLD)
 , m_use_savitzky(true)
 , m_last_step_timestamp(UNKNOWN_TIMESTAMP)
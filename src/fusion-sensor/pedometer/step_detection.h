@@ -17,9 +17,8 @@
 #ifndef __STEP_DETECTION_H__
 #define __STEP_DETECTION_H__
 
-#include "average_filter.h"
+#include "streaming_filter.h"
 #include "zero_crossing_step_detection.h"
-#include "savitzky_golay_filter15.h"
 #include "step_event.h"
 #include "timestamp.h"
 
@@ -51,12 +50,12 @@ public:
 	void reset(void);
 
 private:
-	average_filter m_average_filter;
-	average_filter m_average_gfilter;
+	moving_average m_average_filter;
+	moving_average m_average_gfilter;
 	zero_crossing_step_detection m_zero_crossing_up;
 	zero_crossing_step_detection m_zero_crossing_down;
 
-	savitzky_golay_filter15 m_zc_filter;
+	fir_filter m_zc_filter;
 	double m_peak_threshold;
 	bool m_use_savitzky;
 	timestamp_t m_last_step_timestamp;
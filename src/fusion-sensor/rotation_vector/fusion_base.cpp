@@ -23,6 +23,8 @@
 #include <sys/types.h>
 #include <sensor_log.h>
 #include <cmath>
+#include <new>
+#include <algorithm>
 #include "fusion_base.h"
 
 const float RAD2DEG = 57.29577951;
@@ -32,8 +34,19 @@ const float ACCEL_MAX_INTERVAL = 0.1f; // 100ms
 const float GYRO_MAX_INTERVAL = 0.05f; // 50ms
 const float MAG_MAX_INTERVAL = 0.1f;   // 100ms
 
+/* indices of m_streams */
+enum {
+	INPUT_ACCEL = 0,
+	INPUT_GYRO,
+	INPUT_MAG,
+	INPUT_MAX,
+};
+
 fusion_base::fusion_base()
-: m_enable_accel(false)
+: m_inputs(FUSION_INPUT_ACCEL | FUSION_INPUT_GYRO | FUSION_INPUT_MAG)
+, m_resampler(NULL)
+, m_window(0)
+, m_enable_accel(false)
 , m_enable_gyro(false)
 , m_enable_magnetic(false)
 , m_x(0)
@@ -45,10 +58,106 @@ fusion_base::fusion_base()
 , m_timestamp_gyro(0)
 , m_timestamp_mag(0)
 {
+	for (int i = 0; i < INPUT_MAX; ++i)
+		m_streams[i] = -1;
 }
 
 fusion_base::~fusion_base()
 {
+	delete m_resampler;
+}
+
+void fusion_base::set_resampling(unsigned long long window, unsigned long long period)
+{
+	delete m_resampler;
+	m_resampler = NULL;
+
+	for (int i = 0; i < INPUT_MAX; ++i)
+		m_streams[i] = -1;
+
+	if (window == 0 && period == 0)
+		return;
+
+	m_resampler = new(std::nothrow) input_resampler(window, period);
+	retm_if(!m_resampler, "Failed to allocate memory");
+
+	/* the common clock waits for every stream, so only the inputs the
+	 * filter uses get one */
+	if (m_inputs & FUSION_INPUT_ACCEL)
+		m_streams[INPUT_ACCEL] = m_resampler->add_stream(3, ACCEL_MAX_INTERVAL * US2S);
+	if (m_inputs & FUSION_INPUT_GYRO)
+		m_streams[INPUT_GYRO] = m_resampler->add_stream(3, GYRO_MAX_INTERVAL * US2S);
+	if (m_inputs & FUSION_INPUT_MAG)
+		m_streams[INPUT_MAG] = m_resampler->add_stream(3, MAG_MAX_INTERVAL * US2S);
+}
+
+bool fusion_base::is_valid(const resampler_frame_s &frame, int input)
+{
+	return m_streams[input] >= 0 && (frame.valid & (1 << m_streams[input]));
+}
+
+void fusion_base::set_batch_latency(void *ob, int latency)
+{
+	unsigned long long window = 0;
+
+	if (latency < 0)
+		m_latencies.erase(ob);
+	else
+		m_latencies[ob] = latency;
+
+	if (!m_latencies.empty()) {
+		int min_latency = m_latencies.begin()->second;
+
+		for (auto it = m_latencies.begin(); it != m_latencies.end(); ++it)
+			min_latency = std::min(min_latency, it->second);
+
+		window = (unsigned long long)min_latency * 1000;
+	}
+
+	if (window == m_window)
+		return;
+
+	m_window = window;
+	set_resampling(window, 0);
+}
+
+void fusion_base::flush(void)
+{
+	if (!m_resampler)
+		return;
+
+	m_resampler->flush();
+	apply_released();
+}
+
+void fusion_base::push(int input, sensor_data_t &data)
+{
+	m_resampler->push(m_streams[input], data.timestamp, data.values);
+	apply_released();
+}
+
+void fusion_base::apply_released(void)
+{
+	resampler_frame_s frame;
+
+	while (m_resampler->pop(frame)) {
+		if (frame.stream < 0) {
+			/* a fixed step: predict with the gyro, then correct. an input
+			 * in a gap is skipped, as the filter does with late samples */
+			if (is_valid(frame, INPUT_GYRO))
+				apply_gyro(frame.timestamp, frame.values[m_streams[INPUT_GYRO]]);
+			if (is_valid(frame, INPUT_ACCEL))
+				apply_accel(frame.timestamp, frame.values[m_streams[INPUT_ACCEL]]);
+			if (is_valid(frame, INPUT_MAG))
+				apply_mag(frame.timestamp, frame.values[m_streams[INPUT_MAG]]);
+		} else if (frame.stream == m_streams[INPUT_ACCEL]) {
+			apply_accel(frame.timestamp, frame.values[frame.stream]);
+		} else if (frame.stream == m_streams[INPUT_GYRO]) {
+			apply_gyro(frame.timestamp, frame.values[frame.stream]);
+		} else if (frame.stream == m_streams[INPUT_MAG]) {
+			apply_mag(frame.timestamp, frame.values[frame.stream]);
+		}
+	}
 }
 
 void fusion_base::clear(void)
@@ -59,14 +168,38 @@ void fusion_base::clear(void)
 }
 
 void fusion_base::push_accel(sensor_data_t &data)
+{
+	if (m_resampler && m_streams[INPUT_ACCEL] >= 0)
+		push(INPUT_ACCEL, data);
+	else
+		apply_accel(data.timestamp, data.values);
+}
+
+void fusion_base::push_gyro(sensor_data_t &data)
+{
+	if (m_resampler && m_streams[INPUT_GYRO] >= 0)
+		push(INPUT_GYRO, data);
+	else
+		apply_gyro(data.timestamp, data.values);
+}
+
+void fusion_base::push_mag(sensor_data_t &data)
+{
+	if (m_resampler && m_streams[INPUT_MAG] >= 0)
+		push(INPUT_MAG, data);
+	else
+		apply_mag(data.timestamp, data.values);
+}
+
+void fusion_base::apply_accel(unsigned long long timestamp, const float *values)
 {
 	//_I("[fusion_sensor] : Pushing accel");
-	android::vec3_t v(data.values);
+	android::vec3_t v(values);
 
-	float dT = (data.timestamp - m_timestamp_accel) / US2S;
-	m_timestamp_accel = data.timestamp;
-	if (m_timestamp < data.timestamp)
-		m_timestamp = data.timestamp;
+	float dT = (timestamp - m_timestamp_accel) / US2S;
+	m_timestamp_accel = timestamp;
+	if (m_timestamp < timestamp)
+		m_timestamp = timestamp;
 
 	m_enable_accel = true;
 
@@ -75,18 +208,18 @@ void fusion_base::push_accel(sensor_data_t &data)
 	store_orientation();
 }
 
-void fusion_base::push_gyro(sensor_data_t &data)
+void fusion_base::apply_gyro(unsigned long long timestamp, const float *values)
 {
 	//_I("[fusion_sensor] : Pushing gyro");
-	android::vec3_t v(data.values);
+	android::vec3_t v(values);
 	v[0] /= RAD2DEG;
 	v[1] /= RAD2DEG;
 	v[2] /= RAD2DEG;
 
-	float dT = (data.timestamp - m_timestamp_gyro) / US2S;
-	m_timestamp_gyro = data.timestamp;
-	if (m_timestamp < data.timestamp)
-		m_timestamp = data.timestamp;
+	float dT = (timestamp - m_timestamp_gyro) / US2S;
+	m_timestamp_gyro = timestamp;
+	if (m_timestamp < timestamp)
+		m_timestamp = timestamp;
 
 	m_enable_gyro = true;
 
@@ -95,15 +228,15 @@ void fusion_base::push_gyro(sensor_data_t &data)
 	store_orientation();
 }
 
-void fusion_base::push_mag(sensor_data_t &data)
+void fusion_base::apply_mag(unsigned long long timestamp, const float *values)
 {
 	//_I("[fusion_sensor] : Pushing mag");
-	android::vec3_t v(data.values);
+	android::vec3_t v(values);
 
-	float dT = (data.timestamp - m_timestamp_mag) / US2S;
-	m_timestamp_mag = data.timestamp;
-	if (m_timestamp < data.timestamp)
-		m_timestamp = data.timestamp;
+	float dT = (timestamp - m_timestamp_mag) / US2S;
+	m_timestamp_mag = timestamp;
+	if (m_timestamp < timestamp)
+		m_timestamp = timestamp;
 
 	m_enable_magnetic = true;
 
@@ -21,6 +21,12 @@
 
 #include "fusion.h"
 #include "fusion_utils/orientation_filter.h"
+#include <input_resampler.h>
+#include <map>
+
+#define FUSION_INPUT_ACCEL 0x1
+#define FUSION_INPUT_GYRO  0x2
+#define FUSION_INPUT_MAG   0x4
 
 class fusion_base : public virtual fusion {
 public:
@@ -32,9 +38,33 @@ public:
 	virtual void push_mag(sensor_data_t &data);
 	virtual bool get_rv(unsigned long long &timestamp, float &w, float &x, float &y, float &z);
 
+	/* inputs are reordered within window [us] before they reach the
+	 * filter. with a period [us], the filter is run in fixed steps on the
+	 * inputs resampled to a common clock. a window of 0 and no period
+	 * feed the filter as the inputs arrive, which is the default. */
+	void set_resampling(unsigned long long window, unsigned long long period);
+
+	/* a listener batching for latency [ms] gets the inputs in FIFO bursts,
+	 * one sensor after the other, so they are reordered within the
+	 * shortest latency of the listeners. a negative latency removes ob. */
+	void set_batch_latency(void *ob, int latency);
+
+	/* fuses the inputs held back for reordering, once the bursts of all
+	 * the inputs were pushed */
+	void flush(void);
+
 protected:
 	android::orientation_filter m_orientation_filter;
 
+	/* FUSION_INPUT_* the filter is initialized for */
+	int m_inputs;
+
+	input_resampler *m_resampler;
+	int m_streams[3];
+
+	std::map<void *, int> m_latencies;
+	unsigned long long m_window;
+
 	bool m_enable_accel;
 	bool m_enable_gyro;
 	bool m_enable_magnetic;
@@ -51,6 +81,13 @@ protected:
 
 	void clear();
 	void store_orientation(void);
+
+	bool is_valid(const resampler_frame_s &frame, int input);
+	void push(int input, sensor_data_t &data);
+	void apply_released(void);
+	void apply_accel(unsigned long long timestamp, const float *values);
+	void apply_gyro(unsigned long long timestamp, const float *values);
+	void apply_mag(unsigned long long timestamp, const float *values);
 };
 
 
@@ -0,0 +1,239 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ANDROID_MAT_KERNELS_H
+#define ANDROID_MAT_KERNELS_H
+
+#include "vec.h"
+#include "mat.h"
+
+/*
+ * Unrolled kernels for the fixed-size products of orientation_filter.
+ *
+ * Matrices are column-major (m[column][row]), so every product below is
+ * a sum of columns scaled by scalars, which maps onto 4-lane NEON or SSE
+ * registers with the 4th lane unused for 3-vectors. Define
+ * MAT_KERNELS_SCALAR to build the plain C++ path instead.
+ */
+
+#if !defined(MAT_KERNELS_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define MAT_KERNELS_NEON
+#elif !defined(MAT_KERNELS_SCALAR) && defined(__SSE__)
+#include <xmmintrin.h>
+#define MAT_KERNELS_SSE
+#endif
+
+namespace android {
+namespace kernels {
+
+// -----------------------------------------------------------------------
+// 4-lane primitives
+
+#if defined(MAT_KERNELS_NEON)
+
+typedef float32x4_t lane_t;
+
+static inline lane_t load3(const vec3_t& v) {
+    return vcombine_f32(vld1_f32(&v[0]), vld1_lane_f32(&v[2], vdup_n_f32(0), 0));
+}
+static inline lane_t load4(const vec4_t& v) { return vld1q_f32(&v[0]); }
+static inline lane_t scale(lane_t a, float s) { return vmulq_n_f32(a, s); }
+static inline lane_t madd(lane_t acc, lane_t a, float s) { return vmlaq_n_f32(acc, a, s); }
+static inline void store3(vec3_t& v, lane_t a) {
+    vst1_f32(&v[0], vget_low_f32(a));
+    vst1q_lane_f32(&v[2], a, 2);
+}
+static inline void store4(vec4_t& v, lane_t a) { vst1q_f32(&v[0], a); }
+
+#elif defined(MAT_KERNELS_SSE)
+
+typedef __m128 lane_t;
+
+static inline lane_t load3(const vec3_t& v) { return _mm_setr_ps(v[0], v[1], v[2], 0); }
+static inline lane_t load4(const vec4_t& v) { return _mm_loadu_ps(&v[0]); }
+static inline lane_t scale(lane_t a, float s) { return _mm_mul_ps(a, _mm_set1_ps(s)); }
+static inline lane_t madd(lane_t acc, lane_t a, float s) {
+    return _mm_add_ps(acc, _mm_mul_ps(a, _mm_set1_ps(s)));
+}
+static inline void store3(vec3_t& v, lane_t a) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(&v[0]), a);
+    _mm_store_ss(&v[2], _mm_movehl_ps(a, a));
+}
+static inline void store4(vec4_t& v, lane_t a) { _mm_storeu_ps(&v[0], a); }
+
+#else
+
+struct lane_t { float v[4]; };
+
+static inline lane_t load3(const vec3_t& v) {
+    lane_t r = {{ v[0], v[1], v[2], 0 }};
+    return r;
+}
+static inline lane_t load4(const vec4_t& v) {
+    lane_t r = {{ v[0], v[1], v[2], v[3] }};
+    return r;
+}
+static inline lane_t scale(lane_t a, float s) {
+    lane_t r = {{ a.v[0]*s, a.v[1]*s, a.v[2]*s, a.v[3]*s }};
+    return r;
+}
+static inline lane_t madd(lane_t acc, lane_t a, float s) {
+    lane_t r = {{ acc.v[0] + a.v[0]*s, acc.v[1] + a.v[1]*s,
+                  acc.v[2] + a.v[2]*s, acc.v[3] + a.v[3]*s }};
+    return r;
+}
+static inline void store3(vec3_t& v, lane_t a) {
+    v[0] = a.v[0]; v[1] = a.v[1]; v[2] = a.v[2];
+}
+static inline void store4(vec4_t& v, lane_t a) {
+    v[0] = a.v[0]; v[1] = a.v[1]; v[2] = a.v[2]; v[3] = a.v[3];
+}
+
+#endif
+
+// -----------------------------------------------------------------------
+// products
+
+// a*v
+static inline vec3_t mul(const mat33_t& a, const vec3_t& v) {
+    vec3_t r;
+    lane_t acc = scale(load3(a[0]), v[0]);
+    acc = madd(acc, load3(a[1]), v[1]);
+    acc = madd(acc, load3(a[2]), v[2]);
+    store3(r, acc);
+    return r;
+}
+
+// a*v, e.g. the quaternion rotation O*q
+static inline vec4_t mul(const mat44_t& a, const vec4_t& v) {
+    vec4_t r;
+    lane_t acc = scale(load4(a[0]), v[0]);
+    acc = madd(acc, load4(a[1]), v[1]);
+    acc = madd(acc, load4(a[2]), v[2]);
+    acc = madd(acc, load4(a[3]), v[3]);
+    store4(r, acc);
+    return r;
+}
+
+// a*v, e.g. the quaternion derivative F(q)*dq
+static inline vec4_t mul(const mat<float, 3, 4>& a, const vec3_t& v) {
+    vec4_t r;
+    lane_t acc = scale(load4(a[0]), v[0]);
+    acc = madd(acc, load4(a[1]), v[1]);
+    acc = madd(acc, load4(a[2]), v[2]);
+    store4(r, acc);
+    return r;
+}
+
+// a*b
+static inline mat33_t mul(const mat33_t& a, const mat33_t& b) {
+    const lane_t a0(load3(a[0]));
+    const lane_t a1(load3(a[1]));
+    const lane_t a2(load3(a[2]));
+    mat33_t r;
+    for (size_t c=0 ; c<3 ; c++) {
+        lane_t acc = scale(a0, b[c][0]);
+        acc = madd(acc, a1, b[c][1]);
+        acc = madd(acc, a2, b[c][2]);
+        store3(r[c], acc);
+    }
+    return r;
+}
+
+// a*transpose(b)
+static inline mat33_t mul_t(const mat33_t& a, const mat33_t& b) {
+    const lane_t a0(load3(a[0]));
+    const lane_t a1(load3(a[1]));
+    const lane_t a2(load3(a[2]));
+    mat33_t r;
+    for (size_t c=0 ; c<3 ; c++) {
+        lane_t acc = scale(a0, b[0][c]);
+        acc = madd(acc, a1, b[1][c]);
+        acc = madd(acc, a2, b[2][c]);
+        store3(r[c], acc);
+    }
+    return r;
+}
+
+// transpose(a)*b, every element is the dot product of two columns
+static inline mat33_t t_mul(const mat33_t& a, const mat33_t& b) {
+    mat33_t r;
+    for (size_t c=0 ; c<3 ; c++)
+        for (size_t k=0 ; k<3 ; k++)
+            r[c][k] = a[k][0]*b[c][0] + a[k][1]*b[c][1] + a[k][2]*b[c][2];
+    return r;
+}
+
+// -----------------------------------------------------------------------
+// covariance of orientation_filter, a 2x2 block matrix of 3x3 blocks
+
+// P = Phi*P*transpose(Phi) + GQGt, expanded by blocks with Phi01 = 0
+// and Phi11 = I33:
+//
+//  P00 = (Phi00*P00 + Phi10*P01)*Phi00t + (Phi00*P10 + Phi10*P11)*Phi10t
+//  P01 =  P01*Phi00t + P11*Phi10t
+//  P10 =  Phi00*P10 + Phi10*P11
+//  P11 =  P11
+//
+// The products by the 0 and I33 blocks are exact, so leaving them out
+// does not change the result. Every other block is summed in the order of
+// the dense product, which keeps the result the same to the bit.
+static inline void predict_covariance(mat<mat33_t, 2, 2>& P,
+        const mat33_t& Phi00, const mat33_t& Phi10,
+        const mat<mat33_t, 2, 2>& GQGt) {
+    const mat33_t PhiP00(mul(Phi00, P[0][0]) + mul(Phi10, P[0][1]));
+    const mat33_t PhiP10(mul(Phi00, P[1][0]) + mul(Phi10, P[1][1]));
+
+    P[0][0] = mul_t(PhiP00, Phi00) + mul_t(PhiP10, Phi10) + GQGt[0][0];
+    P[0][1] = mul_t(P[0][1], Phi00) + mul_t(P[1][1], Phi10) + GQGt[0][1];
+    P[1][0] = PhiP10 + GQGt[1][0];
+    P[1][1] += GQGt[1][1];
+}
+
+// K = P*Ht*inverse(S) for H = | L 0 | and S = H*P*Ht + R, then
+// P = (I-K*H)*P:
+//
+// | K0 | * | L 0 | * P = | K0*L  0 | * | P00  P10 | = | K0*L*P00  K0*L*P10 |
+// | K1 |                 | K1*L  0 |   | P01  P11 |   | K1*L*P00  K1*L*P10 |
+//
+// Returns K.
+static inline vec<mat33_t, 2> update_covariance(mat<mat33_t, 2, 2>& P,
+        const mat33_t& L, const mat33_t& S) {
+    vec<mat33_t, 2> K;
+    const mat33_t Si(invert(S));
+    const mat33_t LtSi(t_mul(L, Si));
+    K[0] = mul(P[0][0], LtSi);
+    K[1] = t_mul(P[1][0], LtSi);
+
+    const mat33_t K0L(mul(K[0], L));
+    const mat33_t K1L(mul(K[1], L));
+    P[0][0] -= mul(K0L, P[0][0]);
+    P[1][1] -= mul(K1L, P[1][0]);
+    P[1][0] -= mul(K0L, P[1][0]);
+    P[0][1] = transpose(P[1][0]);
+
+    return K;
+}
+
+// -----------------------------------------------------------------------
+}; // namespace kernels
+}; // namespace android
+
+#endif /* ANDROID_MAT_KERNELS_H */
@@ -17,6 +17,7 @@
 // released in android-11.0.0_r9
 
 #include "orientation_filter.h"
+#include "mat_kernels.h"
 
 using namespace android;
 
@@ -479,12 +480,13 @@ void orientation_filter::predict(const vec3_t& w, float dT) {
     Phi[0][0] = I33 - wx*(k1*ilwe) + wx2*k0;
     Phi[1][0] = wx*k0 - I33dT - wx2*(ilwe*ilwe*ilwe)*(lwedT-k1);
 
-    x0 = O*q;
+    x0 = kernels::mul(O, q);
 
     if (x0.w < 0)
         x0 = -x0;
 
-    P = Phi*P*transpose(Phi) + GQGt;
+    // P = Phi*P*transpose(Phi) + GQGt, by blocks
+    kernels::predict_covariance(P, Phi[0][0], Phi[1][0], GQGt);
 
     checkState();
 }
@@ -501,36 +503,23 @@ void orientation_filter::update(const vec3_t& z, const vec3_t& Bi, float sigma)
 
     // gain...
     // K = P*Ht / [H*P*Ht + R]
-    vec<mat33_t, 2> K;
     const mat33_t R(sigma*sigma);
     const mat33_t S(scaleCovariance(L, P[0][0]) + R);
-    const mat33_t Si(invert(S));
-    const mat33_t LtSi(transpose(L)*Si);
-    K[0] = P[0][0] * LtSi;
-    K[1] = transpose(P[1][0])*LtSi;
 
     // update...
     // P = (I-K*H) * P
-    // P -= K*H*P
-    // | K0 | * | L 0 | * P = | K0*L  0 | * | P00  P10 | = | K0*L*P00  K0*L*P10 |
-    // | K1 |                 | K1*L  0 |   | P01  P11 |   | K1*L*P00  K1*L*P10 |
     // Note: the Joseph form is numerically more stable and given by:
     //     P = (I-KH) * P * (I-KH)' + K*R*R'
-    const mat33_t K0L(K[0] * L);
-    const mat33_t K1L(K[1] * L);
-    P[0][0] -= K0L*P[0][0];
-    P[1][1] -= K1L*P[1][0];
-    P[1][0] -= K0L*P[1][0];
-    P[0][1] = transpose(P[1][0]);
+    const vec<mat33_t, 2> K(kernels::update_covariance(P, L, S));
 
     const vec3_t e(z - Bb);
-    const vec3_t dq(K[0]*e);
+    const vec3_t dq(kernels::mul(K[0], e));
 
-    q += getF(q)*(0.5f*dq);
+    q += kernels::mul(getF(q), 0.5f*dq);
     x0 = normalize_quat(q);
 
     if (mMode != FUSION_NOMAG) {
-        const vec3_t db(K[1]*e);
+        const vec3_t db(kernels::mul(K[1], e));
         x1 += db;
     }
 
@@ -22,6 +22,7 @@
 gyro_fusion::gyro_fusion()
 {
 	m_orientation_filter.init(1);
+	m_inputs = FUSION_INPUT_ACCEL | FUSION_INPUT_GYRO;
 }
 
 gyro_fusion::~gyro_fusion()
@@ -22,6 +22,7 @@
 magnetic_fusion::magnetic_fusion()
 {
 	m_orientation_filter.init(2);
+	m_inputs = FUSION_INPUT_ACCEL | FUSION_INPUT_MAG;
 }
 
 magnetic_fusion::~magnetic_fusion()
@@ -33,8 +33,12 @@ public:
 	int get_required_sensors(const required_sensor_s **sensors);
 
 	int update(uint32_t id, sensor_data_t *data, int len);
+	int update_done(void);
 	int get_data(sensor_data_t **data, int *len);
 
+	int stop(observer_h ob);
+	int set_batch_latency(observer_h ob, int32_t &latency);
+
 private:
 	magnetic_fusion m_fusion;
 
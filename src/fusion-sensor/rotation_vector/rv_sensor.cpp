@@ -108,6 +108,24 @@ int rv_sensor::update(uint32_t id, sensor_data_t *data, int len)
 	return OP_SUCCESS;
 }
 
+int rv_sensor::update_done(void)
+{
+	unsigned long long timestamp;
+
+	/* the inputs held back for reordering are fused at the end of the bursts */
+	m_fusion.flush();
+
+	if (!m_fusion.get_rv(timestamp, m_w, m_x, m_y, m_z))
+		return OP_ERROR;
+
+	if (timestamp == m_time)
+		return OP_ERROR;
+
+	m_time = timestamp;
+
+	return OP_SUCCESS;
+}
+
 int rv_sensor::get_data(sensor_data_t **data, int *length)
 {
 	sensor_data_t *sensor_data;
@@ -127,3 +145,15 @@ int rv_sensor::get_data(sensor_data_t **data, int *length)
 
 	return 0;
 }
+
+int rv_sensor::stop(observer_h ob)
+{
+	m_fusion.set_batch_latency(ob, -1);
+	return OP_DEFAULT;
+}
+
+int rv_sensor::set_batch_latency(observer_h ob, int32_t &latency)
+{
+	m_fusion.set_batch_latency(ob, latency);
+	return OP_DEFAULT;
+}
@@ -0,0 +1,1193 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/timerfd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <ipc_server.h>
+#include <ipc_client.h>
+#include <channel.h>
+#include <channel_handler.h>
+#include <event_loop.h>
+#include <message.h>
+#include <sensor_utils.h>
+#include <sensor_internal.h>
+#include <command_types.h>
+#include <latency_histogram.h>
+
+#include "log.h"
+
+#define BENCH_PATH "/run/.sensord_bench.socket"
+
+#define BENCH_CMD_ECHO 1
+#define BENCH_CMD_FANOUT 2
+#define BENCH_EVENT 3
+#define BENCH_CMD_WORK 4
+#define BENCH_CMD_SUBSCRIBE 5
+
+#define BENCH_RTT_COUNT 1000		/* round trips per client */
+#define BENCH_FANOUT_COUNT 100		/* events per listener */
+#define BENCH_FANOUT_INTERVAL 1000	/* us between two events */
+#define BENCH_FLOOD_COUNT 1000		/* events to the listener */
+#define BENCH_FLOOD_CLIENTS 32
+#define BENCH_FLOOD_WORK 100		/* us the server spends on a command */
+#define BENCH_INGEST_BUDGET 32		/* the budgets of sensord */
+#define BENCH_DELIVERY_BUDGET 64
+#define BENCH_CONTROL_BUDGET 8
+#define BENCH_HOUSEKEEPING_BUDGET 4
+#define BENCH_SCALE_LISTENERS 10000
+#define BENCH_SCALE_INTERVAL 100	/* ms between two events of the sensor */
+#define BENCH_SCALE_DURATION 5000	/* ms */
+#define BENCH_WARMUP 10
+#define BENCH_RETRY 100
+#define BENCH_RETRY_INTERVAL 20000	/* us */
+#define BENCH_FD_RESERVED 64
+
+using namespace ipc;
+
+static const int bench_clients[] = {1, 2, 4, 8};
+static const int bench_sizes[] = {64, 256, 1024, 4096, 16384, MAX_MSG_CAPACITY - 1};
+static const int bench_listeners[] = {1, 10, 100, 1000};
+
+typedef struct {
+	int listeners;
+	int count;
+	int interval;
+	int size;
+} bench_fanout_t;
+
+typedef struct {
+	const char *suite;
+	const char *mode;
+	int clients;
+	int size;
+	uint64_t messages;
+	uint64_t elapsed;	/* us */
+	uint64_t cpu;		/* us, client and server together */
+} bench_result_t;
+
+static uint64_t to_us(const struct timeval &tv)
+{
+	return (uint64_t)tv.tv_sec * 1000000ULL + tv.tv_usec;
+}
+
+static uint64_t get_cpu_time(void)
+{
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) < 0)
+		return 0;
+
+	return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+}
+
+static int raise_fd_limit(void)
+{
+	struct rlimit limit;
+
+	if (getrlimit(RLIMIT_NOFILE, &limit) < 0)
+		return 0;
+
+	if (limit.rlim_cur < limit.rlim_max) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	return limit.rlim_cur;
+}
+
+/* The loop deletes the handlers of its channels when it stops, so the
+ * channels bound to it are disconnected on the loop right before */
+struct bench_receivers {
+	event_loop *loop;
+	std::vector<channel *> channels;
+	bool finishing;
+	void (*finish_cb)(void *);	/* called before the channels are disconnected */
+	void *finish_data;
+};
+
+static void disconnect_receivers(bench_receivers *receivers)
+{
+	for (auto ch : receivers->channels) {
+		ch->disconnect();
+		delete ch;
+	}
+
+	receivers->channels.clear();
+}
+
+static void finish_receivers(size_t id, void *data)
+{
+	bench_receivers *receivers = static_cast<bench_receivers *>(data);
+
+	if (receivers->finish_cb)
+		receivers->finish_cb(receivers->finish_data);
+
+	disconnect_receivers(receivers);
+	receivers->loop->stop();
+}
+
+/* the loop must not be torn down from inside one of its handlers */
+static void schedule_finish(bench_receivers *receivers)
+{
+	if (receivers->finishing)
+		return;
+
+	receivers->finishing = true;
+	receivers->loop->add_idle_event(EVENT_PRIORITY_HOUSEKEEPING, finish_receivers, receivers);
+}
+
+class bench_timeout_handler : public event_handler
+{
+public:
+	bench_timeout_handler(bench_receivers *receivers)
+	: m_receivers(receivers)
+	{}
+
+	bool handle(int fd, event_condition condition)
+	{
+		schedule_finish(m_receivers);
+		return false;
+	}
+
+private:
+	bench_receivers *m_receivers;
+};
+
+/* Runs the loop of the receivers until they finish, or for timeout ms at most */
+static void run_receivers(bench_receivers *receivers, uint64_t timeout)
+{
+	struct itimerspec spec;
+
+	int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	RETM_IF(fd < 0, "Failed to create timer\n");
+
+	memset(&spec, 0, sizeof(spec));
+	spec.it_value.tv_sec = timeout / 1000;
+	spec.it_value.tv_nsec = (timeout % 1000) * 1000000;
+	timerfd_settime(fd, 0, &spec, NULL);
+
+	bench_timeout_handler *handler = new(std::nothrow) bench_timeout_handler(receivers);
+	if (handler && receivers->loop->add_event(fd, EVENT_IN, handler, EVENT_PRIORITY_HOUSEKEEPING) != 0)
+		receivers->loop->run();
+	else
+		delete handler;
+
+	close(fd);
+}
+
+/* The server echoes requests back and broadcasts events to its listeners,
+ * replying either in place (sync) or through the event loop (async) */
+class bench_server_handler : public channel_handler
+{
+public:
+	bench_server_handler(event_loop *loop, bool async)
+	: m_loop(loop)
+	, m_async(async)
+	{
+		memset(&m_fanout, 0, sizeof(m_fanout));
+	}
+
+	void connected(channel *ch)
+	{
+		m_receivers.push_back(ch);
+	}
+
+	void disconnected(channel *ch)
+	{
+		m_receivers.erase(std::remove(m_receivers.begin(), m_receivers.end(), ch),
+				m_receivers.end());
+	}
+
+	void read(channel *ch, message &msg)
+	{
+		if (msg.type() == BENCH_CMD_FANOUT) {
+			start_fanout(ch, msg);
+			return;
+		}
+
+		if (!m_async) {
+			ch->send_sync(msg);
+			return;
+		}
+
+		auto reply = message::create(msg);
+		RETM_IF(!reply, "Failed to allocate memory\n");
+
+		ch->send(reply);
+	}
+
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+
+private:
+	void start_fanout(channel *ch, message &msg)
+	{
+		message reply;
+
+		/* the requester is not a listener */
+		disconnected(ch);
+
+		if (msg.size() != sizeof(bench_fanout_t)) {
+			reply.enclose(-EINVAL);
+			ch->send_sync(reply);
+			return;
+		}
+
+		msg.disclose(&m_fanout, sizeof(m_fanout));
+
+		if ((int)m_receivers.size() < m_fanout.listeners) {
+			reply.enclose(-EAGAIN);
+			ch->send_sync(reply);
+			return;
+		}
+
+		reply.enclose(0);
+		ch->send_sync(reply);
+
+		/* events are paced by a timer thread but sent from the loop, like sensord does */
+		std::thread([this] {
+			for (int i = 0; i < m_fanout.count; ++i) {
+				m_loop->add_idle_event(EVENT_PRIORITY_INGEST, publish, this);
+				usleep(m_fanout.interval);
+			}
+		}).detach();
+	}
+
+	static void publish(size_t id, void *data)
+	{
+		bench_server_handler *handler = static_cast<bench_server_handler *>(data);
+		uint64_t now = sensor::utils::get_timestamp();
+
+		auto msg = message::create((size_t)handler->m_fanout.size);
+		RETM_IF(!msg, "Failed to allocate memory\n");
+
+		char *body = msg->reserve(handler->m_fanout.size);
+		RETM_IF(!body, "Failed to allocate memory\n");
+
+		memset(body, 0, handler->m_fanout.size);
+		memcpy(body, &now, sizeof(now));
+		msg->set_type(BENCH_EVENT);
+
+		for (auto it = handler->m_receivers.begin(); it != handler->m_receivers.end(); ++it) {
+			if (handler->m_async)
+				(*it)->send(msg);
+			else
+				(*it)->send_sync(*msg);
+		}
+	}
+
+	event_loop *m_loop;
+	bool m_async;
+	bench_fanout_t m_fanout;
+	std::vector<channel *> m_receivers;
+};
+
+class bench_client_handler : public channel_handler
+{
+public:
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+	void read(channel *ch, message &msg) {}
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+};
+
+class bench_receiver_handler : public channel_handler
+{
+public:
+	bench_receiver_handler(bench_receivers *receivers, sensor::latency_histogram *histogram,
+			uint64_t expected)
+	: m_receivers(receivers)
+	, m_histogram(histogram)
+	, m_expected(expected)
+	, m_received(0)
+	{}
+
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+
+	void read(channel *ch, message &msg)
+	{
+		uint64_t stamp;
+
+		RET_IF(msg.type() != BENCH_EVENT || msg.size() < sizeof(stamp));
+
+		memcpy(&stamp, msg.body(), sizeof(stamp));
+		m_histogram->record(sensor::utils::get_timestamp() - stamp);
+
+		if (++m_received == m_expected)
+			schedule_finish(m_receivers);
+	}
+
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+
+	uint64_t received(void) { return m_received; }
+
+private:
+	bench_receivers *m_receivers;
+	sensor::latency_histogram *m_histogram;
+	uint64_t m_expected;
+	uint64_t m_received;
+};
+
+static pid_t start_server(bool async)
+{
+	pid_t pid = fork();
+	if (pid != 0)
+		return pid;
+
+	event_loop loop;
+	ipc_server server(BENCH_PATH);
+	bench_server_handler handler(&loop, async);
+
+	server.bind(&handler, &loop);
+	loop.run();
+	server.close();
+
+	exit(EXIT_SUCCESS);
+}
+
+/* Returns the cpu time the server has used */
+static uint64_t stop_server(pid_t pid)
+{
+	struct rusage usage;
+	int status;
+
+	kill(pid, SIGKILL);
+	if (wait4(pid, &status, 0, &usage) < 0)
+		return 0;
+
+	return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+}
+
+/* the server may not be listening yet */
+static channel *connect_server(ipc_client &client, channel_handler *handler, event_loop *loop)
+{
+	for (int retry = 0; retry < BENCH_RETRY; ++retry) {
+		channel *ch = client.connect(handler, loop);
+		if (ch && ch->is_connected())
+			return ch;
+
+		/* the server may not be listening yet right after the fork */
+		delete ch;
+
+		usleep(BENCH_RETRY_INTERVAL);
+	}
+
+	return NULL;
+}
+
+static void print_header(void)
+{
+	_N("suite,mode,clients,size,messages,seconds,msgs_per_sec,mbytes_per_sec,"
+			"cpu_us_per_msg,p50_us,p99_us,p999_us,max_us\n");
+}
+
+static void print_result(bench_result_t &result, sensor::latency_histogram &histogram)
+{
+	double seconds = result.elapsed / 1000000.0;
+	double rate = (seconds > 0) ? result.messages / seconds : 0;
+	double cpu = (result.messages > 0) ? (double)result.cpu / result.messages : 0;
+
+	_N("%s,%s,%d,%d,%llu,%.3f,%.1f,%.3f,%.2f,%llu,%llu,%llu,%llu\n",
+			result.suite, result.mode,
+			result.clients, result.size,
+			(unsigned long long)result.messages, seconds, rate,
+			rate * result.size / (1024 * 1024), cpu,
+			(unsigned long long)histogram.percentile(50),
+			(unsigned long long)histogram.percentile(99),
+			(unsigned long long)histogram.percentile(99.9),
+			(unsigned long long)histogram.max());
+}
+
+static void run_rtt_client(int size, int count, sensor::latency_histogram *histogram,
+		std::atomic<int> *ready, std::atomic<bool> *go, std::atomic<bool> *failed)
+{
+	ipc_client client(BENCH_PATH);
+	bench_client_handler handler;
+	std::vector<char> buf(size, 'b');
+	message msg;
+	message reply;
+
+	channel *ch = connect_server(client, &handler, NULL);
+	if (!ch) {
+		failed->store(true);
+		ready->fetch_add(1);
+		return;
+	}
+
+	msg.enclose(buf.data(), size);
+	msg.set_type(BENCH_CMD_ECHO);
+
+	for (int i = 0; i < BENCH_WARMUP; ++i) {
+		if (!ch->send_sync(msg) || !ch->read_sync(reply))
+			failed->store(true);
+	}
+
+	ready->fetch_add(1);
+	while (!go->load())
+		usleep(100);
+
+	for (int i = 0; i < count && !failed->load(); ++i) {
+		uint64_t start = sensor::utils::get_timestamp();
+
+		if (!ch->send_sync(msg) || !ch->read_sync(reply)) {
+			failed->store(true);
+			break;
+		}
+
+		histogram->record(sensor::utils::get_timestamp() - start);
+	}
+
+	ch->disconnect();
+	delete ch;
+}
+
+/* Round trips of 1..N clients, each waiting for the echo before the next request */
+bool bench_manager::run_rtt(int count)
+{
+	for (bool async : {false, true}) {
+		for (int clients : bench_clients) {
+			for (int size : bench_sizes) {
+				RETV_IF(!m_running.load(), false);
+
+				sensor::latency_histogram histogram;
+				std::vector<std::thread> threads;
+				std::atomic<int> ready(0);
+				std::atomic<bool> go(false);
+				std::atomic<bool> failed(false);
+				bench_result_t result = {"rtt", async ? "async" : "sync", clients, size, 0, 0, 0};
+
+				pid_t pid = start_server(async);
+				RETVM_IF(pid < 0, false, "Failed to start server\n");
+
+				for (int i = 0; i < clients; ++i)
+					threads.push_back(std::thread(run_rtt_client, size, count,
+							&histogram, &ready, &go, &failed));
+
+				while (ready.load() < clients)
+					usleep(1000);
+
+				uint64_t start = sensor::utils::get_timestamp();
+				uint64_t cpu = get_cpu_time();
+				go.store(true);
+
+				for (auto &thread : threads)
+					thread.join();
+
+				result.elapsed = sensor::utils::get_timestamp() - start;
+				result.cpu = get_cpu_time() - cpu + stop_server(pid);
+				result.messages = histogram.count();
+
+				WARN_IF(failed.load(), "rtt: %d clients, %d bytes failed\n", clients, size);
+				print_result(result, histogram);
+			}
+		}
+	}
+
+	return true;
+}
+
+struct fanout_context {
+	ipc_client *client;
+	channel_handler *handler;
+	channel *ch;
+	bench_fanout_t request;
+	bench_receivers *receivers;
+	bool started;
+};
+
+/* runs on the receivers' loop, once all of them are connected */
+static void request_fanout(size_t id, void *data)
+{
+	fanout_context *context = static_cast<fanout_context *>(data);
+	message msg;
+	message reply;
+
+	context->ch = connect_server(*context->client, context->handler, NULL);
+	if (!context->ch) {
+		schedule_finish(context->receivers);
+		return;
+	}
+
+	msg.enclose(&context->request, sizeof(context->request));
+	msg.set_type(BENCH_CMD_FANOUT);
+
+	for (int retry = 0; retry < BENCH_RETRY; ++retry) {
+		if (!context->ch->send_sync(msg) || !context->ch->read_sync(reply))
+			break;
+
+		if (reply.header()->err == 0) {
+			context->started = true;
+			return;
+		}
+
+		if (reply.header()->err != -EAGAIN)
+			break;
+
+		/* the server has not accepted every listener yet */
+		usleep(BENCH_RETRY_INTERVAL);
+	}
+
+	schedule_finish(context->receivers);
+}
+
+/* One server broadcasting each event to 1..1000 listeners */
+bool bench_manager::run_fanout(int count)
+{
+	int fd_limit = raise_fd_limit();
+
+	for (bool async : {false, true}) {
+		for (int listeners : bench_listeners) {
+			RETV_IF(!m_running.load(), false);
+
+			if (fd_limit < listeners + BENCH_FD_RESERVED) {
+				_W("fanout: %d listeners exceed the limit of open files[%d]\n", listeners, fd_limit);
+				continue;
+			}
+
+			int size = sizeof(sensor_data_t);
+			uint64_t expected = (uint64_t)listeners * count;
+			sensor::latency_histogram histogram;
+			bench_result_t result = {"fanout", async ? "async" : "sync", listeners, size, 0, 0, 0};
+
+			event_loop loop;
+			ipc_client client(BENCH_PATH);
+			bench_receivers receivers = {&loop, std::vector<channel *>(), false, NULL, NULL};
+			bench_receiver_handler handler(&receivers, &histogram, expected);
+			bench_client_handler requester;
+			fanout_context context = {&client, &requester, NULL,
+					{listeners, count, BENCH_FANOUT_INTERVAL, size}, &receivers, false};
+
+			pid_t pid = start_server(async);
+			RETVM_IF(pid < 0, false, "Failed to start server\n");
+
+			for (int i = 0; i < listeners; ++i) {
+				channel *ch = connect_server(client, &handler, &loop);
+				if (!ch)
+					break;
+				receivers.channels.push_back(ch);
+			}
+
+			uint64_t start = sensor::utils::get_timestamp();
+			uint64_t cpu = get_cpu_time();
+
+			if ((int)receivers.channels.size() == listeners) {
+				loop.add_idle_event(EVENT_PRIORITY_CONTROL, request_fanout, &context);
+				run_receivers(&receivers, (uint64_t)count * BENCH_FANOUT_INTERVAL / 1000 + 10000);
+			}
+
+			result.elapsed = sensor::utils::get_timestamp() - start;
+			result.cpu = get_cpu_time() - cpu + stop_server(pid);
+			result.messages = handler.received();
+
+			disconnect_receivers(&receivers);
+
+			if (context.ch) {
+				context.ch->disconnect();
+				delete context.ch;
+			}
+
+			WARN_IF(!context.started, "fanout: %d listeners failed to start\n", listeners);
+			WARN_IF(result.messages < expected, "fanout: %llu of %llu events received\n",
+					(unsigned long long)result.messages, (unsigned long long)expected);
+			print_result(result, histogram);
+		}
+	}
+
+	return true;
+}
+
+/* Stands in for a HAL fd: a thread writes the timestamp of each sample to a
+ * pipe, which the loop reads and broadcasts to the subscribers */
+class bench_ingest_handler : public event_handler
+{
+public:
+	bench_ingest_handler(std::vector<channel *> *subscribers)
+	: m_subscribers(subscribers)
+	{}
+
+	bool handle(int fd, event_condition condition)
+	{
+		uint64_t stamp;
+
+		if (condition & (EVENT_HUP | EVENT_NVAL))
+			return false;
+
+		while (::read(fd, &stamp, sizeof(stamp)) == sizeof(stamp)) {
+			auto msg = message::create(sizeof(sensor_data_t));
+			RETVM_IF(!msg, true, "Failed to allocate memory\n");
+
+			char *body = msg->reserve(sizeof(sensor_data_t));
+			RETVM_IF(!body, true, "Failed to allocate memory\n");
+
+			memset(body, 0, sizeof(sensor_data_t));
+			memcpy(body, &stamp, sizeof(stamp));
+			msg->set_type(BENCH_EVENT);
+
+			for (auto it = m_subscribers->begin(); it != m_subscribers->end(); ++it)
+				(*it)->send(msg);
+		}
+
+		return true;
+	}
+
+private:
+	std::vector<channel *> *m_subscribers;
+};
+
+/* Spends BENCH_FLOOD_WORK on every command, like a heavy sensord command */
+class bench_flood_handler : public channel_handler
+{
+public:
+	bench_flood_handler(int count)
+	: m_count(count)
+	, m_pipe(-1)
+	{}
+
+	void set_pipe(int fd) { m_pipe = fd; }
+
+	void connected(channel *ch) {}
+
+	void disconnected(channel *ch)
+	{
+		m_subscribers.erase(std::remove(m_subscribers.begin(), m_subscribers.end(), ch),
+				m_subscribers.end());
+	}
+
+	void read(channel *ch, message &msg)
+	{
+		if (msg.type() == BENCH_CMD_SUBSCRIBE) {
+			m_subscribers.push_back(ch);
+			start_ingest();
+			return;
+		}
+
+		uint64_t end = sensor::utils::get_timestamp() + BENCH_FLOOD_WORK;
+		while (sensor::utils::get_timestamp() < end);
+
+		ch->send_sync(msg);
+	}
+
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+
+	std::vector<channel *> *subscribers(void) { return &m_subscribers; }
+
+private:
+	void start_ingest(void)
+	{
+		int fd = m_pipe;
+		int count = m_count;
+
+		std::thread([fd, count] {
+			for (int i = 0; i < count; ++i) {
+				uint64_t stamp = sensor::utils::get_timestamp();
+
+				if (::write(fd, &stamp, sizeof(stamp)) != sizeof(stamp))
+					break;
+				usleep(BENCH_FANOUT_INTERVAL);
+			}
+		}).detach();
+	}
+
+	int m_count;
+	int m_pipe;
+	std::vector<channel *> m_subscribers;
+};
+
+/* classes: the ingest pipe and the commands run in their own classes with
+ * the budgets of sensord. flat: everything is a control event, unlimited */
+static pid_t start_flood_server(bool classes, int count)
+{
+	int fds[2];
+
+	RETVM_IF(pipe(fds) < 0, -1, "Failed to create pipe\n");
+
+	pid_t pid = fork();
+	if (pid != 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return pid;
+	}
+
+	event_loop loop;
+	ipc_server server(BENCH_PATH);
+	bench_flood_handler handler(count);
+
+	if (classes) {
+		loop.set_budget(EVENT_PRIORITY_INGEST, BENCH_INGEST_BUDGET);
+		loop.set_budget(EVENT_PRIORITY_DELIVERY, BENCH_DELIVERY_BUDGET);
+		loop.set_budget(EVENT_PRIORITY_CONTROL, BENCH_CONTROL_BUDGET);
+		loop.set_budget(EVENT_PRIORITY_HOUSEKEEPING, BENCH_HOUSEKEEPING_BUDGET);
+	}
+
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	handler.set_pipe(fds[1]);
+
+	/* the loop takes the handler over */
+	bench_ingest_handler *ingest = new(std::nothrow) bench_ingest_handler(handler.subscribers());
+	if (!ingest || loop.add_event(fds[0], EVENT_IN | EVENT_HUP | EVENT_NVAL, ingest,
+			classes ? EVENT_PRIORITY_INGEST : EVENT_PRIORITY_CONTROL) == 0)
+		exit(EXIT_FAILURE);
+	server.bind(&handler, &loop);
+	loop.run();
+	server.close();
+
+	exit(EXIT_SUCCESS);
+}
+
+static void run_flood_client(std::atomic<int> *ready, std::atomic<bool> *running,
+		std::atomic<bool> *failed)
+{
+	ipc_client client(BENCH_PATH);
+	bench_client_handler handler;
+	message msg;
+	message reply;
+	bool counted = false;
+
+	channel *ch = connect_server(client, &handler, NULL);
+	if (!ch) {
+		failed->store(true);
+		ready->fetch_add(1);
+		return;
+	}
+
+	msg.set_type(BENCH_CMD_WORK);
+
+	while (running->load()) {
+		if (!ch->send_sync(msg) || !ch->read_sync(reply)) {
+			failed->store(true);
+			break;
+		}
+
+		if (!counted) {
+			ready->fetch_add(1);
+			counted = true;
+		}
+	}
+
+	if (!counted)
+		ready->fetch_add(1);
+
+	ch->disconnect();
+	delete ch;
+}
+
+/* Event latency of one listener while clients keep the server busy with commands */
+bool bench_manager::run_flood(int count)
+{
+	int clients = BENCH_FLOOD_CLIENTS;
+
+	for (bool classes : {false, true}) {
+		RETV_IF(!m_running.load(), false);
+
+		sensor::latency_histogram histogram;
+		std::vector<std::thread> threads;
+		std::atomic<int> ready(0);
+		std::atomic<bool> running(true);
+		std::atomic<bool> failed(false);
+		bench_result_t result = {"flood", classes ? "classes" : "flat",
+				clients, (int)sizeof(sensor_data_t), 0, 0, 0};
+
+		event_loop loop;
+		ipc_client client(BENCH_PATH);
+		bench_receivers receivers = {&loop, std::vector<channel *>(), false, NULL, NULL};
+		bench_receiver_handler handler(&receivers, &histogram, count);
+		message msg;
+
+		pid_t pid = start_flood_server(classes, count);
+		RETVM_IF(pid < 0, false, "Failed to start server\n");
+
+		for (int i = 0; i < clients; ++i)
+			threads.push_back(std::thread(run_flood_client, &ready, &running, &failed));
+
+		while (ready.load() < clients)
+			usleep(1000);
+
+		uint64_t start = sensor::utils::get_timestamp();
+		uint64_t cpu = get_cpu_time();
+
+		channel *ch = connect_server(client, &handler, &loop);
+		if (ch) {
+			receivers.channels.push_back(ch);
+
+			msg.set_type(BENCH_CMD_SUBSCRIBE);
+			if (ch->send_sync(msg))
+				run_receivers(&receivers, (uint64_t)count * BENCH_FANOUT_INTERVAL / 1000 + 10000);
+		}
+
+		running.store(false);
+		for (auto &thread : threads)
+			thread.join();
+
+		result.elapsed = sensor::utils::get_timestamp() - start;
+		result.cpu = get_cpu_time() - cpu + stop_server(pid);
+		result.messages = handler.received();
+
+		disconnect_receivers(&receivers);
+
+		WARN_IF(failed.load() || !ch, "flood: %s failed\n", result.mode);
+		WARN_IF(result.messages < (uint64_t)count, "flood: %llu of %d events received\n",
+				(unsigned long long)result.messages, count);
+		print_result(result, histogram);
+	}
+
+	return true;
+}
+
+/* sensord itself, found by name since the socket may be held by systemd */
+static pid_t find_sensord(void)
+{
+	char path[64];
+	char comm[32];
+	pid_t pid = -1;
+	struct dirent *entry;
+
+	DIR *dir = opendir("/proc");
+	RETV_IF(!dir, -1);
+
+	while (pid < 0 && (entry = readdir(dir)) != NULL) {
+		if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+			continue;
+
+		snprintf(path, sizeof(path), "/proc/%s/comm", entry->d_name);
+
+		FILE *fp = fopen(path, "r");
+		if (!fp)
+			continue;
+
+		if (fgets(comm, sizeof(comm), fp) && !strcmp(comm, "sensord\n"))
+			pid = atoi(entry->d_name);
+
+		fclose(fp);
+	}
+
+	closedir(dir);
+	return pid;
+}
+
+/* kB, 0 if unknown */
+static uint64_t get_rss(pid_t pid)
+{
+	char path[64];
+	char line[128];
+	unsigned long long rss = 0;
+
+	snprintf(path, sizeof(path), "/proc/%d/status", pid);
+
+	FILE *fp = fopen(path, "r");
+	RETV_IF(!fp, 0);
+
+	while (fgets(line, sizeof(line), fp)) {
+		if (sscanf(line, "VmRSS: %llu", &rss) == 1)
+			break;
+	}
+
+	fclose(fp);
+	return rss;
+}
+
+/* us of CPU the process has spent, 0 if unknown */
+static uint64_t get_process_cpu_time(pid_t pid)
+{
+	char path[64];
+	char buf[1024];
+	unsigned long long utime = 0;
+	unsigned long long stime = 0;
+
+	snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+
+	FILE *fp = fopen(path, "r");
+	RETV_IF(!fp, 0);
+
+	size_t len = fread(buf, 1, sizeof(buf) - 1, fp);
+	fclose(fp);
+	buf[len] = '\0';
+
+	/* the fields after the command, which may contain spaces */
+	char *pos = strrchr(buf, ')');
+	RETV_IF(!pos, 0);
+
+	if (sscanf(pos + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+				&utime, &stime) != 2)
+		return 0;
+
+	return (utime + stime) * 1000000ULL / sysconf(_SC_CLK_TCK);
+}
+
+static int request(channel *ch, int type, const void *buf, size_t size, message &reply)
+{
+	message msg;
+
+	msg.set_type(type);
+	msg.enclose(buf, size);
+
+	if (!ch->send_sync(msg) || !ch->read_sync(reply))
+		return -EIO;
+
+	return reply.header()->err;
+}
+
+/* Counts the events of all listeners, with their latency from the HAL read */
+class bench_listener_handler : public channel_handler
+{
+public:
+	bench_listener_handler(sensor::latency_histogram *histogram)
+	: m_histogram(histogram)
+	, m_received(0)
+	{}
+
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+
+	void read(channel *ch, message &msg)
+	{
+		RET_IF(msg.type() != CMD_LISTENER_EVENT);
+
+		if (msg.trailer()->read)
+			m_histogram->record(sensor::utils::get_timestamp() - msg.trailer()->read);
+
+		m_received++;
+	}
+
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+
+	uint64_t received(void) { return m_received; }
+
+private:
+	sensor::latency_histogram *m_histogram;
+	uint64_t m_received;
+};
+
+/* Opens a listener the way the client library does, but shares one
+ * command channel among all of them, so one process can hold thousands */
+static channel *connect_listener(ipc_client &client, channel *cmd, channel_handler *handler,
+		event_loop *loop, const char *uri)
+{
+	cmd_listener_connect_t buf;
+	cmd_listener_attr_int_t attr;
+	cmd_listener_start_t start;
+	message reply;
+
+	channel *ch = client.connect(handler, loop, false);
+	if (!ch || !ch->is_connected()) {
+		delete ch;
+		return NULL;
+	}
+
+	memset(&buf, 0, sizeof(buf));
+	snprintf(buf.sensor, sizeof(buf.sensor), "%s", uri);
+
+	if (request(ch, CMD_LISTENER_CONNECT, &buf, sizeof(buf), reply) < 0) {
+		ch->disconnect();
+		delete ch;
+		return NULL;
+	}
+
+	reply.disclose(&buf, sizeof(buf));
+	ch->bind();
+
+	attr.listener_id = buf.listener_id;
+	attr.attribute = SENSORD_ATTRIBUTE_INTERVAL;
+	attr.value = BENCH_SCALE_INTERVAL;
+	request(cmd, CMD_LISTENER_SET_ATTR_INT, &attr, sizeof(attr), reply);
+
+	/* the display may be off during the run */
+	attr.attribute = SENSORD_ATTRIBUTE_PAUSE_POLICY;
+	attr.value = SENSORD_PAUSE_NONE;
+	request(cmd, CMD_LISTENER_SET_ATTR_INT, &attr, sizeof(attr), reply);
+
+	start.listener_id = buf.listener_id;
+	if (request(cmd, CMD_LISTENER_START, &start, sizeof(start), reply) < 0) {
+		ch->disconnect();
+		delete ch;
+		return NULL;
+	}
+
+	return ch;
+}
+
+struct scale_context {
+	pid_t pid;
+	uint64_t end;
+	uint64_t cpu;
+};
+
+/* the window ends before the listeners are torn down */
+static void end_scale_window(void *data)
+{
+	scale_context *context = static_cast<scale_context *>(data);
+
+	context->end = sensor::utils::get_timestamp();
+	context->cpu = get_process_cpu_time(context->pid);
+}
+
+/* Many listeners of one sensor of a running sensord: its memory per listener
+ * and the CPU it spends to fan an event out to all of them */
+bool bench_manager::run_scale(int listeners)
+{
+	sensor_t sensor;
+	sensor::latency_histogram histogram;
+	scale_context context = {-1, 0, 0};
+	message reply;
+
+	int fd_limit = raise_fd_limit();
+	RETVM_IF(fd_limit < listeners + BENCH_FD_RESERVED, false,
+			"scale: %d listeners exceed the limit of open files[%d]\n", listeners, fd_limit);
+
+	RETVM_IF(sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor) < 0, false,
+			"scale: no accelerometer\n");
+	const char *uri = sensord_get_uri(sensor);
+
+	context.pid = find_sensord();
+	WARN_IF(context.pid < 0, "scale: sensord is not found, its memory and CPU are not reported\n");
+
+	event_loop loop;
+	ipc_client client(SENSOR_CHANNEL_PATH);
+	bench_receivers receivers = {&loop, std::vector<channel *>(), false, end_scale_window, &context};
+	bench_listener_handler handler(&histogram);
+
+	channel *cmd = client.connect(NULL);
+	RETVM_IF(!cmd || !cmd->is_connected(), false, "scale: failed to connect to sensord\n");
+
+	uint64_t rss = get_rss(context.pid);
+	uint64_t start = sensor::utils::get_timestamp();
+
+	for (int i = 0; i < listeners && m_running.load(); ++i) {
+		channel *ch = connect_listener(client, cmd, &handler, &loop, uri);
+		if (!ch)
+			break;
+		receivers.channels.push_back(ch);
+	}
+
+	int connected = receivers.channels.size();
+	uint64_t connect_time = sensor::utils::get_timestamp() - start;
+	uint64_t grown = get_rss(context.pid);
+	grown = (grown > rss) ? grown - rss : 0;
+
+	WARN_IF(connected < listeners, "scale: %d of %d listeners connected\n", connected, listeners);
+
+	start = sensor::utils::get_timestamp();
+	uint64_t cpu = get_process_cpu_time(context.pid);
+
+	if (connected > 0)
+		run_receivers(&receivers, BENCH_SCALE_DURATION);
+
+	disconnect_receivers(&receivers);
+	cmd->disconnect();
+	delete cmd;
+
+	uint64_t deliveries = handler.received();
+	uint64_t events = (connected > 0) ? deliveries / connected : 0;
+	double seconds = (context.end > start) ? (context.end - start) / 1000000.0 : 0;
+	double cpu_us = (context.cpu > cpu) ? (double)(context.cpu - cpu) : 0;
+
+	_N("suite,listeners,connect_seconds,rss_kb,kbytes_per_listener,events,deliveries,seconds,"
+			"cpu_us_per_event,cpu_us_per_delivery,p50_us,p99_us,p999_us,max_us\n");
+	_N("scale,%d,%.3f,%llu,%.3f,%llu,%llu,%.3f,%.2f,%.3f,%llu,%llu,%llu,%llu\n",
+			connected, connect_time / 1000000.0,
+			(unsigned long long)(rss + grown),
+			(connected > 0) ? (double)grown / connected : 0,
+			(unsigned long long)events, (unsigned long long)deliveries, seconds,
+			(events > 0) ? cpu_us / events : 0,
+			(deliveries > 0) ? cpu_us / deliveries : 0,
+			(unsigned long long)histogram.percentile(50),
+			(unsigned long long)histogram.percentile(99),
+			(unsigned long long)histogram.percentile(99.9),
+			(unsigned long long)histogram.max());
+
+	return true;
+}
+
+bool bench_manager::run(int argc, char *argv[])
+{
+	const char *suite = (argc > 2) ? argv[2] : "all";
+	int count = (argc > 3) ? atoi(argv[3]) : 0;
+
+	if (argc > 4 || count < 0) {
+		usage();
+		return false;
+	}
+
+	bool rtt = !strcmp(suite, "all") || !strcmp(suite, "rtt");
+	bool fanout = !strcmp(suite, "all") || !strcmp(suite, "fanout");
+	bool flood = !strcmp(suite, "all") || !strcmp(suite, "flood");
+	/* not part of all, it needs a running sensord */
+	bool scale = !strcmp(suite, "scale");
+
+	if (!rtt && !fanout && !flood && !scale) {
+		usage();
+		return false;
+	}
+
+	m_running.store(true);
+
+	if (scale)
+		return run_scale(count ? count : BENCH_SCALE_LISTENERS);
+
+	print_header();
+
+	if (rtt && !run_rtt(count ? count : BENCH_RTT_COUNT))
+		return false;
+
+	if (fanout && !run_fanout(count ? count : BENCH_FANOUT_COUNT))
+		return false;
+
+	if (flood && !run_flood(count ? count : BENCH_FLOOD_COUNT))
+		return false;
+
+	return true;
+}
+
+void bench_manager::stop(void)
+{
+	m_running.store(false);
+}
+
+void bench_manager::usage(void)
+{
+	_N("usage: sensorctl bench [rtt|fanout|flood|all|scale] [<count>]\n\n");
+	_N("  rtt:    round trips of 1..8 clients with 64B..32KB messages\n");
+	_N("  fanout: one event broadcast to 1..1000 listeners\n");
+	_N("  flood:  events to a listener while 32 clients flood commands\n");
+	_N("  scale:  10000 listeners of the accelerometer of the running sensord\n");
+	_N("  count:  round trips per client, events per listener, or listeners\n\n");
+	_N("  rtt and fanout are run with sync and async replies of the server,\n");
+	_N("  flood with and without scheduling classes. Each case is printed\n");
+	_N("  as a CSV line, latencies are in us. scale reports the memory of\n");
+	_N("  sensord per listener and the CPU it spends per event fanned out.\n");
+}
@@ -0,0 +1,42 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once /* __BENCH_MANAGER_H__ */
+
+#include <atomic>
+#include "sensor_manager.h"
+
+class bench_manager : public sensor_manager {
+public:
+	bench_manager()
+	: m_running(false)
+	{}
+	virtual ~bench_manager() {}
+
+	bool run(int argc, char *argv[]);
+	void stop(void);
+private:
+	bool run_rtt(int count);
+	bool run_fanout(int count);
+	bool run_flood(int count);
+	bool run_scale(int listeners);
+	void usage(void);
+
+	std::atomic<bool> m_running;
+};
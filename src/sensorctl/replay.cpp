@@ -0,0 +1,774 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <dlfcn.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fusion_sensor.h>
+
+#include "log.h"
+
+#define FUSION_PLUGIN_PATH LIBDIR "/sensor/fusion/libsensor-fusion.so"
+
+#define REPLAY_REPEAT 10
+#define REPLAY_MAX_DEPTH 8		/* fusion sensors fed by fusion sensors */
+#define REPLAY_LINE_MAX 1024
+
+#define GOLDEN_EVENTS 64		/* events kept per sensor and capture */
+#define GOLDEN_ABS_TOLERANCE 0.01
+#define GOLDEN_REL_TOLERANCE 0.001
+
+/* how the values of an output are compared with the golden ones */
+enum golden_values_e {
+	GOLDEN_VALUES_PLAIN = 0,
+	GOLDEN_VALUES_ANGLES,		/* degrees, the same modulo 360 */
+	GOLDEN_VALUES_QUATERNION,	/* q and -q are the same rotation */
+};
+
+/* Samples of a capture are published under the uri of a physical sensor
+ * so that the fusion sensors resolve them as their usual providers */
+typedef struct {
+	const char *file;
+	const char *uri;
+} replay_source_t;
+
+static const replay_source_t replay_sources[] = {
+	{"accel",    "http://tizen.org/sensor/general/accelerometer/replay"},
+	{"gyro",     "http://tizen.org/sensor/general/gyroscope/replay"},
+	{"magnetic", "http://tizen.org/sensor/general/magnetic/replay"},
+};
+
+#define REPLAY_SOURCE_COUNT (sizeof(replay_sources) / sizeof(replay_sources[0]))
+
+typedef struct {
+	int source;
+	sensor_data_t data;
+} replay_sample_t;
+
+typedef struct {
+	uint32_t id;
+	sensor_data_t data;
+} replay_input_t;
+
+struct replay_capture {
+	std::string path;	/* relative to the data directory */
+	std::vector<replay_sample_t> samples;
+};
+
+struct replay_node {
+	fusion_sensor *sensor;
+	std::string uri;
+	std::string name;
+	int values;		/* golden_values_e */
+	bool ready;
+	std::vector<std::pair<uint32_t, std::string>> inputs;	/* required id, provider uri */
+	std::vector<replay_input_t> received;
+	std::vector<sensor_data_t> events;
+};
+
+struct replay_stat {
+	replay_stat()
+	: samples(0)
+	, events(0)
+	, elapsed(0)
+	{}
+
+	uint64_t samples;
+	uint64_t events;
+	uint64_t elapsed;	/* ns */
+};
+
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* "http://tizen.org/sensor/general/rotation_vector" matches
+ * "http://tizen.org/sensor/general/rotation_vector/tizen_default" */
+static bool match_uri(const char *required, const std::string &uri)
+{
+	size_t len = strlen(required);
+
+	if (uri.compare(0, len, required) != 0)
+		return false;
+
+	return (uri.size() == len || uri[len] == '/');
+}
+
+/* the last two components of the uri, e.g. "rotation_vector.tizen_default" */
+static std::string get_name(const std::string &uri)
+{
+	size_t last = uri.rfind('/');
+	size_t type = (last == std::string::npos || last == 0) ?
+			std::string::npos : uri.rfind('/', last - 1);
+
+	if (type == std::string::npos)
+		return uri;
+
+	std::string name = uri.substr(type + 1);
+	name[last - type - 1] = '.';
+
+	return name;
+}
+
+static int get_values(sensor_type_t type)
+{
+	switch (type) {
+	case ORIENTATION_SENSOR:
+	case GYROSCOPE_ORIENTATION_SENSOR:
+	case GEOMAGNETIC_ORIENTATION_SENSOR:
+		return GOLDEN_VALUES_ANGLES;
+	case ROTATION_VECTOR_SENSOR:
+	case GYROSCOPE_RV_SENSOR:
+	case GEOMAGNETIC_RV_SENSOR:
+		return GOLDEN_VALUES_QUATERNION;
+	default:
+		return GOLDEN_VALUES_PLAIN;
+	}
+}
+
+static bool is_dir(const std::string &path)
+{
+	struct stat st;
+
+	return (stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode));
+}
+
+static bool make_dirs(const std::string &path)
+{
+	size_t pos = 0;
+
+	while (pos != std::string::npos) {
+		pos = path.find('/', pos + 1);
+		std::string dir = path.substr(0, pos);
+
+		if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+			_E("Failed to create %s: %s\n", dir.c_str(), strerror(errno));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool load_samples(const std::string &path, int source, std::vector<replay_sample_t> &samples)
+{
+	char line[REPLAY_LINE_MAX];
+	FILE *fp = fopen(path.c_str(), "r");
+	RETVM_IF(!fp, false, "Failed to open %s\n", path.c_str());
+
+	while (fgets(line, sizeof(line), fp)) {
+		replay_sample_t sample;
+		double timestamp;
+
+		memset(&sample, 0, sizeof(sample));
+
+		if (sscanf(line, "%f %f %f %lf", &sample.data.values[0], &sample.data.values[1],
+				&sample.data.values[2], &timestamp) != 4)
+			continue;
+
+		sample.source = source;
+		sample.data.accuracy = SENSOR_ACCURACY_GOOD;
+		sample.data.timestamp = (unsigned long long)timestamp;
+		sample.data.value_count = 3;
+		samples.push_back(sample);
+	}
+
+	fclose(fp);
+	return true;
+}
+
+static bool compare_timestamp(const replay_sample_t &a, const replay_sample_t &b)
+{
+	return a.data.timestamp < b.data.timestamp;
+}
+
+/* Every directory holding an accel, gyro or magnetic file (with or without
+ * ".txt") is a capture, its sources are merged in timestamp order */
+static bool load_captures(const std::string &root, const std::string &rel,
+		std::vector<replay_capture> &captures)
+{
+	std::string dir = rel.empty() ? root : root + "/" + rel;
+	std::vector<std::string> children;
+	replay_capture capture;
+	struct dirent *entry;
+
+	DIR *dp = opendir(dir.c_str());
+	RETVM_IF(!dp, false, "Failed to open %s\n", dir.c_str());
+
+	while ((entry = readdir(dp))) {
+		if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+			continue;
+		if (is_dir(dir + "/" + entry->d_name))
+			children.push_back(entry->d_name);
+	}
+	closedir(dp);
+
+	for (unsigned int i = 0; i < REPLAY_SOURCE_COUNT; ++i) {
+		std::string path = dir + "/" + replay_sources[i].file;
+
+		if (access((path + ".txt").c_str(), R_OK) == 0)
+			path += ".txt";
+		else if (access(path.c_str(), R_OK) != 0)
+			continue;
+
+		if (!load_samples(path, i, capture.samples))
+			return false;
+	}
+
+	if (!capture.samples.empty()) {
+		std::stable_sort(capture.samples.begin(), capture.samples.end(), compare_timestamp);
+		capture.path = rel;
+		captures.push_back(capture);
+	}
+
+	std::sort(children.begin(), children.end());
+
+	for (auto it = children.begin(); it != children.end(); ++it) {
+		if (!load_captures(root, rel.empty() ? *it : rel + "/" + *it, captures))
+			return false;
+	}
+
+	return true;
+}
+
+/* Every call of create() of the plugin appends a new instance of each of
+ * its sensors, so each graph gets sensors of its own */
+class fusion_plugin {
+public:
+	fusion_plugin()
+	: m_handle(NULL)
+	, m_create(NULL)
+	, m_created(0)
+	{}
+
+	~fusion_plugin()
+	{
+		if (m_handle)
+			dlclose(m_handle);
+	}
+
+	bool load(const char *path)
+	{
+		m_handle = dlopen(path, RTLD_NOW);
+		RETVM_IF(!m_handle, false, "Failed to load %s: %s\n", path, dlerror());
+
+		m_create = (create_fusion_t)dlsym(m_handle, "create");
+		RETVM_IF(!m_create, false, "Failed to find create() in %s\n", path);
+
+		return true;
+	}
+
+	bool create(std::vector<fusion_sensor *> &sensors)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		fusion_sensor_t *list = NULL;
+
+		int size = m_create(&list);
+		RETV_IF(size <= m_created || !list, false);
+
+		for (int i = m_created; i < size; ++i)
+			sensors.push_back(static_cast<fusion_sensor *>(list[i]));
+
+		m_created = size;
+		return true;
+	}
+
+private:
+	void *m_handle;
+	create_fusion_t m_create;
+	int m_created;
+	std::mutex m_lock;
+};
+
+/* The fusion sensors of a plugin wired to each other and to the capture
+ * sources the way the server resolves their required sensors */
+class replay_graph {
+public:
+	replay_graph()
+	: m_record(false)
+	{}
+
+	~replay_graph()
+	{
+		for (auto it = nodes.begin(); it != nodes.end(); ++it)
+			delete it->sensor;
+	}
+
+	bool init(fusion_plugin &plugin)
+	{
+		std::vector<fusion_sensor *> sensors;
+
+		RETV_IF(!plugin.create(sensors), false);
+
+		for (auto it = sensors.begin(); it != sensors.end(); ++it) {
+			const sensor_info2_t *info = NULL;
+			replay_node node;
+
+			node.sensor = *it;
+			node.ready = true;
+			node.values = GOLDEN_VALUES_PLAIN;
+
+			if ((*it)->get_sensor_info(&info) < 0 || !info) {
+				node.uri = "unknown";
+			} else {
+				node.uri = info->uri;
+				node.values = get_values(info->type);
+			}
+
+			node.name = get_name(node.uri);
+			nodes.push_back(node);
+		}
+
+		for (auto it = nodes.begin(); it != nodes.end(); ++it)
+			resolve(*it);
+
+		for (auto it = nodes.begin(); it != nodes.end(); ++it)
+			it->sensor->start(&*it);
+
+		return true;
+	}
+
+	void replay(const replay_capture &capture, bool record)
+	{
+		m_record = record;
+
+		for (auto it = capture.samples.begin(); it != capture.samples.end(); ++it) {
+			sensor_data_t data = it->data;
+			publish(replay_sources[it->source].uri, &data, sizeof(data), 0);
+		}
+	}
+
+	std::vector<replay_node> nodes;
+
+private:
+	void resolve(replay_node &node)
+	{
+		const required_sensor_s *required = NULL;
+		int count = node.sensor->get_required_sensors(&required);
+
+		for (int i = 0; i < count; ++i) {
+			std::string provider;
+
+			for (unsigned int j = 0; j < REPLAY_SOURCE_COUNT && provider.empty(); ++j) {
+				if (match_uri(required[i].uri, replay_sources[j].uri))
+					provider = replay_sources[j].uri;
+			}
+
+			for (auto it = nodes.begin(); it != nodes.end() && provider.empty(); ++it) {
+				if (&*it != &node && match_uri(required[i].uri, it->uri))
+					provider = it->uri;
+			}
+
+			if (provider.empty()) {
+				node.ready = false;
+				return;
+			}
+
+			node.inputs.push_back(std::make_pair(required[i].id, provider));
+		}
+
+		if (count <= 0)
+			node.ready = false;
+	}
+
+	void publish(const std::string &uri, sensor_data_t *data, int len, int depth)
+	{
+		RET_IF(depth > REPLAY_MAX_DEPTH);
+
+		for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+			if (!it->ready)
+				continue;
+
+			for (auto in = it->inputs.begin(); in != it->inputs.end(); ++in) {
+				if (in->second != uri)
+					continue;
+
+				if (m_record) {
+					replay_input_t input = {in->first, *data};
+					it->received.push_back(input);
+				}
+
+				if (it->sensor->update(in->first, data, len) < 0)
+					continue;
+
+				sensor_data_t *out = NULL;
+				int out_len = 0;
+
+				if (it->sensor->get_data(&out, &out_len) < 0 || !out)
+					continue;
+
+				for (unsigned int i = 0; i < out_len / sizeof(sensor_data_t); ++i)
+					it->events.push_back(out[i]);
+
+				publish(it->uri, out, out_len, depth + 1);
+				free(out);
+			}
+		}
+	}
+
+	bool m_record;
+};
+
+static bool write_golden(const std::string &path, const replay_node &node)
+{
+	size_t count = node.events.size();
+	size_t kept = std::min(count, (size_t)GOLDEN_EVENTS);
+
+	FILE *fp = fopen(path.c_str(), "w");
+	RETVM_IF(!fp, false, "Failed to create %s: %s\n", path.c_str(), strerror(errno));
+
+	fprintf(fp, "# %s\n", node.uri.c_str());
+	fprintf(fp, "# events %zu\n", count);
+
+	/* evenly spaced events, always including the first and the last one */
+	for (size_t i = 0; i < kept; ++i) {
+		size_t index = (kept > 1) ? i * (count - 1) / (kept - 1) : 0;
+		const sensor_data_t &data = node.events[index];
+
+		fprintf(fp, "%zu %llu %d %d", index, data.timestamp, data.accuracy, data.value_count);
+
+		for (int j = 0; j < data.value_count && j < SENSOR_DATA_VALUE_SIZE; ++j)
+			fprintf(fp, " %.9g", data.values[j]);
+
+		fprintf(fp, "\n");
+	}
+
+	fclose(fp);
+	return true;
+}
+
+static bool is_close(double value, double expected, bool angle, double &error)
+{
+	double diff = fabs(value - expected);
+
+	/* 359.9 and -0.1 are the same azimuth */
+	if (angle) {
+		diff = fmod(diff, 360);
+		diff = std::min(diff, 360 - diff);
+	}
+
+	error = std::max(error, diff);
+	return (diff <= GOLDEN_ABS_TOLERANCE + GOLDEN_REL_TOLERANCE * fabs(expected));
+}
+
+static bool is_same_event(const sensor_data_t &data, const sensor_data_t &expected, int values,
+		double &error)
+{
+	bool same = (data.timestamp == expected.timestamp && data.accuracy == expected.accuracy &&
+			data.value_count == expected.value_count);
+	int count = std::min(expected.value_count, SENSOR_DATA_VALUE_SIZE);
+	float sign = 1;
+
+	/* a filter may flip to -q on its way, compare with the sign closer to expected */
+	if (values == GOLDEN_VALUES_QUATERNION && count >= 4) {
+		double dot = 0;
+
+		for (int j = 0; j < 4; ++j)
+			dot += data.values[j] * expected.values[j];
+		if (dot < 0)
+			sign = -1;
+	}
+
+	for (int j = 0; j < count; ++j) {
+		float value = (values == GOLDEN_VALUES_QUATERNION && j < 4) ? sign * data.values[j] : data.values[j];
+
+		if (!is_close(value, expected.values[j], values == GOLDEN_VALUES_ANGLES, error))
+			same = false;
+	}
+
+	return same;
+}
+
+static bool check_golden(const std::string &path, const replay_node &node,
+		size_t &differing, double &error)
+{
+	char line[REPLAY_LINE_MAX];
+	size_t count = 0;
+
+	FILE *fp = fopen(path.c_str(), "r");
+	RETVM_IF(!fp, false, "Failed to open %s\n", path.c_str());
+
+	while (fgets(line, sizeof(line), fp)) {
+		if (sscanf(line, "# events %zu", &count) == 1) {
+			if (count != node.events.size()) {
+				_E("%s: %zu events, expected %zu\n", path.c_str(), node.events.size(), count);
+				fclose(fp);
+				return false;
+			}
+			continue;
+		}
+
+		if (line[0] == '#')
+			continue;
+
+		sensor_data_t expected;
+		size_t index;
+		int offset;
+		char *pos = line;
+
+		memset(&expected, 0, sizeof(expected));
+
+		if (sscanf(pos, "%zu %llu %d %d%n", &index, &expected.timestamp, &expected.accuracy,
+				&expected.value_count, &offset) != 4)
+			continue;
+
+		for (int j = 0; j < expected.value_count && j < SENSOR_DATA_VALUE_SIZE; ++j) {
+			pos += offset;
+			if (sscanf(pos, "%f%n", &expected.values[j], &offset) != 1)
+				break;
+		}
+
+		if (index >= node.events.size() || !is_same_event(node.events[index], expected, node.values, error))
+			differing++;
+	}
+
+	fclose(fp);
+	return (differing == 0);
+}
+
+bool replay_manager::run_check(const char *data_dir, const char *golden_dir,
+		const char *plugin_path, bool record)
+{
+	std::vector<replay_capture> captures;
+	fusion_plugin plugin;
+	int failed = 0;
+
+	RETV_IF(!load_captures(data_dir, "", captures), false);
+	RETVM_IF(captures.empty(), false, "No captures in %s\n", data_dir);
+	RETV_IF(!plugin.load(plugin_path), false);
+
+	if (!record)
+		_N("capture,sensor,result,events,differing,max_error\n");
+
+	for (auto cap = captures.begin(); cap != captures.end() && m_running; ++cap) {
+		replay_graph graph;
+		std::string dir = std::string(golden_dir) + "/" + cap->path;
+
+		RETV_IF(!graph.init(plugin), false);
+		graph.replay(*cap, false);
+
+		if (record) {
+			RETV_IF(!make_dirs(dir), false);
+
+			for (auto node = graph.nodes.begin(); node != graph.nodes.end(); ++node) {
+				if (!node->ready)
+					continue;
+
+				std::string path = dir + "/" + node->name + ".txt";
+
+				RETV_IF(!write_golden(path, *node), false);
+				_I("%s: %zu events\n", path.c_str(), node->events.size());
+			}
+			continue;
+		}
+
+		for (auto node = graph.nodes.begin(); node != graph.nodes.end(); ++node) {
+			if (!node->ready)
+				continue;
+
+			std::string path = dir + "/" + node->name + ".txt";
+			size_t differing = 0;
+			double error = 0;
+			bool passed = check_golden(path, *node, differing, error);
+
+			if (!passed)
+				failed++;
+
+			_N("%s,%s,%s,%zu,%zu,%g\n", cap->path.c_str(), node->name.c_str(),
+					passed ? "PASS" : "FAIL",
+					node->events.size(), differing, error);
+		}
+	}
+
+	if (!record && failed) {
+		_E("%d outputs differ from %s\n", failed, golden_dir);
+		return false;
+	}
+
+	return true;
+}
+
+/* Each sensor is timed alone on the inputs it got during a replay of the
+ * whole graph, so the cost of its providers is not accounted to it */
+static void bench_node(fusion_plugin &plugin, int index, const std::vector<replay_input_t> &inputs,
+		replay_stat &stat)
+{
+	replay_graph graph;
+
+	RET_IF(!graph.init(plugin));
+
+	fusion_sensor *sensor = graph.nodes[index].sensor;
+	uint64_t events = 0;
+	uint64_t start = get_time_ns();
+
+	for (auto it = inputs.begin(); it != inputs.end(); ++it) {
+		sensor_data_t data = it->data;
+		sensor_data_t *out = NULL;
+		int len = 0;
+
+		if (sensor->update(it->id, &data, sizeof(data)) < 0)
+			continue;
+		if (sensor->get_data(&out, &len) < 0 || !out)
+			continue;
+
+		events += len / sizeof(sensor_data_t);
+		free(out);
+	}
+
+	stat.elapsed += get_time_ns() - start;
+	stat.samples += inputs.size();
+	stat.events += events;
+}
+
+bool replay_manager::run_bench(const char *data_dir, int repeat, const char *plugin_path)
+{
+	std::vector<replay_capture> captures;
+	std::map<std::string, replay_stat> stats;
+	fusion_plugin plugin;
+	replay_stat total;
+	std::mutex lock;
+
+	RETV_IF(!load_captures(data_dir, "", captures), false);
+	RETVM_IF(captures.empty(), false, "No captures in %s\n", data_dir);
+	RETV_IF(!plugin.load(plugin_path), false);
+
+	int threads = std::max(1U, std::thread::hardware_concurrency());
+	uint64_t start = get_time_ns();
+
+	for (auto cap = captures.begin(); cap != captures.end() && m_running; ++cap) {
+		replay_graph reference;
+		std::vector<int> jobs;
+		std::atomic<unsigned int> next(0);
+		std::vector<std::thread> workers;
+
+		RETV_IF(!reference.init(plugin), false);
+		reference.replay(*cap, true);
+
+		for (unsigned int i = 0; i < reference.nodes.size(); ++i) {
+			if (reference.nodes[i].received.empty())
+				continue;
+			for (int r = 0; r < repeat; ++r)
+				jobs.push_back(i);
+		}
+
+		for (int t = 0; t < threads; ++t) {
+			workers.push_back(std::thread([&]() {
+				unsigned int job;
+
+				while (m_running && (job = next++) < jobs.size()) {
+					replay_node &node = reference.nodes[jobs[job]];
+					replay_stat stat;
+
+					bench_node(plugin, jobs[job], node.received, stat);
+
+					std::lock_guard<std::mutex> guard(lock);
+					replay_stat &sum = stats[node.name];
+
+					sum.samples += stat.samples;
+					sum.events += stat.events;
+					sum.elapsed += stat.elapsed;
+				}
+			}));
+		}
+
+		for (auto it = workers.begin(); it != workers.end(); ++it)
+			it->join();
+	}
+
+	uint64_t elapsed = get_time_ns() - start;
+
+	_N("sensor,samples,events,ns_per_sample\n");
+
+	for (auto it = stats.begin(); it != stats.end(); ++it) {
+		const replay_stat &stat = it->second;
+
+		_N("%s,%llu,%llu,%.1f\n", it->first.c_str(),
+				(unsigned long long)stat.samples, (unsigned long long)stat.events,
+				stat.samples ? (double)stat.elapsed / stat.samples : 0.0);
+
+		total.samples += stat.samples;
+		total.events += stat.events;
+	}
+
+	/* wall clock of all threads, references replays included */
+	_N("all(%d threads),%llu,%llu,%.1f\n", threads,
+			(unsigned long long)total.samples, (unsigned long long)total.events,
+			total.samples ? (double)elapsed / total.samples : 0.0);
+
+	return true;
+}
+
+bool replay_manager::run(int argc, char *argv[])
+{
+	const char *mode = (argc > 2) ? argv[2] : "";
+	bool record = !strcmp(mode, "record");
+
+	m_running.store(true);
+
+	if ((record || !strcmp(mode, "check")) && (argc == 5 || argc == 6))
+		return run_check(argv[3], argv[4], (argc == 6) ? argv[5] : FUSION_PLUGIN_PATH, record);
+
+	if (!strcmp(mode, "bench") && argc >= 4 && argc <= 6) {
+		int repeat = (argc > 4) ? atoi(argv[4]) : REPLAY_REPEAT;
+
+		if (repeat > 0)
+			return run_bench(argv[3], repeat, (argc == 6) ? argv[5] : FUSION_PLUGIN_PATH);
+	}
+
+	usage();
+	return false;
+}
+
+void replay_manager::stop(void)
+{
+	m_running.store(false);
+}
+
+void replay_manager::usage(void)
+{
+	_N("usage: sensorctl replay check <data_dir> <golden_dir> [<plugin>]\n");
+	_N("       sensorctl replay record <data_dir> <golden_dir> [<plugin>]\n");
+	_N("       sensorctl replay bench <data_dir> [<repeat>] [<plugin>]\n\n");
+	_N("  check:  replay the captures through the fusion sensors of the plugin\n");
+	_N("          and compare their outputs with the golden files\n");
+	_N("  record: write the outputs of the plugin as the golden files\n");
+	_N("  bench:  time each fusion sensor on its inputs on all cores, in ns\n");
+	_N("          per input sample\n\n");
+	_N("  The plugin is %s by default.\n", FUSION_PLUGIN_PATH);
+}
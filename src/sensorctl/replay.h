@@ -0,0 +1,40 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once /* __REPLAY_MANAGER_H__ */
+
+#include <atomic>
+#include "sensor_manager.h"
+
+class replay_manager : public sensor_manager {
+public:
+	replay_manager()
+	: m_running(false)
+	{}
+	virtual ~replay_manager() {}
+
+	bool run(int argc, char *argv[]);
+	void stop(void);
+private:
+	bool run_check(const char *data_dir, const char *golden_dir, const char *plugin, bool record);
+	bool run_bench(const char *data_dir, int repeat, const char *plugin);
+	void usage(void);
+
+	std::atomic<bool> m_running;
+};
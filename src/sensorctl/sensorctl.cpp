@@ -28,6 +28,9 @@
 #include "injector.h"
 #include "info.h"
 #include "loopback.h"
+#include "stats.h"
+#include "bench.h"
+#include "replay.h"
 #include "sensor_adapter.h"
 
 static sensor_manager *manager;
@@ -40,6 +43,10 @@ static void usage(void)
 	_N("  test:   test sensor(s)\n");
 	_N("  inject: inject the event to sensor\n");
 	_N("  info:   show sensor infos\n");
+	_N("  stats:  show statistics of sensord\n");
+	_N("  top:    show statistics of sensord continuously\n");
+	_N("  bench:  benchmark the ipc layer of sensord\n");
+	_N("  replay: replay captures through the fusion sensors\n");
 }
 
 static sensor_manager *create_manager(char *command)
@@ -57,6 +64,14 @@ static sensor_manager *create_manager(char *command)
 		manager = new(std::nothrow) info_manager;
 	} else if (!strcmp(command, "loopback")) {
 		manager = new(std::nothrow) loopback_manager;
+	} else if (!strcmp(command, "stats")) {
+		manager = new(std::nothrow) stats_manager(false);
+	} else if (!strcmp(command, "top")) {
+		manager = new(std::nothrow) stats_manager(true);
+	} else if (!strcmp(command, "bench")) {
+		manager = new(std::nothrow) bench_manager;
+	} else if (!strcmp(command, "replay")) {
+		manager = new(std::nothrow) replay_manager;
 	}
 
 	if (!manager) {
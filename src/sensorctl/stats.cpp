@@ -0,0 +1,189 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include <ipc_client.h>
+#include <channel.h>
+#include <channel_handler.h>
+#include <message.h>
+
+#include "log.h"
+
+#define TOP_INTERVAL_SEC 1
+
+using namespace ipc;
+
+class stats_channel_handler : public channel_handler
+{
+public:
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+	void read(channel *ch, message &msg) {}
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+};
+
+bool stats_manager::run(int argc, char *argv[])
+{
+	std::vector<char> buf;
+
+	if (argc > 2) {
+		usage();
+		return false;
+	}
+
+	m_running.store(true);
+
+	do {
+		if (!get_stats(buf))
+			return false;
+
+		/* clear the screen, so that the table is refreshed in place */
+		if (m_top)
+			_N("\x1B[H\x1B[2J");
+
+		show_stats(buf);
+
+		if (m_top)
+			sleep(TOP_INTERVAL_SEC);
+	} while (m_top && m_running.load());
+
+	return true;
+}
+
+void stats_manager::stop(void)
+{
+	m_running.store(false);
+}
+
+bool stats_manager::get_stats(std::vector<char> &buf)
+{
+	ipc_client client(SENSOR_CHANNEL_PATH);
+	stats_channel_handler handler;
+
+	channel *ch = client.connect(&handler, NULL);
+	RETVM_IF(!ch, false, "Failed to connect to sensord\n");
+
+	message msg;
+	message reply;
+	msg.set_type(CMD_GET_STATS);
+
+	bool ret = ch->send_sync(msg) && ch->read_sync(reply);
+
+	ch->disconnect();
+	delete ch;
+
+	RETVM_IF(!ret, false, "Failed to get statistics\n");
+	RETVM_IF(reply.header()->err < 0, false,
+			"Failed to get statistics : %d\n", reply.header()->err);
+	RETVM_IF(reply.size() < sizeof(cmd_get_stats_t), false, "Invalid statistics\n");
+
+	buf.assign(reply.body(), reply.body() + reply.size());
+	return true;
+}
+
+static const char *stage_name(int stage)
+{
+	switch (stage) {
+	case SENSORD_LATENCY_HAL_TO_NOTIFY:
+		return "hal->notify";
+	case SENSORD_LATENCY_NOTIFY_TO_WRITE:
+		return "notify->write";
+	case SENSORD_LATENCY_WRITE_TO_RECEIVE:
+		return "write->receive";
+	case SENSORD_LATENCY_RECEIVE_TO_DISPATCH:
+		return "receive->dispatch";
+	case SENSORD_LATENCY_END_TO_END:
+		return "end-to-end";
+	default:
+		return "unknown";
+	}
+}
+
+void stats_manager::show_stats(std::vector<char> &buf)
+{
+	cmd_get_stats_t *stats = reinterpret_cast<cmd_get_stats_t *>(buf.data());
+	size_t size = sizeof(cmd_get_stats_t) +
+			sizeof(cmd_latency_stats_t) * stats->latency_cnt +
+			sizeof(cmd_sensor_stats_t) * stats->sensor_cnt +
+			sizeof(cmd_listener_stats_t) * stats->listener_cnt;
+	RETM_IF(buf.size() < size, "Invalid statistics\n");
+
+	cmd_latency_stats_t *latencies = reinterpret_cast<cmd_latency_stats_t *>(stats->data);
+	cmd_sensor_stats_t *sensors = reinterpret_cast<cmd_sensor_stats_t *>(latencies + stats->latency_cnt);
+	cmd_listener_stats_t *listeners = reinterpret_cast<cmd_listener_stats_t *>(sensors + stats->sensor_cnt);
+
+	_N("LATENCY (us)\n");
+	_N("%-18s %12s %9s %9s %9s %9s\n", "STAGE", "COUNT", "P50", "P99", "P99.9", "MAX");
+
+	for (int i = 0; i < stats->latency_cnt; ++i) {
+		_N("%-18s %12llu %9llu %9llu %9llu %9llu\n", stage_name(latencies[i].stage),
+				(unsigned long long)latencies[i].count,
+				(unsigned long long)latencies[i].p50,
+				(unsigned long long)latencies[i].p99,
+				(unsigned long long)latencies[i].p999,
+				(unsigned long long)latencies[i].max);
+	}
+
+	_N("\n");
+	_N("SENSORS (%d/%d)\n", stats->sensor_cnt, stats->total_sensor_cnt);
+	_N("%4s %12s %12s %12s %9s %5s %5s %5s %8s  %s\n",
+			"#", "READ", "NOTIFIED", "FUSED", "RATE(Hz)", "OBS",
+			"QUEUE", "QMAX", "QDROPS", "URI");
+
+	for (int i = 0; i < stats->sensor_cnt; ++i) {
+		_N("%4d %12llu %12llu %12llu %9.2f %5d %5d %5d %8llu  %s\n", i,
+				(unsigned long long)sensors[i].events_read,
+				(unsigned long long)sensors[i].events_notified,
+				(unsigned long long)sensors[i].fusion_evaluations,
+				sensors[i].rate, sensors[i].observer_count,
+				sensors[i].queue_depth, sensors[i].queue_max_depth,
+				(unsigned long long)sensors[i].queue_overflows, sensors[i].uri);
+	}
+
+	_N("\nLISTENERS (%d/%d)\n", stats->listener_cnt, stats->total_listener_cnt);
+	_N("%6s %7s %4s %3s %10s %12s %8s %10s %5s %8s %8s\n",
+			"ID", "PID", "SNS", "RUN", "EVENTS", "BYTES", "DROPS", "FILTERED",
+			"QUEUE", "REQ(ms)", "EFF(ms)");
+
+	for (int i = 0; i < stats->listener_cnt; ++i) {
+		_N("%6d %7d %4d %3s %10llu %12llu %8llu %10llu %5d %8d %8.2f\n",
+				listeners[i].listener_id, listeners[i].pid, listeners[i].sensor_index,
+				listeners[i].started ? "on" : "off",
+				(unsigned long long)listeners[i].events,
+				(unsigned long long)listeners[i].bytes,
+				(unsigned long long)listeners[i].drops,
+				(unsigned long long)listeners[i].filtered,
+				listeners[i].queue_depth, listeners[i].interval,
+				listeners[i].effective_interval);
+	}
+}
+
+void stats_manager::usage(void)
+{
+	_N("usage: sensorctl stats\n");
+	_N("       sensorctl top\n\n");
+	_N("  stats: show the counters of sensord once\n");
+	_N("  top:   refresh the counters every second\n");
+}
@@ -0,0 +1,44 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once /* __STATS_MANAGER_H__ */
+
+#include <atomic>
+#include <vector>
+#include <command_types.h>
+#include "sensor_manager.h"
+
+class stats_manager : public sensor_manager {
+public:
+	stats_manager(bool top)
+	: m_top(top)
+	, m_running(false)
+	{}
+	virtual ~stats_manager() {}
+
+	bool run(int argc, char *argv[]);
+	void stop(void);
+private:
+	bool get_stats(std::vector<char> &buf);
+	void show_stats(std::vector<char> &buf);
+	void usage(void);
+
+	bool m_top;
+	std::atomic<bool> m_running;
+};
@@ -114,3 +114,145 @@ TESTCASE(interval_test, 200ms_p)
 
 	return true;
 }
+
+static int fast_count;
+static int slow_count;
+
+static void fast_cb(sensor_t sensor, unsigned int event_type, sensor_data_t *data, void *user_data)
+{
+	/* 50 events at 20ms, about 1 second */
+	if (++fast_count >= 50)
+		mainloop::stop();
+}
+
+static void slow_cb(sensor_t sensor, unsigned int event_type, sensor_data_t *data, void *user_data)
+{
+	++slow_count;
+}
+
+static bool run_decimation_test(int mode)
+{
+	int fast, slow;
+	bool ret;
+	sensor_t sensor;
+
+	int err = sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor);
+	ASSERT_EQ(err, 0);
+
+	fast = sensord_connect(sensor);
+	slow = sensord_connect(sensor);
+	ASSERT_GE(fast, 0);
+	ASSERT_GE(slow, 0);
+
+	if (mode != SENSORD_DECIMATION_NONE) {
+		err = sensord_set_attribute_int(slow, SENSORD_ATTRIBUTE_DECIMATION_MODE, mode);
+		ASSERT_EQ(err, 0);
+	}
+
+	fast_count = 0;
+	slow_count = 0;
+
+	sensord_register_event(fast, 1, 20, 0, fast_cb, NULL);
+	sensord_register_event(slow, 1, 200, 0, slow_cb, NULL);
+	sensord_start(fast, SENSOR_OPTION_ALWAYS_ON);
+	sensord_start(slow, SENSOR_OPTION_ALWAYS_ON);
+
+	mainloop::run();
+
+	sensord_stop(slow);
+	sensord_stop(fast);
+	sensord_unregister_event(slow, 1);
+	sensord_unregister_event(fast, 1);
+
+	ret = sensord_disconnect(slow);
+	EXPECT_TRUE(ret);
+	ret = sensord_disconnect(fast);
+	EXPECT_TRUE(ret);
+
+	_I("fast listener: %d events, slow listener: %d events\n", fast_count, slow_count);
+
+	/* without decimation the 200ms listener gets the shared 20ms rate */
+	if (mode == SENSORD_DECIMATION_NONE) {
+		ASSERT_GE(slow_count, 40);
+		return true;
+	}
+
+	/* decimated, it gets ~5 events */
+	ASSERT_LE(slow_count, 7);
+
+	return true;
+}
+
+TESTCASE(interval_test, decimation_none_by_default_p)
+{
+	return run_decimation_test(SENSORD_DECIMATION_NONE);
+}
+
+TESTCASE(interval_test, decimation_drop_p)
+{
+	return run_decimation_test(SENSORD_DECIMATION_DROP);
+}
+
+TESTCASE(interval_test, decimation_average_p)
+{
+	return run_decimation_test(SENSORD_DECIMATION_AVERAGE);
+}
+
+static int delivered_count;
+
+static void delivered_cb(sensor_t sensor, unsigned int event_type, sensor_data_t *data, void *user_data)
+{
+	++delivered_count;
+}
+
+TESTCASE(interval_test, delivery_heartbeat_p)
+{
+	int fast, delta;
+	bool ret;
+	sensor_t sensor;
+	/* no accelerometer moves this far, only the heartbeat lets samples out */
+	sensord_delta_threshold_s threshold = {1000.0f, 0};
+
+	int err = sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor);
+	ASSERT_EQ(err, 0);
+
+	fast = sensord_connect(sensor);
+	delta = sensord_connect(sensor);
+	ASSERT_GE(fast, 0);
+	ASSERT_GE(delta, 0);
+
+	err = sensord_set_attribute_str(delta, SENSORD_ATTRIBUTE_DELTA_THRESHOLD,
+			(const char *)&threshold, sizeof(threshold));
+	ASSERT_EQ(err, 0);
+	err = sensord_set_attribute_int(delta, SENSORD_ATTRIBUTE_HEARTBEAT, 200);
+	ASSERT_EQ(err, 0);
+	err = sensord_set_attribute_int(delta, SENSORD_ATTRIBUTE_DELIVERY_MODE, SENSORD_DELIVERY_DELTA);
+	ASSERT_EQ(err, 0);
+
+	fast_count = 0;
+	delivered_count = 0;
+
+	sensord_register_event(fast, 1, 20, 0, fast_cb, NULL);
+	sensord_register_event(delta, 1, 20, 0, delivered_cb, NULL);
+	sensord_start(fast, SENSOR_OPTION_ALWAYS_ON);
+	sensord_start(delta, SENSOR_OPTION_ALWAYS_ON);
+
+	mainloop::run();
+
+	sensord_stop(delta);
+	sensord_stop(fast);
+	sensord_unregister_event(delta, 1);
+	sensord_unregister_event(fast, 1);
+
+	ret = sensord_disconnect(delta);
+	EXPECT_TRUE(ret);
+	ret = sensord_disconnect(fast);
+	EXPECT_TRUE(ret);
+
+	/* the first sample and one every 200ms of the ~1 second run */
+	_I("fast listener: %d events, delta listener: %d events\n", fast_count, delivered_count);
+	ASSERT_GE(delivered_count, 1);
+	ASSERT_LE(delivered_count, 7);
+
+	return true;
+}
@@ -24,6 +24,8 @@
 
 #include <client/sensor_manager.h>
 #include <client/sensor_listener.h>
+#include <ipc_client.h>
+#include <command_types.h>
 
 #include "log.h"
 #include "mainloop.h"
@@ -572,6 +574,77 @@ TESTCASE(sensor_listener, get_data_list)
 	return true;
 }
 
+static int passive_count = 0;
+
+static void passive_cb(sensor_t sensor, unsigned int event_type, sensor_data_t *data, void *user_data)
+{
+	++passive_count;
+}
+
+static void active_cb(sensor_t sensor, unsigned int event_type, sensor_data_t *data, void *user_data)
+{
+}
+
+static gboolean stop_mainloop(gpointer gdata)
+{
+	mainloop::stop();
+	return FALSE;
+}
+
+TESTCASE(sensor_listener, passive_mode_p_1)
+{
+	int err;
+	bool ret;
+	int passive, active;
+	sensor_t sensor;
+
+	err = sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor);
+	ASSERT_EQ(err, 0);
+
+	passive = sensord_connect(sensor);
+	ASSERT_GE(passive, 0);
+
+	ret = sensord_set_passive_mode(passive, true);
+	ASSERT_TRUE(ret);
+
+	ret = sensord_register_event(passive, 1, 100, 0, passive_cb, NULL);
+	ASSERT_TRUE(ret);
+
+	ret = sensord_start(passive, SENSOR_OPTION_ALWAYS_ON);
+	ASSERT_TRUE(ret);
+
+	/* nobody drives the sensor, so the passive listener gets nothing */
+	passive_count = 0;
+	g_timeout_add_seconds(1, stop_mainloop, NULL);
+	mainloop::run();
+	EXPECT_EQ(passive_count, 0);
+
+	active = sensord_connect(sensor);
+	ASSERT_GE(active, 0);
+
+	ret = sensord_register_event(active, 1, 100, 0, active_cb, NULL);
+	ASSERT_TRUE(ret);
+
+	ret = sensord_start(active, SENSOR_OPTION_ALWAYS_ON);
+	ASSERT_TRUE(ret);
+
+	g_timeout_add_seconds(1, stop_mainloop, NULL);
+	mainloop::run();
+	EXPECT_GT(passive_count, 0);
+
+	sensord_stop(active);
+	sensord_unregister_event(active, 1);
+	ret = sensord_disconnect(active);
+	EXPECT_TRUE(ret);
+
+	sensord_stop(passive);
+	sensord_unregister_event(passive, 1);
+	ret = sensord_disconnect(passive);
+	ASSERT_TRUE(ret);
+
+	return true;
+}
+
 void sensor_attribute_int_changed_callback(sensor_t sensor, int attribute, int value, void *data)
 {
 	_I("[ATTRIBUTE INT CHANGED] attribute : %d, value : %d\n", attribute, value);
@@ -801,3 +874,115 @@ TESTCASE(skip_sensor_listener, light_sensor_get_attribute_int_1)
 
 	return true;
 }
+
+class stats_handler : public ipc::channel_handler
+{
+public:
+	void connected(ipc::channel *ch) {}
+	void disconnected(ipc::channel *ch) {}
+	void read(ipc::channel *ch, ipc::message &msg) {}
+	void read_complete(ipc::channel *ch) {}
+	void error_caught(ipc::channel *ch, int error) {}
+};
+
+TESTCASE(sensor_listener, get_stats_p_1)
+{
+	int err, handle;
+	bool ret;
+	sensor_t sensor;
+
+	err = sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor);
+	ASSERT_EQ(err, 0);
+
+	handle = sensord_connect(sensor);
+	ASSERT_GE(handle, 0);
+
+	ret = sensord_register_event(handle, 1, 100, 0, active_cb, NULL);
+	ASSERT_TRUE(ret);
+
+	ret = sensord_start(handle, SENSOR_OPTION_ALWAYS_ON);
+	ASSERT_TRUE(ret);
+
+	g_timeout_add_seconds(1, stop_mainloop, NULL);
+	mainloop::run();
+
+	ipc::ipc_client client(SENSOR_CHANNEL_PATH);
+	stats_handler handler;
+
+	ipc::channel *ch = client.connect(&handler, NULL);
+	ASSERT_NE(ch, 0);
+
+	ipc::message msg;
+	ipc::message reply;
+	msg.set_type(CMD_GET_STATS);
+
+	ASSERT_TRUE(ch->send_sync(msg));
+	ASSERT_TRUE(ch->read_sync(reply));
+	ch->disconnect();
+	delete ch;
+
+	ASSERT_EQ(reply.header()->err, 0);
+	ASSERT_GE(reply.size(), sizeof(cmd_get_stats_t));
+
+	cmd_get_stats_t *stats = reinterpret_cast<cmd_get_stats_t *>(reply.body());
+	EXPECT_GT(stats->sensor_cnt, 0);
+	EXPECT_GT(stats->listener_cnt, 0);
+
+	/* the accelerometer is running, so it has been read and delivered */
+	cmd_latency_stats_t *latencies = reinterpret_cast<cmd_latency_stats_t *>(stats->data);
+	cmd_sensor_stats_t *sensors = reinterpret_cast<cmd_sensor_stats_t *>(latencies + stats->latency_cnt);
+	bool delivered = false;
+
+	for (int i = 0; i < stats->sensor_cnt; ++i) {
+		if (sensors[i].events_notified > 0 && sensors[i].observer_count > 0)
+			delivered = true;
+	}
+	EXPECT_TRUE(delivered);
+
+	sensord_stop(handle);
+	sensord_unregister_event(handle, 1);
+	ret = sensord_disconnect(handle);
+	ASSERT_TRUE(ret);
+
+	return true;
+}
+
+TESTCASE(sensor_listener, get_latency_p_1)
+{
+	int err, handle;
+	bool ret;
+	sensor_t sensor;
+	sensord_latency_t latency;
+
+	err = sensord_get_default_sensor(ACCELEROMETER_SENSOR, &sensor);
+	ASSERT_EQ(err, 0);
+
+	handle = sensord_connect(sensor);
+	ASSERT_GE(handle, 0);
+
+	ret = sensord_register_event(handle, 1, 100, 0, active_cb, NULL);
+	ASSERT_TRUE(ret);
+
+	ret = sensord_start(handle, SENSOR_OPTION_ALWAYS_ON);
+	ASSERT_TRUE(ret);
+
+	g_timeout_add_seconds(1, stop_mainloop, NULL);
+	mainloop::run();
+
+	err = sensord_get_latency(SENSORD_LATENCY_END_TO_END, &latency);
+	ASSERT_EQ(err, 0);
+	EXPECT_GT(latency.count, 0);
+	EXPECT_LE(latency.p50, latency.p99);
+	EXPECT_LE(latency.p99, latency.p999);
+	EXPECT_LE(latency.p999, latency.max);
+
+	err = sensord_get_latency(SENSORD_LATENCY_STAGE_MAX, &latency);
+	EXPECT_EQ(err, -EINVAL);
+
+	sensord_stop(handle);
+	sensord_unregister_event(handle, 1);
+	ret = sensord_disconnect(handle);
+	ASSERT_TRUE(ret);
+
+	return true;
+}
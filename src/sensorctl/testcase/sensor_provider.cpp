@@ -435,6 +435,47 @@ TESTCASE(skip_sensor_provider, mysensor_batch_events_once)
 	return true;
 }
 
+#define NUMBER_OF_LARGE_BATCH 1000
+
+/* larger than a single frame, so it is split and sent without blocking */
+TESTCASE(skip_sensor_provider, mysensor_batch_events_large)
+{
+	int err = 0;
+	sensord_provider_h provider;
+
+	err = sensord_create_provider(MYSENSOR_BATCH_URI, &provider);
+	ASSERT_EQ(err, 0);
+
+	err = sensord_provider_set_name(provider, MYSENSOR_BATCH_NAME);
+	ASSERT_EQ(err, 0);
+	err = sensord_provider_set_vendor(provider, MYSENSOR_VENDOR);
+	ASSERT_EQ(err, 0);
+
+	err = sensord_add_provider(provider);
+	ASSERT_EQ(err, 0);
+
+	static sensor_data_t data[NUMBER_OF_LARGE_BATCH];
+	for (int i = 0 ; i < NUMBER_OF_LARGE_BATCH; i++) {
+		data[i].accuracy = 3;
+		data[i].timestamp = sensor::utils::get_timestamp();
+		data[i].value_count = 1;
+		data[i].values[0] = i;
+	}
+
+	err = sensord_provider_publish_events(provider, data, 0);
+	ASSERT_EQ(err, -EINVAL);
+
+	err = sensord_provider_publish_events(provider, data, NUMBER_OF_LARGE_BATCH);
+	ASSERT_EQ(err, 0);
+
+	err = sensord_remove_provider(provider);
+	ASSERT_EQ(err, 0);
+	err = sensord_destroy_provider(provider);
+	ASSERT_EQ(err, 0);
+
+	return true;
+}
+
 TESTCASE(skip_sensor_provider, mysensor_batch_p_without_publish)
 {
 	int err = 0;
@@ -0,0 +1,154 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <sensor_internal.h>
+
+#include "shared/window_aggregator.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+#define SAMPLES 5000
+#define PERIOD 10000		/* us */
+#define WINDOW 1000000		/* us */
+
+static std::vector<sensor_data_t> make_samples(float offset, float scale)
+{
+	std::vector<sensor_data_t> samples(SAMPLES);
+	unsigned long long timestamp = 1000000;
+
+	srand(0);
+	for (int i = 0; i < SAMPLES; ++i) {
+		sensor_data_t &data = samples[i];
+
+		memset(&data, 0, sizeof(data));
+		/* jittered, with a gap of a few windows in the middle */
+		timestamp += PERIOD + rand() % 2000 - 1000;
+		if (i == SAMPLES / 2)
+			timestamp += 3 * WINDOW;
+
+		data.timestamp = timestamp;
+		data.value_count = 3;
+		for (int j = 0; j < 3; ++j)
+			data.values[j] = offset + scale * ((float)rand() / RAND_MAX * 2 - 1);
+	}
+
+	return samples;
+}
+
+/* the aggregate of the samples in [end - window, end), taken directly */
+static double reference(const std::vector<sensor_data_t> &samples, int function,
+		unsigned long long end, int axis, int &count)
+{
+	double sum = 0, sum_sq = 0;
+	double min = INFINITY, max = -INFINITY;
+
+	count = 0;
+	for (auto it = samples.begin(); it != samples.end(); ++it) {
+		if (it->timestamp < end - WINDOW || it->timestamp >= end)
+			continue;
+
+		double value = it->values[axis];
+		sum += value;
+		sum_sq += value * value;
+		min = std::min(min, value);
+		max = std::max(max, value);
+		count++;
+	}
+
+	double mean = sum / count;
+
+	switch (function) {
+	case SENSORD_AGGREGATION_MIN: return min;
+	case SENSORD_AGGREGATION_MAX: return max;
+	case SENSORD_AGGREGATION_MEAN: return mean;
+	case SENSORD_AGGREGATION_VARIANCE: return sum_sq / count - mean * mean;
+	case SENSORD_AGGREGATION_RMS: return sqrt(sum_sq / count);
+	default: return count;
+	}
+}
+
+static bool check_windows(unsigned long long hop, float offset, float scale, double tolerance)
+{
+	std::vector<sensor_data_t> samples = make_samples(offset, scale);
+
+	for (int function = SENSORD_AGGREGATION_MIN; function <= SENSORD_AGGREGATION_COUNT; ++function) {
+		window_aggregator aggregator;
+		sensor_data_t out;
+		int records = 0;
+
+		aggregator.set_window(function, WINDOW, hop);
+
+		for (auto it = samples.begin(); it != samples.end(); ++it) {
+			if (!aggregator.push(*it, out))
+				continue;
+
+			records++;
+			for (int axis = 0; axis < out.value_count; ++axis) {
+				int count;
+				double expected = reference(samples, function, out.timestamp, axis, count);
+
+				ASSERT_GT(count, 0);
+				ASSERT_NEAR(out.values[axis], expected, tolerance * (fabs(expected) + 1));
+			}
+		}
+
+		/* every window, or every hop, of the 50s less the gap */
+		_I("function %d, hop %llu: %d records\n", function, hop, records);
+		ASSERT_GT(records, 0);
+	}
+
+	return true;
+}
+
+TESTCASE(aggregator, tumbling_p)
+{
+	return check_windows(0, 0, 10, 1e-5);
+}
+
+TESTCASE(aggregator, sliding_p)
+{
+	return check_windows(WINDOW / 4, 0, 10, 1e-5);
+}
+
+TESTCASE(aggregator, variance_offset_p)
+{
+	/* e.g. a barometer: small changes on a large value */
+	window_aggregator aggregator;
+	std::vector<sensor_data_t> samples = make_samples(100000, 0.5);
+	sensor_data_t out;
+
+	aggregator.set_window(SENSORD_AGGREGATION_VARIANCE, WINDOW, WINDOW / 4);
+
+	for (auto it = samples.begin(); it != samples.end(); ++it) {
+		if (!aggregator.push(*it, out))
+			continue;
+
+		/* uniform in [-0.5, 0.5] has a variance of 1/12, within float steps */
+		ASSERT_NEAR(out.values[0], 1.0 / 12, 0.03);
+	}
+
+	return true;
+}
@@ -0,0 +1,208 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+#include <vector>
+#include <sensor_internal.h>
+
+#include "shared/delivery_filter.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+#define PERIOD 10000		/* us */
+
+static sensor_data_t make_sample(int index, float x, float y, float z)
+{
+	sensor_data_t data;
+
+	memset(&data, 0, sizeof(data));
+	data.timestamp = 1000000 + (unsigned long long)index * PERIOD;
+	data.value_count = 3;
+	data.values[0] = x;
+	data.values[1] = y;
+	data.values[2] = z;
+
+	return data;
+}
+
+/* the indices of the samples filter lets through */
+static std::vector<int> run_filter(delivery_filter &filter, const std::vector<sensor_data_t> &samples)
+{
+	std::vector<int> delivered;
+
+	for (size_t i = 0; i < samples.size(); ++i) {
+		if (filter.push(samples[i]))
+			delivered.push_back(i);
+	}
+
+	return delivered;
+}
+
+static bool check_delivered(const std::vector<int> &delivered, const std::vector<int> &expected)
+{
+	ASSERT_EQ(delivered.size(), expected.size());
+
+	for (size_t i = 0; i < expected.size(); ++i)
+		ASSERT_EQ(delivered[i], expected[i]);
+
+	return true;
+}
+
+TESTCASE(delivery_filter, all_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+
+	for (int i = 0; i < 10; ++i)
+		samples.push_back(make_sample(i, 1, 2, 3));
+
+	ASSERT_EQ(run_filter(filter, samples).size(), samples.size());
+
+	return true;
+}
+
+TESTCASE(delivery_filter, on_change_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+
+	filter.set_mode(SENSORD_DELIVERY_ON_CHANGE);
+
+	samples.push_back(make_sample(0, 1, 2, 3));	/* the first one */
+	samples.push_back(make_sample(1, 1, 2, 3));
+	samples.push_back(make_sample(2, 1, 2, 3.5f));	/* z changed */
+	samples.push_back(make_sample(3, 1, 2, 3.5f));
+	samples.push_back(make_sample(4, 1, 2, 3.5f));
+	samples.push_back(make_sample(5, 0.999f, 2, 3.5f));	/* x changed, a bit */
+	samples.push_back(make_sample(6, 0.999f, 2, 3.5f));
+	samples.push_back(make_sample(7, 0.999f, 2, 3.5f));	/* fewer values */
+	samples[7].value_count = 2;
+
+	return check_delivered(run_filter(filter, samples), {0, 2, 5, 7});
+}
+
+TESTCASE(delivery_filter, delta_absolute_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+	/* the last threshold also applies to z */
+	const sensord_delta_threshold_s thresholds[] = {{1.0f, 0}, {0.25f, 0}};
+
+	filter.set_mode(SENSORD_DELIVERY_DELTA);
+	filter.set_thresholds(thresholds, 2);
+
+	/* x creeps by 0.25: it is compared with the last one delivered,
+	 * not with the one before, so every fourth step goes out */
+	for (int i = 0; i <= 8; ++i)
+		samples.push_back(make_sample(i, i * 0.25f, 0, 0));
+
+	samples.push_back(make_sample(9, 2, 0.125f, 0));	/* below y's */
+	samples.push_back(make_sample(10, 2, 0.125f, -0.25f));	/* z, by y's */
+	samples.push_back(make_sample(11, 2, 0.375f, -0.25f));	/* y, since 10 */
+
+	return check_delivered(run_filter(filter, samples), {0, 4, 8, 10, 11});
+}
+
+TESTCASE(delivery_filter, delta_relative_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+	/* 10% of the last value delivered, e.g. a light sensor */
+	const sensord_delta_threshold_s threshold = {0, 0.1f};
+
+	filter.set_mode(SENSORD_DELIVERY_DELTA);
+	filter.set_thresholds(&threshold, 1);
+
+	samples.push_back(make_sample(0, 100, 0, 0));
+	samples.push_back(make_sample(1, 109, 0, 0));
+	samples.push_back(make_sample(2, 111, 0, 0));	/* +11% */
+	samples.push_back(make_sample(3, 100, 0, 0));	/* -9.9% of 111 */
+	samples.push_back(make_sample(4, 98, 0, 0));	/* -11.7% of 111 */
+	samples.push_back(make_sample(5, 98, 0, 0));
+
+	return check_delivered(run_filter(filter, samples), {0, 2, 4});
+}
+
+TESTCASE(delivery_filter, delta_without_threshold_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+
+	/* no threshold set, any change counts */
+	filter.set_mode(SENSORD_DELIVERY_DELTA);
+
+	samples.push_back(make_sample(0, 1, 1, 1));
+	samples.push_back(make_sample(1, 1, 1, 1));
+	samples.push_back(make_sample(2, 1, 1, 1.001f));
+
+	return check_delivered(run_filter(filter, samples), {0, 2});
+}
+
+TESTCASE(delivery_filter, heartbeat_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+	std::vector<int> expected;
+
+	filter.set_mode(SENSORD_DELIVERY_ON_CHANGE);
+	filter.set_heartbeat(20 * PERIOD);
+
+	/* a still sensor, let through once every 20 samples */
+	for (int i = 0; i < 100; ++i)
+		samples.push_back(make_sample(i, 1, 2, 3));
+
+	/* a change restarts the heartbeat */
+	samples[30].values[0] = 2;
+	for (int i = 31; i < 100; ++i)
+		samples[i].values[0] = 2;
+
+	expected = {0, 20, 30, 50, 70, 90};
+
+	return check_delivered(run_filter(filter, samples), expected);
+}
+
+TESTCASE(delivery_filter, restart_p)
+{
+	delivery_filter filter;
+	std::vector<sensor_data_t> samples;
+
+	filter.set_mode(SENSORD_DELIVERY_ON_CHANGE);
+
+	samples.push_back(make_sample(10, 1, 2, 3));
+	samples.push_back(make_sample(11, 1, 2, 3));
+	/* the timestamps went back, the sensor was restarted */
+	samples.push_back(make_sample(0, 1, 2, 3));
+	samples.push_back(make_sample(1, 1, 2, 3));
+
+	ASSERT_TRUE(check_delivered(run_filter(filter, samples), {0, 2}));
+
+	/* the current value goes out first after a reset or a new mode */
+	filter.reset();
+	ASSERT_TRUE(filter.push(samples[3]));
+	ASSERT_FALSE(filter.push(samples[3]));
+
+	filter.set_mode(SENSORD_DELIVERY_DELTA);
+	ASSERT_TRUE(filter.push(samples[3]));
+	ASSERT_FALSE(filter.push(samples[3]));
+
+	return true;
+}
@@ -0,0 +1,206 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sensor_internal.h>
+
+#include "shared/fast_math.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+#define SAMPLES 1000000
+#define BENCH_ROUNDS 20
+
+static unsigned long long get_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* keeps the compiler from dropping the benchmarked loops */
+static volatile float sink;
+
+TESTCASE(fast_math, atan2_error_p)
+{
+	double max_error = 0;
+
+	/* every direction, at small, unit and large radius */
+	for (int i = 0; i <= SAMPLES; ++i) {
+		double a = -M_PI + 2 * M_PI * i / SAMPLES;
+
+		for (double r = 1e-3; r <= 1e3; r *= 1e3) {
+			float x = r * cos(a);
+			float y = r * sin(a);
+			double error = fabs(fast_math::atan2f(y, x) - atan2((double)y, (double)x));
+
+			/* -pi and pi are the same angle */
+			if (error > M_PI)
+				error = fabs(error - 2 * M_PI);
+			if (error > max_error)
+				max_error = error;
+		}
+	}
+
+	_I("atan2: max error %g rad\n", max_error);
+	ASSERT_LE(max_error, FAST_ATAN2_MAX_ERROR);
+
+	EXPECT_EQ(fast_math::atan2f(0, 0), 0);
+	EXPECT_NEAR(fast_math::atan2f(1, 0), M_PI_2, FAST_ATAN2_MAX_ERROR);
+	EXPECT_NEAR(fast_math::atan2f(-1, 0), -M_PI_2, FAST_ATAN2_MAX_ERROR);
+
+	return true;
+}
+
+TESTCASE(fast_math, asin_error_p)
+{
+	double max_error = 0;
+
+	for (int i = 0; i <= SAMPLES; ++i) {
+		float x = -1 + 2.0 * i / SAMPLES;
+		double error = fabs(fast_math::asinf(x) - asin((double)x));
+
+		if (error > max_error)
+			max_error = error;
+		error = fabs(fast_math::acosf(x) - acos((double)x));
+		if (error > max_error)
+			max_error = error;
+	}
+
+	_I("asin/acos: max error %g rad\n", max_error);
+	ASSERT_LE(max_error, FAST_ASIN_MAX_ERROR);
+
+	/* out of range inputs, e.g. rounding on a normalized vector, saturate */
+	EXPECT_NEAR(fast_math::asinf(1.0001f), M_PI_2, FAST_ASIN_MAX_ERROR);
+	EXPECT_NEAR(fast_math::asinf(-1.0001f), -M_PI_2, FAST_ASIN_MAX_ERROR);
+
+	return true;
+}
+
+TESTCASE(fast_math, rsqrt_error_p)
+{
+	double max_error = 0;
+
+	/* the whole mantissa over 2^-40 .. 2^40 */
+	for (int e = -40; e < 40; ++e) {
+		for (int i = 0; i < 1000; ++i) {
+			float x = ldexp(1 + i / 1000.0, e);
+			double error = fabs(fast_math::rsqrtf(x) * sqrt((double)x) - 1);
+
+			if (error > max_error)
+				max_error = error;
+		}
+	}
+
+	_I("rsqrt: max relative error %g\n", max_error);
+	ASSERT_LE(max_error, FAST_RSQRT_MAX_ERROR);
+
+	return true;
+}
+
+TESTCASE(fast_math, quat_to_euler_p)
+{
+	const int count = 1000;
+	const int stride = sizeof(sensor_data_t) / sizeof(float);
+	/* error bound in degrees, a unit quaternion only scales the inputs */
+	const double bound = 2 * FAST_ATAN2_MAX_ERROR * 180 / M_PI + 1e-3;
+	sensor_data_t data[count];
+	float euler[count * 3];
+	float R[count * 9];
+
+	srand(0);
+	for (int i = 0; i < count; ++i) {
+		float *q = data[i].values;
+		float norm = 0;
+
+		for (int j = 0; j < 4; ++j) {
+			q[j] = (float)rand() / RAND_MAX * 2 - 1;
+			norm += q[j] * q[j];
+		}
+		for (int j = 0; j < 4; ++j)
+			q[j] /= sqrtf(norm);
+	}
+
+	fast_math::quat_to_matrix(data[0].values, stride, R, count);
+	fast_math::quat_to_euler(data[0].values, stride, euler, count);
+
+	for (int i = 0; i < count; ++i) {
+		const float *r = &R[i * 9];
+		double azimuth = atan2(-r[3], r[0]) * 180 / M_PI;
+		double pitch = atan2(-r[7], r[8]) * 180 / M_PI;
+		double roll = asin(r[6]) * 180 / M_PI;
+
+		if (azimuth < 0)
+			azimuth += 360;
+
+		/* azimuth wraps around at 0 and 360 */
+		double error = fabs(euler[i * 3] - azimuth);
+		if (error > 180)
+			error = fabs(error - 360);
+
+		ASSERT_LE(error, bound);
+		ASSERT_NEAR(euler[i * 3 + 1], pitch, bound);
+		ASSERT_NEAR(euler[i * 3 + 2], roll, bound);
+	}
+
+	return true;
+}
+
+/* Only reports the speed against the float libm functions, a wall-clock
+ * time depends too much on the machine and its load to be asserted */
+TESTCASE(fast_math, speedup_p)
+{
+	static float x[SAMPLES];
+	static float y[SAMPLES];
+	unsigned long long start, libm, fast;
+	float sum;
+
+	for (int i = 0; i < SAMPLES; ++i) {
+		x[i] = cosf(i * 0.0013f);
+		y[i] = sinf(i * 0.001f);
+	}
+
+	sum = 0;
+	start = get_ns();
+	for (int r = 0; r < BENCH_ROUNDS; ++r)
+		for (int i = 0; i < SAMPLES; ++i)
+			sum += atan2f(y[i], x[i]) + asinf(y[i]) + 1.0f / sqrtf(x[i] + 2);
+	libm = get_ns() - start;
+	sink = sum;
+
+	sum = 0;
+	start = get_ns();
+	for (int r = 0; r < BENCH_ROUNDS; ++r)
+		for (int i = 0; i < SAMPLES; ++i)
+			sum += fast_math::atan2f(y[i], x[i]) + fast_math::asinf(y[i]) +
+				fast_math::rsqrtf(x[i] + 2);
+	fast = get_ns() - start;
+	sink = sum;
+
+	_I("libm: %.2f ns, fast_math: %.2f ns per atan2 + asin + rsqrt, %.2fx\n",
+		(double)libm / SAMPLES / BENCH_ROUNDS, (double)fast / SAMPLES / BENCH_ROUNDS,
+		(double)libm / fast);
+
+	return true;
+}
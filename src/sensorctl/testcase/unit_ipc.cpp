@@ -19,6 +19,8 @@
 
 #include <unistd.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <sensor_internal.h>
 
 #include "shared/channel.h"
@@ -354,6 +356,87 @@ static bool run_ipc_client(const char *str, int size, int count)
 	return true;
 }
 
+/* IPC Server of a newer peer, whose trailer is longer than ours */
+static bool run_raw_server_long_trailer(const char *str, int size, int count)
+{
+	struct sockaddr_un addr;
+	char trailer[sizeof(message_trailer) + 40];
+	message_trailer stamps;
+	message_header header;
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	RETV_IF(fd < 0, false);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, TEST_PATH, sizeof(addr.sun_path) - 1);
+	unlink(TEST_PATH);
+
+	RETV_IF(::bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0, false);
+	RETV_IF(::listen(fd, 1) < 0, false);
+
+	int client = ::accept(fd, NULL, NULL);
+	RETV_IF(client < 0, false);
+
+	stamps.read = 1;
+	stamps.notify = 2;
+	stamps.write = 3;
+	memset(trailer, 0xff, sizeof(trailer));
+	memcpy(trailer, &stamps, sizeof(stamps));
+
+	header.type = 1;
+	header.length = 4;
+	header.trailer = sizeof(trailer);
+	::write(client, &header, sizeof(header));
+	::write(client, "LONG", 4);
+	::write(client, trailer, sizeof(trailer));
+
+	header.type = 2;
+	header.trailer = 0;
+	::write(client, &header, sizeof(header));
+	::write(client, "NEXT", 4);
+
+	SLEEP_1S;
+
+	close(client);
+	close(fd);
+	unlink(TEST_PATH);
+
+	return true;
+}
+
+/* IPC Client which reads past the unknown part of a trailer */
+static bool run_ipc_client_long_trailer(const char *str, int size, int count)
+{
+	ipc_client client(TEST_PATH);
+	test_client_handler client_handler;
+
+	channel *ch = client.connect(&client_handler, NULL);
+	ASSERT_NE(ch, 0);
+
+	message first;
+	message second;
+
+	ASSERT_TRUE(ch->read_sync(first));
+	ASSERT_TRUE(ch->read_sync(second));
+
+	ch->disconnect();
+	delete ch;
+
+	ASSERT_EQ(first.type(), 1);
+	ASSERT_EQ(strncmp(first.body(), "LONG", 4), 0);
+	ASSERT_EQ(first.trailer()->read, 1);
+	ASSERT_EQ(first.trailer()->notify, 2);
+	ASSERT_EQ(first.trailer()->write, 3);
+
+	/* the stream is still in step */
+	ASSERT_EQ(second.type(), 2);
+	ASSERT_EQ(second.size(), 4);
+	ASSERT_EQ(strncmp(second.body(), "NEXT", 4), 0);
+
+	return true;
+}
+
 /**
  * @brief   Test 3 client + 1 client which sleeps 1 seconds
  */
@@ -523,3 +606,23 @@ TESTCASE(sensor_ipc, server_client_basic_p)
 
 	return true;
 }
+
+/**
+ * @brief   Test a trailer longer than message_trailer
+ * @details the known stamps are kept, the rest is skipped and
+ *          the next message is read from where it starts
+ */
+TESTCASE(sensor_ipc, long_trailer_p)
+{
+	pid_t pid = run_process(run_raw_server_long_trailer, NULL, 0, 0);
+	EXPECT_GE(pid, 0);
+
+	SLEEP_1S;
+
+	bool ret = run_ipc_client_long_trailer(NULL, 0, 0);
+	ASSERT_TRUE(ret);
+
+	SLEEP_1S;
+
+	return true;
+}
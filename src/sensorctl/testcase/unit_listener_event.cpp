@@ -0,0 +1,233 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <unistd.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <vector>
+#include <sensor_internal.h>
+
+#include "shared/channel.h"
+#include "shared/channel_handler.h"
+#include "shared/command_types.h"
+#include "shared/delivery_filter.h"
+#include "shared/ipc_client.h"
+#include "shared/ipc_server.h"
+#include "shared/sensor_utils.h"
+#include "shared/window_aggregator.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace ipc;
+
+#define TEST_PATH "/run/.sensord_event_test.socket"
+#define SLEEP_1S sleep(1)
+
+#define BATCH_COUNT 32
+#define READ_TIMESTAMP 1000000ULL
+#define NOTIFY_TIMESTAMP 1002000ULL
+
+typedef std::vector<sensor_data_t> (*event_func_t)(void);
+
+/* a batch as the HAL hands it to the sensor handler */
+static std::vector<sensor_data_t> make_batch(void)
+{
+	std::vector<sensor_data_t> batch(BATCH_COUNT);
+
+	for (int i = 0; i < BATCH_COUNT; ++i) {
+		memset(&batch[i], 0, sizeof(sensor_data_t));
+		batch[i].accuracy = SENSOR_ACCURACY_GOOD;
+		batch[i].timestamp = READ_TIMESTAMP + i * 10000;
+		batch[i].value_count = 3;
+		for (int j = 0; j < 3; ++j)
+			batch[i].values[j] = i * 0.5f + j;
+	}
+
+	return batch;
+}
+
+/* what is left of the batch after a delta delivery filter, every third sample */
+static std::vector<sensor_data_t> make_trimmed_batch(void)
+{
+	std::vector<sensor_data_t> batch = make_batch();
+	std::vector<sensor_data_t> kept;
+	sensor::delivery_filter filter;
+	const sensord_delta_threshold_s threshold = {1.4f, 0};
+
+	filter.set_mode(SENSORD_DELIVERY_DELTA);
+	filter.set_thresholds(&threshold, 1);
+
+	for (auto it = batch.begin(); it != batch.end(); ++it) {
+		if (filter.push(*it))
+			kept.push_back(*it);
+	}
+
+	return kept;
+}
+
+/* the records of a 100ms tumbling mean over the batch, as aggregate() keeps them */
+static std::vector<sensor_data_t> make_aggregated_batch(void)
+{
+	std::vector<sensor_data_t> batch = make_batch();
+	std::vector<sensor_data_t> records;
+	sensor::window_aggregator aggregator;
+	sensor_data_t record;
+
+	aggregator.set_window(SENSORD_AGGREGATION_MEAN, 100000, 0);
+
+	for (auto it = batch.begin(); it != batch.end(); ++it) {
+		if (aggregator.push(*it, record))
+			records.push_back(record);
+	}
+
+	return records;
+}
+
+/* frames the samples of func as the listener proxy does on any request */
+class test_event_server_handler : public channel_handler
+{
+public:
+	test_event_server_handler(event_func_t func)
+	: m_func(func)
+	{
+	}
+
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+	void read(channel *ch, message &msg)
+	{
+		std::vector<sensor_data_t> batch = make_batch();
+		std::vector<sensor_data_t> samples = m_func();
+
+		auto src = message::create(batch.size() * sizeof(sensor_data_t));
+		RETM_IF(!src, "Failed to allocate memory");
+
+		src->enclose(batch.data(), batch.size() * sizeof(sensor_data_t));
+		src->trailer()->read = READ_TIMESTAMP;
+		src->trailer()->notify = NOTIFY_TIMESTAMP;
+
+		auto event = sensor::utils::create_event(samples.data(), samples.size(), *src);
+		RETM_IF(!event, "Failed to create event");
+
+		ch->send(event);
+	}
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+
+private:
+	event_func_t m_func;
+};
+
+static pid_t run_event_server(event_func_t func)
+{
+	pid_t pid = fork();
+	if (pid < 0)
+		return -1;
+
+	if (pid == 0) {
+		event_loop eloop;
+		ipc_server server(TEST_PATH);
+		test_event_server_handler handler(func);
+
+		server.set_option("max_connection", 10);
+		server.set_option(SO_TYPE, SOCK_STREAM);
+		server.bind(&handler, &eloop);
+
+		eloop.run(3000);
+		server.close();
+		exit(0);
+	}
+
+	return pid;
+}
+
+class test_event_client_handler : public channel_handler
+{
+public:
+	void connected(channel *ch) {}
+	void disconnected(channel *ch) {}
+	void read(channel *ch, message &msg) {}
+	void read_complete(channel *ch) {}
+	void error_caught(channel *ch, int error) {}
+};
+
+/* requests an event of the server and decodes it as the client library does */
+static bool check_event(event_func_t func)
+{
+	std::vector<sensor_data_t> expected = func();
+
+	pid_t pid = run_event_server(func);
+	ASSERT_GE(pid, 0);
+
+	SLEEP_1S;
+
+	ipc_client client(TEST_PATH);
+	test_event_client_handler client_handler;
+
+	channel *ch = client.connect(&client_handler, NULL);
+	ASSERT_NE(ch, 0);
+
+	message msg;
+	message reply;
+
+	msg.enclose("EVENT", 5);
+	ch->send_sync(msg);
+	ch->read_sync(reply);
+
+	ch->disconnect();
+	delete ch;
+
+	kill(pid, SIGTERM);
+	waitpid(pid, NULL, 0);
+
+	ASSERT_EQ(reply.type(), CMD_LISTENER_EVENT);
+	ASSERT_EQ(reply.header()->err, 0);
+	ASSERT_EQ(reply.size(), expected.size() * sizeof(sensor_data_t));
+	ASSERT_EQ(reply.trailer()->read, READ_TIMESTAMP);
+	ASSERT_EQ(reply.trailer()->notify, NOTIFY_TIMESTAMP);
+
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(reply.body());
+
+	for (size_t i = 0; i < expected.size(); ++i) {
+		ASSERT_EQ(data[i].timestamp, expected[i].timestamp);
+		ASSERT_EQ(memcmp(&data[i], &expected[i], sizeof(sensor_data_t)), 0);
+	}
+
+	_I("%zu samples decoded\n", expected.size());
+
+	return true;
+}
+
+TESTCASE(listener_event, trimmed_batch_p)
+{
+	/* the values move by 0.5 per sample */
+	ASSERT_EQ(make_trimmed_batch().size(), (BATCH_COUNT + 2) / 3);
+
+	return check_event(make_trimmed_batch);
+}
+
+TESTCASE(listener_event, aggregate_p)
+{
+	/* the 320ms batch closes three windows */
+	ASSERT_EQ(make_aggregated_batch().size(), 3);
+
+	return check_event(make_aggregated_batch);
+}
@@ -0,0 +1,159 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "fusion-sensor/rotation_vector/fusion_utils/mat_kernels.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace android;
+
+#define ROUNDS 1000
+
+typedef mat<mat33_t, 2, 2> cov_t;
+
+static float random_value(void)
+{
+	return (float)rand() / RAND_MAX * 2 - 1;
+}
+
+static mat33_t random_mat33(float scale)
+{
+	mat33_t m;
+
+	for (int c = 0; c < 3; ++c)
+		for (int r = 0; r < 3; ++r)
+			m[c][r] = scale * random_value();
+
+	return m;
+}
+
+/* A*At plus a small diagonal, like the covariance of a running filter */
+static cov_t random_covariance(float scale)
+{
+	cov_t A, P;
+
+	for (int c = 0; c < 2; ++c)
+		for (int r = 0; r < 2; ++r)
+			A[c][r] = random_mat33(scale);
+
+	P = A * transpose(A);
+	P[0][0] += mat33_t(scale * scale * 1e-3f);
+	P[1][1] += mat33_t(scale * scale * 1e-3f);
+	return P;
+}
+
+static double max_abs(const mat33_t &m)
+{
+	double max = 0;
+
+	for (int c = 0; c < 3; ++c)
+		for (int r = 0; r < 3; ++r)
+			max = std::max(max, (double)fabs(m[c][r]));
+
+	return max;
+}
+
+/* the error of the blocks, relative to the largest value of the expected ones */
+static double rel_error(const cov_t &P, const cov_t &expected)
+{
+	double error = 0, max = 0;
+
+	for (int c = 0; c < 2; ++c) {
+		for (int r = 0; r < 2; ++r) {
+			error = std::max(error, max_abs(P[c][r] - expected[c][r]));
+			max = std::max(max, max_abs(expected[c][r]));
+		}
+	}
+
+	return error / max;
+}
+
+/* the block predict of orientation_filter against P = Phi*P*Phit + GQGt,
+ * it follows the order of the dense sums so the goldens of the filter hold */
+TESTCASE(orientation_filter, predict_covariance_p)
+{
+	double max_error = 0;
+
+	srand(0);
+	for (int i = 0; i < ROUNDS; ++i) {
+		cov_t P(random_covariance(0.1f));
+		cov_t GQGt(random_covariance(1e-3f));
+		cov_t Phi;
+
+		Phi[0][0] = mat33_t(1) + random_mat33(0.05f);
+		Phi[1][0] = random_mat33(0.01f);
+		Phi[0][1] = mat33_t(0.0f);
+		Phi[1][1] = mat33_t(1);
+
+		const cov_t expected(Phi * P * transpose(Phi) + GQGt);
+
+		kernels::predict_covariance(P, Phi[0][0], Phi[1][0], GQGt);
+		max_error = std::max(max_error, rel_error(P, expected));
+	}
+
+	_I("predict_covariance: max relative error %g\n", max_error);
+	ASSERT_EQ(max_error, 0);
+
+	return true;
+}
+
+/* the block update of orientation_filter against the dense K and (I - K*H)*P, to the bit */
+TESTCASE(orientation_filter, update_covariance_p)
+{
+	double max_error = 0;
+
+	srand(0);
+	for (int i = 0; i < ROUNDS; ++i) {
+		cov_t P(random_covariance(0.1f));
+		const mat33_t L(random_mat33(1));
+		const mat33_t S(L * P[0][0] * transpose(L) + mat33_t(0.01f));
+
+		const mat33_t LtSi(transpose(L) * invert(S));
+		vec<mat33_t, 2> expected_K;
+		expected_K[0] = P[0][0] * LtSi;
+		expected_K[1] = transpose(P[1][0]) * LtSi;
+
+		cov_t expected(P);
+		expected[0][0] -= expected_K[0] * L * P[0][0];
+		expected[1][1] -= expected_K[1] * L * P[1][0];
+		expected[1][0] -= expected_K[0] * L * P[1][0];
+		expected[0][1] = transpose(expected[1][0]);
+
+		const vec<mat33_t, 2> K(kernels::update_covariance(P, L, S));
+		cov_t gain, expected_gain;
+
+		gain[0][0] = K[0];
+		gain[0][1] = K[1];
+		expected_gain[0][0] = expected_K[0];
+		expected_gain[0][1] = expected_K[1];
+		gain[1][0] = gain[1][1] = expected_gain[1][0] = expected_gain[1][1] = mat33_t(0.0f);
+
+		max_error = std::max(max_error, rel_error(gain, expected_gain));
+		max_error = std::max(max_error, rel_error(P, expected));
+	}
+
+	_I("update_covariance: max relative error %g\n", max_error);
+	ASSERT_EQ(max_error, 0);
+
+	return true;
+}
@@ -0,0 +1,92 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <sensor_internal.h>
+
+#include "shared/pause_state.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+TESTCASE(pause_state, power_save_state_p)
+{
+	pause_state pause(SENSORD_PAUSE_ON_DISPLAY_OFF);
+
+	/* nothing to pause before the listener is started */
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_NONE);
+	ASSERT_EQ(pause.set_power_save_state(0), PAUSE_ACTION_NONE);
+
+	pause.start();
+
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_POWERSAVE_MODE), PAUSE_ACTION_NONE);
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ALL), PAUSE_ACTION_STOP);
+	ASSERT_TRUE(pause.is_paused());
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_NONE);
+	ASSERT_EQ(pause.set_power_save_state(0), PAUSE_ACTION_RESUME);
+	ASSERT_FALSE(pause.is_paused());
+
+	/* stopped by the user while paused, nothing to resume */
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_STOP);
+	pause.stop();
+	ASSERT_FALSE(pause.is_paused());
+	ASSERT_EQ(pause.set_power_save_state(0), PAUSE_ACTION_NONE);
+
+	return true;
+}
+
+/* paused under one policy, resumed by switching to a policy that never
+ * pauses, which no change of the power save state would ever do */
+TESTCASE(pause_state, policy_none_resumes_p)
+{
+	static const int policies[] = {SENSORD_PAUSE_ALL, SENSORD_PAUSE_ON_DISPLAY_OFF};
+
+	for (int policy : policies) {
+		pause_state pause(policy);
+
+		pause.start();
+		ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_STOP);
+
+		ASSERT_EQ(pause.set_policy(SENSORD_PAUSE_NONE), PAUSE_ACTION_RESUME);
+		ASSERT_FALSE(pause.is_paused());
+
+		/* and is left alone from then on */
+		ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ALL), PAUSE_ACTION_NONE);
+		ASSERT_EQ(pause.set_power_save_state(0), PAUSE_ACTION_NONE);
+	}
+
+	return true;
+}
+
+TESTCASE(pause_state, policy_change_p)
+{
+	pause_state pause(SENSORD_PAUSE_NONE);
+
+	pause.start();
+	ASSERT_EQ(pause.set_power_save_state(SENSORD_PAUSE_ON_POWERSAVE_MODE), PAUSE_ACTION_NONE);
+
+	/* a policy covering the current state pauses right away */
+	ASSERT_EQ(pause.set_policy(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_NONE);
+	ASSERT_EQ(pause.set_policy(SENSORD_PAUSE_ON_POWERSAVE_MODE), PAUSE_ACTION_STOP);
+	ASSERT_EQ(pause.set_policy(SENSORD_PAUSE_ALL), PAUSE_ACTION_NONE);
+	ASSERT_EQ(pause.set_policy(SENSORD_PAUSE_ON_DISPLAY_OFF), PAUSE_ACTION_RESUME);
+
+	return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <vector>
+#include <sensor_internal.h>
+
+#include "shared/input_resampler.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+#define BASE 1000000ULL		/* us */
+#define LATENCY 1000000ULL	/* us, of the FIFO bursts and the window */
+#define BURSTS 5
+
+/* accelerometer and gyroscope at 200Hz, magnetometer at 50Hz */
+static const unsigned long long periods[] = {5000ULL, 5000ULL, 20000ULL};
+
+#define STREAMS (int)(sizeof(periods) / sizeof(periods[0]))
+
+static void pop_all(input_resampler &resampler, std::vector<unsigned long long> &released)
+{
+	resampler_frame_s frame;
+
+	while (resampler.pop(frame))
+		released.push_back(frame.timestamp);
+}
+
+/* each burst comes one stream after the other, as a wakeup delivers the
+ * FIFOs, and is released in timestamp order before the next one */
+TESTCASE(resampler, burst_flush_p)
+{
+	input_resampler resampler(LATENCY);
+	std::vector<unsigned long long> released;
+	const float values[3] = {0, 0, 0};
+	size_t pushed = 0;
+	int streams[STREAMS];
+
+	for (int i = 0; i < STREAMS; ++i)
+		streams[i] = resampler.add_stream(3);
+
+	for (int b = 0; b < BURSTS; ++b) {
+		unsigned long long start = BASE + b * LATENCY;
+
+		for (int i = 0; i < STREAMS; ++i) {
+			for (unsigned long long t = start; t < start + LATENCY; t += periods[i]) {
+				resampler.push(streams[i], t, values);
+				pop_all(resampler, released);
+				pushed++;
+			}
+		}
+
+		/* the window alone holds the burst back until the next one */
+		ASSERT_LT(released.size(), pushed);
+
+		resampler.flush();
+		pop_all(resampler, released);
+		ASSERT_EQ(released.size(), pushed);
+	}
+
+	for (size_t i = 1; i < released.size(); ++i)
+		ASSERT_LE(released[i - 1], released[i]);
+
+	return true;
+}
@@ -0,0 +1,135 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sensor_internal.h>
+
+#include "shared/shared_sample.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+#define WRITES 200000
+
+static sensor_data_t make_sample(int n)
+{
+	sensor_data_t data;
+
+	memset(&data, 0, sizeof(data));
+	data.accuracy = SENSOR_ACCURACY_GOOD;
+	data.timestamp = n;
+	data.value_count = 3;
+
+	for (int i = 0; i < 3; ++i)
+		data.values[i] = n;
+
+	return data;
+}
+
+TESTCASE(shared_sample, read_once_p)
+{
+	shared_sample writer;
+	shared_sample reader;
+	sensor_data_t data;
+	sensor_data_t display;
+	uint32_t seq = 0;
+
+	ASSERT_TRUE(writer.create());
+	ASSERT_TRUE(reader.attach(writer.get_readonly_fd()));
+
+	/* nothing was written yet */
+	ASSERT_FALSE(reader.read(data, false, seq));
+
+	data = make_sample(1);
+	display = make_sample(2);
+	writer.write(data, display);
+
+	ASSERT_TRUE(reader.read(data, false, seq));
+	ASSERT_EQ(data.timestamp, 1);
+	/* seen already */
+	ASSERT_FALSE(reader.read(data, true, seq));
+
+	writer.write(make_sample(3), make_sample(4));
+	ASSERT_TRUE(reader.read(data, true, seq));
+	ASSERT_EQ(data.timestamp, 4);
+
+	/* clients cannot map the segment writable */
+	int fd = writer.get_readonly_fd();
+	ASSERT_GE(fd, 0);
+	void *addr = mmap(NULL, sizeof(shared_sample_slot_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	ASSERT_EQ(addr, MAP_FAILED);
+
+	return true;
+}
+
+/* a reader in another process never sees a half-written sample */
+TESTCASE(shared_sample, concurrent_p)
+{
+	shared_sample writer;
+	shared_sample reader;
+	sensor_data_t data;
+	uint32_t seq = 0;
+	int status;
+	int torn = 0;
+	int read = 0;
+	bool exited = false;
+
+	ASSERT_TRUE(writer.create());
+	ASSERT_TRUE(reader.attach(writer.get_readonly_fd()));
+
+	pid_t pid = fork();
+	ASSERT_GE(pid, 0);
+
+	if (pid == 0) {
+		for (int n = 1; n <= WRITES; ++n)
+			writer.write(make_sample(n), make_sample(n));
+		_exit(0);
+	}
+
+	data.timestamp = 0;
+
+	while (data.timestamp != WRITES && !exited) {
+		/* the last sample is read after the writer is gone */
+		exited = (waitpid(pid, &status, WNOHANG) == pid);
+
+		if (!reader.read(data, false, seq))
+			continue;
+
+		++read;
+		if (data.values[0] != data.timestamp || data.values[2] != data.timestamp)
+			++torn;
+	}
+
+	if (!exited)
+		waitpid(pid, &status, 0);
+
+	ASSERT_EQ(data.timestamp, WRITES);
+
+	ASSERT_GT(read, 0);
+	ASSERT_EQ(torn, 0);
+
+	return true;
+}
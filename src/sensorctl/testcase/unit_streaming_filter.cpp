@@ -0,0 +1,157 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "shared/streaming_filter.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+#define SAMPLES 2000
+#define MAX_ERROR 1e-9
+
+/* e.g. an accelerometer magnitude, a large offset under small changes */
+static std::vector<double> make_samples(void)
+{
+	std::vector<double> samples(SAMPLES);
+
+	srand(0);
+	for (int i = 0; i < SAMPLES; ++i)
+		samples[i] = 9.8 + (double)rand() / RAND_MAX - 0.5;
+
+	return samples;
+}
+
+/* the mean of the last size samples up to end, summed anew */
+static double average_reference(const std::vector<double> &samples, int start, int end, int size)
+{
+	int first = std::max(start, end - size + 1);
+	double sum = 0;
+
+	for (int i = first; i <= end; ++i)
+		sum += samples[i];
+
+	return sum / (end - first + 1);
+}
+
+/* the window up to end, filled with the first sample before it */
+static double fir_reference(const std::vector<double> &samples, const double *coefs, int size, int end)
+{
+	double result = 0;
+
+	for (int i = 0; i < size; ++i)
+		result += coefs[i] * samples[std::max(0, end - size + 1 + i)];
+
+	return result;
+}
+
+static bool check_moving_average(int size)
+{
+	std::vector<double> samples = make_samples();
+	moving_average average(size);
+	int start = 0;
+
+	for (int i = 0; i < SAMPLES; ++i) {
+		/* starts over in the middle of a window */
+		if (i == SAMPLES / 2 + size / 2) {
+			average.reset();
+			start = i;
+		}
+
+		double value = average.filter(samples[i]);
+		double expected = average_reference(samples, start, i, size);
+
+		ASSERT_NEAR(value, expected, MAX_ERROR);
+		ASSERT_EQ(average.count(), std::min(i - start + 1, size));
+		ASSERT_NEAR(average.sum(), expected * average.count(), MAX_ERROR * size);
+	}
+
+	return true;
+}
+
+/* windows of 1, of the pedometer, and one not dividing the run */
+TESTCASE(streaming_filter, moving_average_p)
+{
+	static const int sizes[] = {1, 2, 7, 500, 333};
+
+	for (int size : sizes) {
+		_I("moving_average(%d)\n", size);
+		ASSERT_TRUE(check_moving_average(size));
+	}
+
+	return true;
+}
+
+TESTCASE(streaming_filter, fir_filter_p)
+{
+	/* the Savitzky-Golay smoother of the pedometer */
+	static const double coefs[] = {
+		-78 / 1105.0, -13 / 1105.0, 42 / 1105.0, 87 / 1105.0,
+		122 / 1105.0, 147 / 1105.0, 162 / 1105.0, 167 / 1105.0,
+		162 / 1105.0, 147 / 1105.0, 122 / 1105.0, 87 / 1105.0,
+		42 / 1105.0, -13 / 1105.0, -78 / 1105.0 };
+	static const int size = sizeof(coefs) / sizeof(coefs[0]);
+	std::vector<double> samples = make_samples();
+	fir_filter filter(coefs, size);
+
+	for (int i = 0; i < SAMPLES; ++i) {
+		double value = filter.filter(samples[i]);
+
+		/* the first sample fills the window and is returned as is */
+		if (i == 0) {
+			ASSERT_EQ(value, samples[0]);
+			continue;
+		}
+
+		ASSERT_NEAR(value, fir_reference(samples, coefs, size, i), MAX_ERROR);
+	}
+
+	return true;
+}
+
+/* the batch entry points give the same values as one sample at a time */
+TESTCASE(streaming_filter, batch_p)
+{
+	static const double coefs[] = {0.25, 0.5, 0.25};
+	std::vector<double> samples = make_samples();
+	std::vector<float> in(samples.begin(), samples.end());
+	std::vector<float> averaged(in);
+	std::vector<float> smoothed(SAMPLES);
+	moving_average batch_average(7), average(7);
+	fir_filter batch_filter(coefs, 3), filter(coefs, 3);
+
+	/* in place, and in bursts that do not line up with the window */
+	for (int i = 0; i < SAMPLES; i += 13) {
+		int n = std::min(13, SAMPLES - i);
+
+		batch_average.filter(&averaged[i], &averaged[i], n);
+		batch_filter.filter(&in[i], &smoothed[i], n);
+	}
+
+	for (int i = 0; i < SAMPLES; ++i) {
+		ASSERT_EQ(averaged[i], (float)average.filter(in[i]));
+		ASSERT_EQ(smoothed[i], (float)filter.filter(in[i]));
+	}
+
+	return true;
+}
@@ -0,0 +1,141 @@
+/*
+ * sensorctl
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include <sensor_internal.h>
+
+#include "shared/sample_synchronizer.h"
+
+#include "log.h"
+#include "test_bench.h"
+
+using namespace sensor;
+
+#define BASE 1000000ULL		/* us */
+#define PERIOD 20000ULL		/* us */
+#define FAST 10000ULL		/* us, stream 0 */
+#define SLOW 20000ULL		/* us, stream 1 */
+#define OFFSET 3000ULL		/* us, of stream 1 */
+#define DURATION 2000000ULL	/* us */
+
+/* values are a ramp in time, so that an aligned value tells its timestamp */
+static sensor_data_t make_sample(unsigned long long timestamp)
+{
+	sensor_data_t data;
+
+	memset(&data, 0, sizeof(data));
+	data.accuracy = SENSOR_ACCURACY_GOOD;
+	data.timestamp = timestamp;
+	data.value_count = 3;
+
+	for (int i = 0; i < 3; ++i)
+		data.values[i] = (timestamp - BASE) / 1000.0f;
+
+	return data;
+}
+
+/* both streams in timestamp order, the second one stops at stop */
+static std::vector<sensor_data_t> run(int mode, unsigned long long stop)
+{
+	sample_synchronizer sync;
+	std::vector<sensor_data_t> frames;
+	unsigned long long fast = BASE;
+	unsigned long long slow = BASE + OFFSET;
+
+	sync.set_streams(2);
+	sync.set_period(PERIOD);
+	sync.set_mode(mode, 0);
+
+	while (fast < BASE + DURATION) {
+		if (slow < fast && slow < stop) {
+			sync.push(1, make_sample(slow), frames);
+			slow += SLOW;
+		} else {
+			sync.push(0, make_sample(fast), frames);
+			fast += FAST;
+		}
+	}
+
+	return frames;
+}
+
+TESTCASE(synchronizer, nearest_p)
+{
+	std::vector<sensor_data_t> frames = run(SENSORD_SYNC_NEAREST, BASE + DURATION);
+
+	ASSERT_EQ(frames.size() % 2, 0);
+	ASSERT_GE(frames.size() / 2, DURATION / PERIOD - 2);
+
+	for (size_t i = 0; i < frames.size(); i += 2) {
+		unsigned long long tick = BASE + (i / 2) * PERIOD;
+
+		ASSERT_EQ(frames[i].timestamp, tick);
+		ASSERT_EQ(frames[i].value_count, 3);
+		/* the sample of the slow stream 3ms after the tick is the nearest */
+		ASSERT_EQ(frames[i + 1].timestamp, tick + OFFSET);
+		ASSERT_EQ(frames[i + 1].value_count, 3);
+	}
+
+	return true;
+}
+
+TESTCASE(synchronizer, interpolate_p)
+{
+	std::vector<sensor_data_t> frames = run(SENSORD_SYNC_INTERPOLATE, BASE + DURATION);
+
+	ASSERT_GE(frames.size() / 2, DURATION / PERIOD - 2);
+
+	/* the first tick comes before any sample of the slow stream */
+	for (size_t i = 2; i < frames.size(); i += 2) {
+		unsigned long long tick = BASE + (i / 2) * PERIOD;
+
+		ASSERT_EQ(frames[i + 1].timestamp, tick);
+		ASSERT_EQ(frames[i + 1].value_count, 3);
+		ASSERT_NEAR(frames[i + 1].values[0], (tick - BASE) / 1000.0f, 0.01);
+		ASSERT_NEAR(frames[i + 1].values[2], frames[i].values[2], 0.01);
+	}
+
+	return true;
+}
+
+TESTCASE(synchronizer, stall_p)
+{
+	unsigned long long stop = BASE + DURATION / 2;
+	std::vector<sensor_data_t> frames = run(SENSORD_SYNC_NEAREST, stop);
+	int missing = 0;
+
+	/* the frames go on without the stalled stream */
+	ASSERT_GE(frames.size() / 2, DURATION / PERIOD - 5);
+
+	for (size_t i = 0; i < frames.size(); i += 2) {
+		ASSERT_EQ(frames[i].value_count, 3);
+
+		if (frames[i + 1].value_count == 0) {
+			ASSERT_GT(frames[i].timestamp, stop - PERIOD);
+			ASSERT_EQ(frames[i + 1].accuracy, -1);
+			++missing;
+		}
+	}
+
+	ASSERT_GT(missing, 0);
+
+	return true;
+}
@@ -18,6 +18,7 @@
  */
 
 #include <sensor_log.h>
+#include <sensor_types.h>
 #include "dbus_listener.h"
 
 #define HANDLE_GERROR(Err) \
@@ -35,13 +36,23 @@
 #define ROTATION_DBUS_SIGNAL	"Changed"
 #define ROTATION_DBUS_METHOD	"Degree"
 
+static int display_rotation = AUTO_ROTATION_DEGREE_UNKNOWN;
+
+static void set_display_rotation(int rotation)
+{
+	_D("New display rotation: %d", rotation);
+	ret_if(rotation < AUTO_ROTATION_DEGREE_0 || rotation > AUTO_ROTATION_DEGREE_270);
+
+	display_rotation = rotation;
+}
+
 static void rotation_signal_cb(GDBusConnection *conn, const gchar *sender,
 		const gchar *obj_path, const gchar *iface, const gchar *signal_name,
 		GVariant *param, gpointer user_data)
 {
 	gint state;
 	g_variant_get(param, "(i)", &state);
-	//sensor_event_listener::get_instance().set_display_rotation(state);
+	set_display_rotation(state);
 }
 
 static void rotation_read_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
@@ -55,7 +66,7 @@ static void rotation_read_cb(GObject *source_object, GAsyncResult *res, gpointer
 	gint state;
 	g_variant_get(result, "(i)", &state);
 	g_variant_unref(result);
-	//sensor_event_listener::get_instance().set_display_rotation(state);
+	set_display_rotation(state);
 }
 
 dbus_listener::dbus_listener()
@@ -80,6 +91,11 @@ void dbus_listener::init(void)
 	done = true;
 }
 
+int dbus_listener::get_display_rotation(void)
+{
+	return display_rotation;
+}
+
 void dbus_listener::connect(void)
 {
 	GError *gerr = NULL;
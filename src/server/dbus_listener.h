@@ -26,6 +26,7 @@
 class dbus_listener {
 public:
 	static void init(void);
+	static int get_display_rotation(void);
 
 private:
 	GDBusConnection *m_connection;
@@ -23,6 +23,12 @@
 #include <sensor_log.h>
 #include <external_sensor.h>
 #include <algorithm>
+#include <sys/eventfd.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define QUEUE_CAPACITY 256
+#define MAX_DRAIN_BATCH 64
 
 using namespace sensor;
 
@@ -41,19 +47,17 @@ external_sensor_notifier::external_sensor_notifier(external_sensor_handler *sens
 {
 }
 
+/* Called from the plugin's own thread. The sample is only queued here;
+ * observers are notified from the event loop in drain(). */
 int external_sensor_notifier::notify(void)
 {
-	/* TODO: Change thread-safe function(add handler to event-loop) */
 	sensor_data_t *data;
 	int len;
 
 	if (m_sensor->get_data(&data, &len) < 0)
 		return OP_ERROR;
 
-	/* TODO: pointer would be better */
-	sensor_info info = m_sensor->get_sensor_info();
-
-	return m_sensor->notify(info.get_uri().c_str(), data, len);
+	return m_sensor->push(data, len);
 }
 
 external_sensor_handler::external_sensor_handler(const sensor_info &info,
@@ -62,6 +66,11 @@ external_sensor_handler::external_sensor_handler(const sensor_info &info,
 , m_sensor(sensor)
 , m_notifier(NULL)
 , m_policy(OP_DEFAULT)
+, m_event_fd(-1)
+, m_queue(QUEUE_CAPACITY)
+, m_wakeup_pending(false)
+, m_overflows(0)
+, m_max_depth(0)
 {
 	init();
 }
@@ -73,6 +82,10 @@ external_sensor_handler::~external_sensor_handler()
 
 bool external_sensor_handler::init(void)
 {
+	m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (m_event_fd < 0)
+		_E("Failed to create eventfd, [%s] is notified from the plugin thread", m_info.get_uri().c_str());
+
 	m_notifier = new(std::nothrow) external_sensor_notifier(this);
 	retvm_if(!m_notifier, false, "Failed to allocate memory");
 
@@ -84,6 +97,94 @@ void external_sensor_handler::deinit(void)
 {
 	delete m_notifier;
 	m_notifier = NULL;
+
+	sample s;
+	while (m_queue.pop(s))
+		free(s.data);
+
+	if (m_event_fd >= 0)
+		close(m_event_fd);
+	m_event_fd = -1;
+}
+
+int external_sensor_handler::get_event_fd(void)
+{
+	return m_event_fd;
+}
+
+int external_sensor_handler::push(sensor_data_t *data, int len)
+{
+	/* without a wakeup fd there is no consumer, so keep the old behavior */
+	if (m_event_fd < 0 || !m_queue.is_valid()) {
+		if (notify(m_info.get_uri().c_str(), data, len) < 0) {
+			free(data);
+			return OP_ERROR;
+		}
+		return OP_SUCCESS;
+	}
+
+	sample s = {data, len};
+
+	if (!m_queue.push(s)) {
+		uint64_t overflows = ++m_overflows;
+		/* log the first overflow and then every 1024th */
+		if ((overflows & 1023) == 1)
+			_W("Ingest queue of [%s] is full, %llu samples dropped",
+					m_info.get_uri().c_str(), (unsigned long long)overflows);
+		free(data);
+		return OP_ERROR;
+	}
+
+	/* one wakeup is enough for everything queued until the next drain */
+	if (!m_wakeup_pending.exchange(true)) {
+		uint64_t value = 1;
+		if (write(m_event_fd, &value, sizeof(value)) < 0)
+			_E("Failed to wake up event loop for [%s]", m_info.get_uri().c_str());
+	}
+
+	return OP_SUCCESS;
+}
+
+void external_sensor_handler::drain(void)
+{
+	uint64_t value;
+	sample s;
+	int count = 0;
+
+	if (read(m_event_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+		_E("Failed to read eventfd of [%s]", m_info.get_uri().c_str());
+
+	/* cleared before draining, so a sample pushed from now on wakes us again */
+	m_wakeup_pending.store(false);
+
+	size_t depth = m_queue.size();
+	if (depth > m_max_depth)
+		m_max_depth = depth;
+
+	while (count < MAX_DRAIN_BATCH && m_queue.pop(s)) {
+		if (notify(m_info.get_uri().c_str(), s.data, s.len) < 0)
+			free(s.data);
+		count++;
+	}
+
+	/* leave the rest for the next iteration so other sources are not starved */
+	if (count == MAX_DRAIN_BATCH && m_queue.size() > 0 && !m_wakeup_pending.exchange(true)) {
+		value = 1;
+		if (write(m_event_fd, &value, sizeof(value)) < 0)
+			_E("Failed to wake up event loop for [%s]", m_info.get_uri().c_str());
+	}
+}
+
+void external_sensor_handler::get_stats(cmd_sensor_stats_t &stats)
+{
+	sensor_handler::get_stats(stats);
+
+	size_t depth = m_queue.size();
+
+	/* the peak is taken when the loop drains, the queue may be past it now */
+	stats.queue_depth = depth;
+	stats.queue_max_depth = std::max(depth, m_max_depth);
+	stats.queue_overflows = m_overflows.load();
 }
 
 const sensor_info &external_sensor_handler::get_sensor_info(void)
@@ -23,7 +23,9 @@
 #include <message.h>
 #include <sensor_types.h>
 #include <external_sensor.h>
+#include <mpsc_queue.h>
 #include <unordered_map>
+#include <atomic>
 
 #include "sensor_handler.h"
 
@@ -52,7 +54,19 @@ public:
 	int flush(sensor_observer *ob);
 	int get_data(sensor_data_t **data, int *len);
 
+	/* ingest queue, fed by the plugin thread and drained by the event loop */
+	int get_event_fd(void);
+	int push(sensor_data_t *data, int len);
+	void drain(void);
+
+	void get_stats(cmd_sensor_stats_t &stats);
+
 private:
+	struct sample {
+		sensor_data_t *data;
+		int len;
+	};
+
 	bool init();
 	void deinit();
 
@@ -63,6 +77,12 @@ private:
 	sensor_notifier *m_notifier;
 	int m_policy;
 
+	int m_event_fd;
+	mpsc_queue<sample> m_queue;
+	std::atomic<bool> m_wakeup_pending;
+	std::atomic<uint64_t> m_overflows;
+	size_t m_max_depth;
+
 	std::unordered_map<sensor_observer *, int> m_interval_map;
 	std::unordered_map<sensor_observer *, int> m_batch_latency_map;
 };
@@ -22,6 +22,8 @@
 
 #include <message.h>
 #include <sensor_log.h>
+#include <stdlib.h>
+#include <string.h>
 #include <algorithm>
 
 using namespace sensor;
@@ -51,16 +53,80 @@ int fusion_sensor_handler::update(const char *uri, std::shared_ptr<ipc::message>
 	auto it = m_required_sensors.find(uri);
 	retv_if(it == m_required_sensors.end(), OP_SUCCESS);
 
-	if (m_sensor->update(it->second.id, (sensor_data_t *)msg->body(), msg->size()) < 0)
-		return OP_SUCCESS;
+	sensor_data_t *events = (sensor_data_t *)msg->body();
+	int count = msg->size() / sizeof(sensor_data_t);
 
+	sensor_data_t *burst = NULL;
+	int burst_len = 0;
+	int burst_size = 0;
+
+	/* with a batch latency the required sensor delivers its FIFO in
+	 * bursts. the burst is fused event by event, as the plugins expect,
+	 * and its outputs go out together in one notification */
+	for (int i = 0; i < count; ++i) {
+		sensor_data_t *data;
+		int len;
+
+		count_evaluation();
+
+		if (m_sensor->update(it->second.id, &events[i], sizeof(sensor_data_t)) < 0)
+			continue;
+
+		if (m_sensor->get_data(&data, &len) < 0 || len <= 0)
+			continue;
+
+		if (!burst) {
+			burst = data;
+			burst_len = burst_size = len;
+			continue;
+		}
+
+		if (burst_len + len > burst_size) {
+			int size = std::max(burst_len + len, burst_size * 2);
+			sensor_data_t *grown = (sensor_data_t *)realloc(burst, size);
+
+			if (!grown) {
+				_E("Failed to allocate memory");
+				free(data);
+				break;
+			}
+
+			burst = grown;
+			burst_size = size;
+		}
+
+		memcpy((char *)burst + burst_len, data, len);
+		burst_len += len;
+		free(data);
+	}
+
+	retv_if(!burst, OP_SUCCESS);
+
+	/* a fused event is as old as the source event that completed it */
+	if (notify(m_info.get_uri().c_str(), burst, burst_len, msg->trailer()->read) < 0) {
+		free(burst);
+		return OP_ERROR;
+	}
+
+	return OP_SUCCESS;
+}
+
+/* the sensor may hold events of a burst back to fuse them in order with
+ * those of its other required sensors, whose bursts are all in by now */
+void fusion_sensor_handler::update_done(void)
+{
 	sensor_data_t *data;
 	int len;
 
-	if (m_sensor->get_data(&data, &len) < 0)
-		return OP_ERROR;
+	ret_if(!m_sensor);
+
+	if (m_sensor->update_done() == OP_SUCCESS &&
+			m_sensor->get_data(&data, &len) >= 0 && len > 0) {
+		if (notify(m_info.get_uri().c_str(), data, len) < 0)
+			free(data);
+	}
 
-	return notify(m_info.get_uri().c_str(), data, len);
+	notify_done();
 }
 
 const sensor_info &fusion_sensor_handler::get_sensor_info(void)
@@ -169,12 +235,14 @@ int fusion_sensor_handler::get_min_batch_latency(void)
 	int batch_latency;
 	std::vector<int> temp;
 
+	/* an observer which asked for no batching (0) keeps the inputs
+	 * unbatched, as the physical sensors do */
 	for (auto it = m_batch_latency_map.begin(); it != m_batch_latency_map.end(); ++it)
-		if (it->second > 0)
+		if (it->second >= 0)
 		    temp.push_back(it->second);
 
 	if (temp.empty())
-		return 0;
+		return -1;
 
 	batch_latency = *std::min_element(temp.begin(), temp.end());
 
@@ -200,6 +268,9 @@ int fusion_sensor_handler::set_batch_latency(sensor_observer *ob, int32_t latenc
 
 	update_prev_latency(_latency);
 
+	if (_latency < 0)
+		return delete_batch_latency_internal();
+
 	return set_batch_latency_internal(_latency);
 }
 
@@ -211,6 +282,29 @@ int fusion_sensor_handler::get_batch_latency(sensor_observer *ob, int32_t &laten
 	return OP_SUCCESS;
 }
 
+int fusion_sensor_handler::delete_batch_latency(sensor_observer *ob)
+{
+	retv_if(!m_sensor, -EINVAL);
+
+	int32_t latency = -1;
+
+	/* a negative latency tells the plugin the observer has none */
+	m_sensor->set_batch_latency(ob, latency);
+
+	m_batch_latency_map.erase(ob);
+
+	latency = get_min_batch_latency();
+	retv_if(m_prev_latency == latency, OP_SUCCESS);
+
+	update_prev_latency(latency);
+
+	/* without any latency left, leave the arbitration of the inputs */
+	if (latency < 0)
+		return delete_batch_latency_internal();
+
+	return set_batch_latency_internal(latency);
+}
+
 int fusion_sensor_handler::set_attribute(sensor_observer *ob, int32_t attr, int32_t value)
 {
 	retv_if(!m_sensor, -EINVAL);
@@ -307,6 +401,17 @@ int fusion_sensor_handler::set_batch_latency_internal(int32_t latency)
 	return OP_SUCCESS;
 }
 
+int fusion_sensor_handler::delete_batch_latency_internal(void)
+{
+	auto it = m_required_sensors.begin();
+	for (; it != m_required_sensors.end(); ++it) {
+		if (it->second.sensor->delete_batch_latency(this) < 0)
+			return OP_ERROR;
+	}
+
+	return OP_SUCCESS;
+}
+
 int fusion_sensor_handler::set_attribute_internal(int32_t attr, int32_t value)
 {
 	auto it = m_required_sensors.begin();
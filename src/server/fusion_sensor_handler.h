@@ -52,6 +52,7 @@ public:
 
 	/* subscriber */
 	int update(const char *uri, std::shared_ptr<ipc::message> msg);
+	void update_done(void);
 
 	/* sensor interface */
 	const sensor_info &get_sensor_info(void);
@@ -64,6 +65,7 @@ public:
 
 	int set_batch_latency(sensor_observer *ob, int32_t latency);
 	int get_batch_latency(sensor_observer *ob, int32_t &latency);
+	int delete_batch_latency(sensor_observer *ob);
 
 	int set_attribute(sensor_observer *ob, int32_t attr, int32_t value);
 	int set_attribute(sensor_observer *ob, int32_t attr, const char *value, int len);
@@ -75,6 +77,7 @@ public:
 private:
 	int set_interval_internal(int32_t interval);
 	int set_batch_latency_internal(int32_t latency);
+	int delete_batch_latency_internal(void);
 	int set_attribute_internal(int32_t attr, int32_t value);
 	int set_attribute_internal(int32_t attr, const char *value, int len);
 
@@ -0,0 +1,131 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "listener_registry.h"
+
+#include <sensor_log.h>
+
+/* 1M slots and an 11 bit generation, ids are handed to clients as
+ * positive ints (handles) */
+#define SLOT_BITS 20
+#define SLOT_MASK ((1U << SLOT_BITS) - 1)
+#define MAX_SLOTS (1U << SLOT_BITS)
+#define GENERATION_MASK ((1U << (31 - SLOT_BITS)) - 1)
+
+using namespace sensor;
+
+static inline uint32_t make_id(uint32_t index, uint32_t generation)
+{
+	return (generation << SLOT_BITS) | index;
+}
+
+listener_registry::listener_registry()
+: m_count(0)
+{
+}
+
+listener_registry::~listener_registry()
+{
+}
+
+uint32_t listener_registry::acquire(void)
+{
+	uint32_t index;
+
+	if (!m_free.empty()) {
+		index = m_free.back();
+		m_free.pop_back();
+	} else {
+		retvm_if(m_slots.size() >= MAX_SLOTS, 0, "Too many listeners[%zu]", m_slots.size());
+
+		/* generation 0 is never used, so no id is 0 */
+		index = m_slots.size();
+		m_slots.push_back(slot {NULL, NULL, 1});
+	}
+
+	m_count++;
+
+	return make_id(index, m_slots[index].generation);
+}
+
+void listener_registry::attach(uint32_t id, sensor_listener_proxy *listener, ipc::channel *ch)
+{
+	slot *s = lookup(id);
+	ret_if(!s);
+
+	s->listener = listener;
+	s->ch = ch;
+	m_ids[ch] = id;
+}
+
+void listener_registry::release(uint32_t id)
+{
+	slot *s = lookup(id);
+	ret_if(!s);
+
+	if (s->ch)
+		m_ids.erase(s->ch);
+
+	s->listener = NULL;
+	s->ch = NULL;
+
+	/* the released id does not match the slot anymore */
+	s->generation = (s->generation + 1) & GENERATION_MASK;
+	if (s->generation == 0)
+		s->generation = 1;
+
+	m_free.push_back(id & SLOT_MASK);
+	m_count--;
+}
+
+sensor_listener_proxy *listener_registry::get(uint32_t id)
+{
+	slot *s = lookup(id);
+	retv_if(!s, NULL);
+
+	return s->listener;
+}
+
+uint32_t listener_registry::find(ipc::channel *ch)
+{
+	auto it = m_ids.find(ch);
+	retv_if(it == m_ids.end(), 0);
+
+	return it->second;
+}
+
+size_t listener_registry::size(void)
+{
+	return m_count;
+}
+
+const std::vector<listener_registry::slot> &listener_registry::slots(void)
+{
+	return m_slots;
+}
+
+listener_registry::slot *listener_registry::lookup(uint32_t id)
+{
+	uint32_t index = id & SLOT_MASK;
+
+	retv_if(id == 0 || index >= m_slots.size(), NULL);
+	retv_if(m_slots[index].generation != (id >> SLOT_BITS), NULL);
+
+	return &m_slots[index];
+}
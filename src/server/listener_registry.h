@@ -0,0 +1,69 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __LISTENER_REGISTRY_H__
+#define __LISTENER_REGISTRY_H__
+
+#include <stdint.h>
+#include <channel.h>
+#include <unordered_map>
+#include <vector>
+
+namespace sensor {
+
+class sensor_listener_proxy;
+
+/* Listeners by id. An id is the index of a slot with the generation of the
+ * slot above it, so freed slots are reused without a stale id of a client
+ * ever reaching the listener that took the slot over */
+class listener_registry {
+public:
+	typedef struct slot {
+		sensor_listener_proxy *listener;
+		ipc::channel *ch;
+		uint32_t generation;
+	} slot;
+
+	listener_registry();
+	~listener_registry();
+
+	/* takes a slot for a listener to be created, 0 if all are used */
+	uint32_t acquire(void);
+	void attach(uint32_t id, sensor_listener_proxy *listener, ipc::channel *ch);
+	void release(uint32_t id);
+
+	sensor_listener_proxy *get(uint32_t id);
+	uint32_t find(ipc::channel *ch);
+
+	size_t size(void);
+	/* for walking all listeners, the unused slots have no listener */
+	const std::vector<slot> &slots(void);
+
+private:
+	slot *lookup(uint32_t id);
+
+	std::vector<slot> m_slots;
+	std::vector<uint32_t> m_free;
+	std::unordered_map<ipc::channel *, uint32_t> m_ids;
+	size_t m_count;
+};
+
+}
+
+#endif /* __LISTENER_REGISTRY_H__ */
@@ -0,0 +1,86 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __OBSERVER_VECTOR_H__
+#define __OBSERVER_VECTOR_H__
+
+#include <stddef.h>
+#include <unordered_map>
+#include <vector>
+
+#include "sensor_observer.h"
+
+namespace sensor {
+
+/* Observers in a contiguous array for the fan-out, with the position of
+ * each one kept aside so that finding or removing one does not walk the
+ * array. Removing moves the last observer into the hole, so the order of
+ * the observers is not kept. Observers are looked up as the Base they
+ * are registered by. */
+template <typename T, typename Base = sensor_observer>
+class observer_vector {
+public:
+	typedef typename std::vector<T *>::iterator iterator;
+
+	iterator begin(void) { return m_items.begin(); }
+	iterator end(void) { return m_items.end(); }
+	size_t size(void) const { return m_items.size(); }
+
+	bool contains(Base *ob) const
+	{
+		return m_positions.find(ob) != m_positions.end();
+	}
+
+	bool add(T *item)
+	{
+		Base *ob = item;
+
+		if (!m_positions.insert(std::make_pair(ob, m_items.size())).second)
+			return false;
+
+		m_items.push_back(item);
+		return true;
+	}
+
+	bool remove(Base *ob)
+	{
+		auto it = m_positions.find(ob);
+		if (it == m_positions.end())
+			return false;
+
+		size_t pos = it->second;
+		m_positions.erase(it);
+
+		if (pos != m_items.size() - 1) {
+			m_items[pos] = m_items.back();
+			m_positions[m_items[pos]] = pos;
+		}
+
+		m_items.pop_back();
+		return true;
+	}
+
+private:
+	std::vector<T *> m_items;
+	std::unordered_map<Base *, size_t> m_positions;
+};
+
+}
+
+#endif /* __OBSERVER_VECTOR_H__ */
@@ -0,0 +1,66 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "sensor_axis.h"
+
+/* x' = m[0] * x + m[1] * y
+ * y' = m[2] * x + m[3] * y */
+static const float transforms[][4] = {
+	{ 1,  0,  0,  1},	/* AUTO_ROTATION_DEGREE_UNKNOWN */
+	{ 1,  0,  0,  1},	/* AUTO_ROTATION_DEGREE_0 */
+	{ 0, -1,  1,  0},	/* AUTO_ROTATION_DEGREE_90, landscape left */
+	{-1,  0,  0, -1},	/* AUTO_ROTATION_DEGREE_180, portrait bottom */
+	{ 0,  1, -1,  0},	/* AUTO_ROTATION_DEGREE_270, landscape right */
+};
+
+bool sensor::axis::need_remap(sensor_type_t type, int rotation)
+{
+	if (rotation < AUTO_ROTATION_DEGREE_90 || rotation > AUTO_ROTATION_DEGREE_270)
+		return false;
+
+	switch (type) {
+	case ACCELEROMETER_SENSOR:
+	case GYROSCOPE_SENSOR:
+	case GRAVITY_SENSOR:
+	case LINEAR_ACCEL_SENSOR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void sensor::axis::remap(int rotation, sensor_data_t *data, int count)
+{
+	if (rotation < AUTO_ROTATION_DEGREE_UNKNOWN || rotation > AUTO_ROTATION_DEGREE_270)
+		return;
+
+	/* coefficients are loaded once so the loop body is branch-free */
+	const float m0 = transforms[rotation][0];
+	const float m1 = transforms[rotation][1];
+	const float m2 = transforms[rotation][2];
+	const float m3 = transforms[rotation][3];
+
+	for (int i = 0; i < count; ++i) {
+		float x = data[i].values[0];
+		float y = data[i].values[1];
+
+		data[i].values[0] = m0 * x + m1 * y;
+		data[i].values[1] = m2 * x + m3 * y;
+	}
+}
@@ -0,0 +1,36 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SENSOR_AXIS_H__
+#define __SENSOR_AXIS_H__
+
+#include <sensor_types.h>
+
+namespace sensor {
+
+namespace axis {
+	bool need_remap(sensor_type_t type, int rotation);
+
+	/* rotate x/y of 'count' consecutive samples into display coordinates */
+	void remap(int rotation, sensor_data_t *data, int count);
+}
+
+}
+
+#endif /* __SENSOR_AXIS_H__ */
@@ -26,6 +26,7 @@
 using namespace sensor;
 
 static std::vector<uint32_t> ids;
+static std::vector<physical_sensor_handler *> updated;
 
 sensor_event_handler::sensor_event_handler()
 {
@@ -52,10 +53,14 @@ bool sensor_event_handler::handle(int fd, ipc::event_condition condition)
 	physical_sensor_handler *sensor;
 	int length = 0;
 	int remains;
+	uint64_t stamp;
 
 	retv_if(m_sensors.empty(), false);
 
+	stamp = sensor::utils::get_timestamp();
+
 	ids.clear();
+	updated.clear();
 
 	auto it = m_sensors.begin();
 
@@ -73,6 +78,8 @@ bool sensor_event_handler::handle(int fd, ipc::event_condition condition)
 		if (result == std::end(ids))
 			continue;
 
+		updated.push_back(sensor);
+
 		while (remains > 0) {
 			remains = sensor->get_data(&data, &length);
 			if (remains < 0) {
@@ -80,6 +87,8 @@ bool sensor_event_handler::handle(int fd, ipc::event_condition condition)
 				break;
 			}
 
+			sensor->count_read(std::max<int>(length / sizeof(sensor_data_t), 1));
+
 			if (sensor->on_event(data, length, remains) < 0) {
 				free(data);
 				continue;
@@ -88,12 +97,30 @@ bool sensor_event_handler::handle(int fd, ipc::event_condition condition)
 			info = sensor->get_sensor_info();
 
 			//_I("[Data] allocate %p", data);
-			if (sensor->notify(info.get_uri().c_str(), data, length) < 0) {
+			if (sensor->notify(info.get_uri().c_str(), data, length, stamp) < 0) {
 				free(data);
 			}
 			info.clear();
 		}
 	}
 
+	/* e.g. the FIFO bursts of all the sensors of a wakeup were notified */
+	for (auto sit = updated.begin(); sit != updated.end(); ++sit)
+		(*sit)->notify_done();
+
+	return true;
+}
+
+external_sensor_event_handler::external_sensor_event_handler(external_sensor_handler *sensor)
+: m_sensor(sensor)
+{
+}
+
+bool external_sensor_event_handler::handle(int fd, ipc::event_condition condition)
+{
+	retv_if(!m_sensor, false);
+
+	m_sensor->drain();
+
 	return true;
 }
@@ -24,6 +24,7 @@
 #include <set>
 
 #include "physical_sensor_handler.h"
+#include "external_sensor_handler.h"
 
 namespace sensor {
 
@@ -41,6 +42,18 @@ private:
 	std::set<physical_sensor_handler *> m_sensors;
 };
 
+/* drains the ingest queue of an external sensor on its eventfd */
+class external_sensor_event_handler : public ipc::event_handler
+{
+public:
+	external_sensor_event_handler(external_sensor_handler *sensor);
+
+	bool handle(int fd, ipc::event_condition condition);
+
+private:
+	external_sensor_handler *m_sensor;
+};
+
 }
 
 #endif /* __SENSOR_EVENT_DISPATCHER__ */
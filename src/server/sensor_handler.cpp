@@ -25,6 +25,11 @@
 #include <sensor_types_private.h>
 #include <command_types.h>
 #include <sensor_listener_proxy.h>
+#include <latency_histogram.h>
+#include <algorithm>
+
+#include "sensor_axis.h"
+#include "dbus_listener.h"
 
 using namespace sensor;
 
@@ -33,6 +38,9 @@ sensor_handler::sensor_handler(const sensor_info &info)
 , m_prev_interval(0)
 , m_prev_latency(0)
 , m_need_to_notify_attribute_changed(false)
+, m_stat_read(0)
+, m_stat_notified(0)
+, m_stat_evaluated(0)
 {
 	const char *priv = sensor::utils::get_privilege(m_info.get_uri());
 	m_info.set_privilege(priv);
@@ -56,47 +64,190 @@ sensor_handler::sensor_handler(const sensor_info &info)
 
 bool sensor_handler::has_observer(sensor_observer *ob)
 {
-	for (auto it = m_observers.begin(); it != m_observers.end(); ++it) {
-		if ((*it) == ob)
-			return true;
-	}
-
-	return false;
+	return m_observers.contains(ob) || m_listeners.contains(ob);
 }
 
+/* Observers are sorted by type once here, so that the fan-out paths
+ * iterate contiguous arrays and never need to cast */
 bool sensor_handler::add_observer(sensor_observer *ob)
 {
 	retv_if(has_observer(ob), false);
 
-	m_observers.push_back(ob);
+	sensor_listener_proxy *proxy = dynamic_cast<sensor_listener_proxy *>(ob);
+
+	if (proxy)
+		m_listeners.add(proxy);
+	else
+		m_observers.add(ob);
+
 	return true;
 }
 
 void sensor_handler::remove_observer(sensor_observer *ob)
 {
 	m_observers.remove(ob);
+	m_listeners.remove(ob);
+}
+
+bool sensor_handler::has_passive_observer(sensor_observer *ob)
+{
+	return m_passive_listeners.contains(ob);
+}
+
+/* Passive observers are not counted by observer_count(), so they never
+ * turn the sensor on; they only ride along while active observers run it */
+bool sensor_handler::add_passive_observer(sensor_observer *ob)
+{
+	retv_if(has_passive_observer(ob), false);
+
+	sensor_listener_proxy *proxy = dynamic_cast<sensor_listener_proxy *>(ob);
+	retvm_if(!proxy, false, "Only listeners can be passive observers");
+
+	m_passive_listeners.add(proxy);
+	return true;
+}
+
+void sensor_handler::remove_passive_observer(sensor_observer *ob)
+{
+	m_passive_listeners.remove(ob);
 }
 
 int sensor_handler::notify(const char *uri, sensor_data_t *data, int len)
+{
+	return notify(uri, data, len, 0);
+}
+
+/* read_stamp is when the data was read from the HAL, 0 if it is read just now */
+int sensor_handler::notify(const char *uri, sensor_data_t *data, int len, uint64_t read_stamp)
 {
 	if (observer_count() == 0)
 		return OP_ERROR;
 
+	update_stats(data, len);
+
+	uint64_t now = sensor::utils::get_timestamp();
+
+	if (read_stamp)
+		latency_histogram::get(SENSORD_LATENCY_HAL_TO_NOTIFY).record(now - read_stamp);
+	else
+		read_stamp = now;
+
 	auto msg = ipc::message::create((char *)data, len);
 
 	retvm_if(!msg, OP_ERROR, "Failed to allocate memory");
 
+	/* the frame is encoded once and is not modified by any observer */
+	msg->header()->type = CMD_LISTENER_EVENT;
+	msg->header()->err = OP_SUCCESS;
+	msg->trailer()->read = read_stamp;
+	msg->trailer()->notify = now;
+
+	/* remapped once, on demand, and shared by all display-oriented listeners */
+	std::shared_ptr<ipc::message> display_msg;
+	int rotation = dbus_listener::get_display_rotation();
+
+	if (!axis::need_remap(m_info.get_type(), rotation))
+		display_msg = msg;
+
 	for (auto it = m_observers.begin(); it != m_observers.end(); ++it)
 		(*it)->update(uri, msg);
 
+	for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+		update_listener(*it, uri, msg, display_msg, rotation);
+
+	for (auto it = m_passive_listeners.begin(); it != m_passive_listeners.end(); ++it)
+		update_listener(*it, uri, msg, display_msg, rotation);
+
 	set_cache(data, len);
+	update_shared(data, len, rotation);
 
 	return OP_SUCCESS;
 }
 
+/* observers which hold events back, e.g. to reorder them with the events
+ * of other sensors, can go on with all the events read at once */
+void sensor_handler::notify_done(void)
+{
+	for (auto it = m_observers.begin(); it != m_observers.end(); ++it)
+		(*it)->update_done();
+}
+
+void sensor_handler::update_shared(sensor_data_t *data, int len, int rotation)
+{
+	int count = len / sizeof(sensor_data_t);
+
+	ret_if(!m_shared.is_valid() || count == 0);
+
+	sensor_data_t display = data[count - 1];
+
+	if (axis::need_remap(m_info.get_type(), rotation))
+		axis::remap(rotation, &display, 1);
+
+	m_shared.write(data[count - 1], display);
+}
+
+void sensor_handler::update_listener(sensor_listener_proxy *proxy, const char *uri,
+		std::shared_ptr<ipc::message> msg, std::shared_ptr<ipc::message> &display_msg, int rotation)
+{
+	if (!proxy->is_display_oriented()) {
+		proxy->update(uri, msg);
+		return;
+	}
+
+	if (!display_msg) {
+		int count = msg->size() / sizeof(sensor_data_t);
+
+		display_msg = ipc::message::create(msg->size());
+		if (!display_msg || count == 0) {
+			display_msg = msg;
+		} else {
+			display_msg->enclose(msg->body(), msg->size());
+			display_msg->header()->type = CMD_LISTENER_EVENT;
+			display_msg->header()->err = OP_SUCCESS;
+			*display_msg->trailer() = *msg->trailer();
+			axis::remap(rotation, reinterpret_cast<sensor_data_t *>(display_msg->body()), count);
+		}
+	}
+
+	proxy->update(uri, display_msg);
+}
+
 uint32_t sensor_handler::observer_count(void)
 {
-	return m_observers.size();
+	return m_observers.size() + m_listeners.size();
+}
+
+/* Counters are relaxed atomics: they are bumped on the event path and
+ * only read when somebody asks for statistics */
+void sensor_handler::count_read(int count)
+{
+	m_stat_read.fetch_add(count, std::memory_order_relaxed);
+}
+
+void sensor_handler::count_evaluation(void)
+{
+	m_stat_evaluated.fetch_add(1, std::memory_order_relaxed);
+}
+
+void sensor_handler::update_stats(sensor_data_t *data, int len)
+{
+	int count = len / sizeof(sensor_data_t);
+
+	m_stat_notified.fetch_add((count > 0) ? count : 1, std::memory_order_relaxed);
+	ret_if(count == 0);
+
+	m_stat_period.update(data[count - 1].timestamp, count);
+}
+
+void sensor_handler::get_stats(cmd_sensor_stats_t &stats)
+{
+	uint64_t period = m_stat_period.get();
+
+	stats.events_read = m_stat_read.load(std::memory_order_relaxed);
+	stats.events_notified = m_stat_notified.load(std::memory_order_relaxed);
+	stats.fusion_evaluations = m_stat_evaluated.load(std::memory_order_relaxed);
+	stats.rate = (period > 0) ? (1000000.0f / period) : 0;
+	stats.observer_count = observer_count();
 }
 
 void sensor_handler::set_cache(sensor_data_t *data, int size)
@@ -129,6 +280,24 @@ int sensor_handler::get_cache(sensor_data_t **data, int *len)
 	return 0;
 }
 
+int sensor_handler::get_shared_fd(void)
+{
+	if (!m_shared.is_valid()) {
+		retvm_if(!m_shared.create(), -ENOMEM, "Failed to create shared sample of [%s]",
+				m_info.get_uri().c_str());
+
+		/* a sensor which is not notifying still has something to offer */
+		if (!m_sensor_data_cache.empty())
+			update_shared(reinterpret_cast<sensor_data_t *>(m_sensor_data_cache.data()),
+					m_sensor_data_cache.size(), dbus_listener::get_display_rotation());
+	}
+
+	int fd = m_shared.get_readonly_fd();
+	retv_if(fd < 0, -EIO);
+
+	return fd;
+}
+
 bool sensor_handler::notify_attribute_changed(uint32_t id, int32_t attribute, int32_t value)
 {
 	if (observer_count() == 0)
@@ -146,12 +315,14 @@ bool sensor_handler::notify_attribute_changed(uint32_t id, int32_t attribute, in
 	msg->set_type(CMD_LISTENER_SET_ATTR_INT);
 	msg->enclose((char *)&buf, sizeof(buf));
 
-	sensor_listener_proxy *proxy = NULL;
-	for (auto it = m_observers.begin(); it != m_observers.end(); ++it) {
-		proxy = dynamic_cast<sensor_listener_proxy *>(*it);
-		if (proxy && proxy->get_id() != id) {
-			proxy->on_attribute_changed(msg);
-		}
+	for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it) {
+		if ((*it)->get_id() != id)
+			(*it)->on_attribute_changed(msg);
+	}
+
+	for (auto it = m_passive_listeners.begin(); it != m_passive_listeners.end(); ++it) {
+		if ((*it)->get_id() != id)
+			(*it)->on_attribute_changed(msg);
 	}
 
 	return OP_SUCCESS;
@@ -184,13 +355,11 @@ bool sensor_handler::notify_attribute_changed(uint32_t id, int32_t attribute, co
 	msg->enclose((char *)buf, size);
 
 	_I("notify attribute changed by listener[%zu]\n", id);
-	sensor_listener_proxy *proxy = NULL;
-	for (auto it = m_observers.begin(); it != m_observers.end(); ++it) {
-		proxy = dynamic_cast<sensor_listener_proxy *>(*it);
-		if (proxy) {
-			proxy->on_attribute_changed(msg);
-		}
-	}
+	for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+		(*it)->on_attribute_changed(msg);
+
+	for (auto it = m_passive_listeners.begin(); it != m_passive_listeners.end(); ++it)
+		(*it)->on_attribute_changed(msg);
 
 	delete[] buf;
 
@@ -24,12 +24,18 @@
 #include <sensor_publisher.h>
 #include <sensor_types.h>
 #include <sensor_info.h>
-#include <list>
+#include <command_types.h>
+#include <shared_sample.h>
+#include <observer_vector.h>
+#include <stat_period.h>
 #include <map>
 #include <vector>
+#include <atomic>
 
 namespace sensor {
 
+class sensor_listener_proxy;
+
 class sensor_handler : public sensor_publisher {
 public:
 	sensor_handler(const sensor_info &info);
@@ -39,7 +45,12 @@ public:
 	bool has_observer(sensor_observer *ob);
 	bool add_observer(sensor_observer *ob);
 	void remove_observer(sensor_observer *ob);
+	bool has_passive_observer(sensor_observer *ob);
+	bool add_passive_observer(sensor_observer *ob);
+	void remove_passive_observer(sensor_observer *ob);
 	int notify(const char *type, sensor_data_t *data, int len);
+	int notify(const char *type, sensor_data_t *data, int len, uint64_t read_stamp);
+	void notify_done(void);
 	uint32_t observer_count(void);
 
 	virtual const sensor_info &get_sensor_info(void) = 0;
@@ -65,11 +76,19 @@ public:
 
 	void set_cache(sensor_data_t *data, int size);
 	int get_cache(sensor_data_t **data, int *len);
+	int get_shared_fd(void);
 	bool notify_attribute_changed(uint32_t id, int32_t attribute, int32_t value);
 	bool notify_attribute_changed(uint32_t id, int32_t attribute, const char *value, int len);
 	bool need_to_notify_attribute_changed();
 	void set_need_to_notify_attribute_changed(bool value);
+
+	/* statistics */
+	void count_read(int count);
+	void count_evaluation(void);
+	virtual void get_stats(cmd_sensor_stats_t &stats);
 protected:
+	void update_listener(sensor_listener_proxy *proxy, const char *uri, std::shared_ptr<ipc::message> msg,
+			std::shared_ptr<ipc::message> &display_msg, int rotation);
 	void update_prev_interval(int32_t interval);
 	void update_prev_latency(int32_t latency);
 
@@ -82,9 +101,21 @@ protected:
 
 	bool m_need_to_notify_attribute_changed;
 private:
-	std::list<sensor_observer *> m_observers;
+	observer_vector<sensor_observer> m_observers;
+	observer_vector<sensor_listener_proxy> m_listeners;
+	observer_vector<sensor_listener_proxy> m_passive_listeners;
 
 	std::vector<char> m_sensor_data_cache;
+	/* made on the first request for it, so unpolled sensors cost nothing */
+	shared_sample m_shared;
+
+	void update_stats(sensor_data_t *data, int len);
+	void update_shared(sensor_data_t *data, int len, int rotation);
+
+	std::atomic<uint64_t> m_stat_read;
+	std::atomic<uint64_t> m_stat_notified;
+	std::atomic<uint64_t> m_stat_evaluated;
+	stat_period m_stat_period;
 };
 
 }
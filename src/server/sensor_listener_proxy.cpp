@@ -24,12 +24,38 @@
 #include <command_types.h>
 #include <sensor_log.h>
 #include <sensor_types.h>
+#include <sensor_types_private.h>
+#include <sensor_utils.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
 
 #include "sensor_handler.h"
 #include "sensor_policy_monitor.h"
+#include "sensor_axis.h"
+#include "dbus_listener.h"
+
+#define VALUE_COUNT_MAX (sizeof(sensor_data_t::values) / sizeof(float))
 
 using namespace sensor;
 
+sensor_sync_member::sensor_sync_member(sensor_listener_proxy *proxy, int stream, std::string uri)
+: m_proxy(proxy)
+, m_stream(stream)
+, m_uri(uri)
+{
+}
+
+std::string sensor_sync_member::get_uri(void)
+{
+	return m_uri;
+}
+
+int sensor_sync_member::update(const char *uri, std::shared_ptr<ipc::message> msg)
+{
+	return m_proxy->update_sync(m_stream, msg);
+}
+
 sensor_listener_proxy::sensor_listener_proxy(uint32_t id,
 			std::string uri, sensor_manager *manager, ipc::channel *ch)
 : m_id(id)
@@ -38,13 +64,26 @@ sensor_listener_proxy::sensor_listener_proxy(uint32_t id,
 , m_ch(ch)
 , m_started(false)
 , m_passive(false)
-, m_pause_policy(SENSORD_PAUSE_ALL)
+, m_pause(SENSORD_PAUSE_ALL)
 , m_axis_orientation(SENSORD_AXIS_DISPLAY_ORIENTED)
-, m_last_accuracy(SENSOR_ACCURACY_UNDEFINED)
 , m_need_to_notify_attribute_changed(false)
+, m_interval(POLL_MAX_HZ_MS)
+, m_max_batch_latency(-1)
+, m_decimation(SENSORD_DECIMATION_NONE)
+, m_aggregation(SENSORD_AGGREGATION_NONE)
+, m_aggregation_window(0)
+, m_aggregation_hop(0)
+, m_delivery(SENSORD_DELIVERY_ALL)
+, m_heartbeat(0)
+, m_sync_mode(SENSORD_SYNC_NEAREST)
+, m_sync_tolerance(0)
+, m_stat_events(0)
+, m_stat_filtered(0)
 {
+	reset_decimation();
+
 	_D("Create [%p][%s]", this, m_uri.data());
-	sensor_policy_monitor::get_instance().add_listener(this);
+	sensor_policy_monitor::get_instance().add_listener(this, m_pause.get_policy());
 }
 
 sensor_listener_proxy::~sensor_listener_proxy()
@@ -52,6 +91,9 @@ sensor_listener_proxy::~sensor_listener_proxy()
 	_D("Delete [%p][%s]", this, m_uri.data());
 	sensor_policy_monitor::get_instance().remove_listener(this);
 	stop();
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it)
+		delete *it;
 }
 
 uint32_t sensor_listener_proxy::get_id(void)
@@ -59,54 +101,312 @@ uint32_t sensor_listener_proxy::get_id(void)
 	return m_id;
 }
 
+std::string sensor_listener_proxy::get_uri(void)
+{
+	return m_uri;
+}
+
 int sensor_listener_proxy::update(const char *uri, std::shared_ptr<ipc::message> msg)
 {
 	retv_if(!m_ch || !m_ch->is_connected(), OP_CONTINUE);
 
-	update_event(msg);
-	update_accuracy(msg);
+	if (!m_sync_members.empty())
+		return update_sync(0, msg);
+
+	std::shared_ptr<ipc::message> event;
+
+	if (m_aggregation != SENSORD_AGGREGATION_NONE)
+		event = aggregate(msg);
+	else
+		event = decimate(msg);
+
+	if (event)
+		event = filter(event);
+	if (event)
+		update_event(event);
 
 	return OP_CONTINUE;
 }
 
-int sensor_listener_proxy::on_attribute_changed(std::shared_ptr<ipc::message> msg)
+/* The handler runs the sensor at the fastest interval among its observers,
+ * so thin the stream out to the interval this listener asked for, sample
+ * by sample for a batch. Returns nullptr if no sample must be delivered
+ * to this listener. */
+std::shared_ptr<ipc::message> sensor_listener_proxy::decimate(std::shared_ptr<ipc::message> msg)
 {
-	retv_if(!m_ch || !m_ch->is_connected(), OP_CONTINUE);
-	_I("Proxy[%zu] call on_attribute_changed\n", get_id());
-	m_ch->send(msg);
-	return OP_CONTINUE;
+	retv_if(m_decimation == SENSORD_DECIMATION_NONE, msg);
+	retv_if(m_interval <= 0 || m_interval >= POLL_MAX_HZ_MS, msg);
+
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg->body());
+	int count = msg->size() / sizeof(sensor_data_t);
+	std::vector<sensor_data_t> kept;
+	sensor_data_t out;
+
+	retv_if(count == 0, msg);
+
+	for (int i = 0; i < count; ++i) {
+		if (decimate(data[i], out))
+			kept.push_back(out);
+	}
+
+	retv_if(kept.empty(), nullptr);
+
+	/* every sample went out as it came */
+	if ((int)kept.size() == count &&
+			::memcmp(kept.data(), data, count * sizeof(sensor_data_t)) == 0)
+		return msg;
+
+	return sensor::utils::create_event(kept.data(), kept.size(), *msg);
 }
 
-void sensor_listener_proxy::update_event(std::shared_ptr<ipc::message> msg)
+/* Returns true if data is to be delivered, as out: averaged over the
+ * samples dropped since the last one in the average mode */
+bool sensor_listener_proxy::decimate(const sensor_data_t &data, sensor_data_t &out)
 {
-	/* TODO: check axis orientation */
-	msg->header()->type = CMD_LISTENER_EVENT;
-	msg->header()->err = OP_SUCCESS;
+	unsigned long long timestamp = data.timestamp;
+	unsigned long long interval = (unsigned long long)m_interval * 1000;
+	unsigned long long period = 0;
 
-	m_ch->send(msg);
+	/* timestamp went backwards, e.g. the sensor was restarted */
+	if (timestamp < m_last_timestamp)
+		reset_decimation();
+
+	if (m_last_timestamp > 0)
+		period = timestamp - m_last_timestamp;
+	m_last_timestamp = timestamp;
+
+	bool averaging = (m_decimation == SENSORD_DECIMATION_AVERAGE);
+
+	if (averaging) {
+		int count = std::min<int>(data.value_count, VALUE_COUNT_MAX);
+		for (int i = 0; i < count; ++i)
+			m_avg_sum[i] += data.values[i];
+		m_avg_count++;
+	}
+
+	/* Accept a sample that arrives up to half a source period early,
+	 * so that jitter around the deadline does not cost a whole slot */
+	if (m_next_timestamp > 0 && timestamp + period / 2 < m_next_timestamp)
+		return false;
+
+	/* keep the phase of the output stream unless a gap broke it */
+	if (m_next_timestamp > 0 && timestamp < m_next_timestamp + interval)
+		m_next_timestamp += interval;
+	else
+		m_next_timestamp = timestamp + interval;
+
+	out = data;
+
+	if (averaging && m_avg_count > 1)
+		average(out);
+
+	m_avg_count = 0;
+	std::fill(m_avg_sum, m_avg_sum + VALUE_COUNT_MAX, 0);
+
+	return true;
+}
+
+void sensor_listener_proxy::average(sensor_data_t &data)
+{
+	int count = std::min<int>(data.value_count, VALUE_COUNT_MAX);
+
+	for (int i = 0; i < count; ++i)
+		data.values[i] = m_avg_sum[i] / m_avg_count;
 }
 
-void sensor_listener_proxy::update_accuracy(std::shared_ptr<ipc::message> msg)
+void sensor_listener_proxy::reset_decimation(void)
+{
+	m_next_timestamp = 0;
+	m_last_timestamp = 0;
+	m_avg_count = 0;
+	std::fill(m_avg_sum, m_avg_sum + VALUE_COUNT_MAX, 0);
+}
+
+/* An aggregating listener gets one record per window instead of the
+ * samples, made from every sample the handler notifies.
+ * Returns nullptr if no window was closed by msg. */
+std::shared_ptr<ipc::message> sensor_listener_proxy::aggregate(std::shared_ptr<ipc::message> msg)
 {
 	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg->body());
+	int count = msg->size() / sizeof(sensor_data_t);
+	std::vector<sensor_data_t> records;
+	sensor_data_t record;
 
-	if (data->accuracy == m_last_accuracy)
-		return;
+	for (int i = 0; i < count; ++i) {
+		if (m_aggregator.push(data[i], record))
+			records.push_back(record);
+	}
+
+	retv_if(records.empty(), nullptr);
+
+	return sensor::utils::create_event(records.data(), records.size(), *msg);
+}
+
+int sensor_listener_proxy::set_aggregation(int32_t attribute, int32_t value)
+{
+	if (attribute == SENSORD_ATTRIBUTE_AGGREGATION) {
+		retv_if(value < SENSORD_AGGREGATION_NONE || value > SENSORD_AGGREGATION_COUNT, -EINVAL);
+		m_aggregation = value;
+	} else if (attribute == SENSORD_ATTRIBUTE_AGGREGATION_WINDOW) {
+		retv_if(value < 0, -EINVAL);
+		m_aggregation_window = value;
+	} else {
+		retv_if(value < 0, -EINVAL);
+		m_aggregation_hop = value;
+	}
+
+	/* the windows start over from the next sample */
+	m_aggregator.set_window(m_aggregation, (unsigned long long)m_aggregation_window * 1000,
+			(unsigned long long)m_aggregation_hop * 1000);
+
+	return OP_SUCCESS;
+}
+
+int sensor_listener_proxy::set_sync(int32_t attribute, int32_t value)
+{
+	if (attribute == SENSORD_ATTRIBUTE_SYNC_MODE) {
+		retv_if(value < SENSORD_SYNC_NEAREST || value > SENSORD_SYNC_INTERPOLATE, -EINVAL);
+		m_sync_mode = value;
+	} else {
+		retv_if(value < 0, -EINVAL);
+		m_sync_tolerance = value;
+	}
+
+	m_sync.set_mode(m_sync_mode, m_sync_tolerance);
+
+	return OP_SUCCESS;
+}
+
+int sensor_listener_proxy::add_sync_sensor(std::string uri)
+{
+	sensor_handler *sensor = m_manager->get_sensor(uri);
+	retv_if(!sensor, -EINVAL);
+	retv_if(uri == m_uri, -EINVAL);
+	retvm_if(m_sync_members.size() + 1 >= SYNC_MAX_STREAMS, -EPERM,
+			"Listener[%d] has too many sensors", get_id());
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it)
+		retv_if((*it)->get_uri() == uri, -EINVAL);
+
+	sensor_sync_member *member;
+	member = new(std::nothrow) sensor_sync_member(this, m_sync_members.size() + 1, uri);
+	retvm_if(!member, -ENOMEM, "Failed to allocate memory");
+
+	m_sync_members.push_back(member);
+	m_sync.set_streams(m_sync_members.size() + 1);
+	m_sync.set_period((unsigned long long)m_interval * 1000);
+	m_sync.set_mode(m_sync_mode, m_sync_tolerance);
+
+	/* the member follows the settings the listener already has */
+	sensor->set_interval(member, m_interval);
+	if (m_max_batch_latency >= 0)
+		sensor->set_batch_latency(member, m_max_batch_latency);
+	if (m_started)
+		sensor->start(member);
+
+	_I("Listener[%d] synchronizes [%s]", get_id(), uri.c_str());
+
+	return OP_SUCCESS;
+}
+
+/* The handler remaps the samples of the sensor a listener is connected
+ * to; those of the members come as they are and are remapped here */
+int sensor_listener_proxy::update_sync(int stream, std::shared_ptr<ipc::message> msg)
+{
+	retv_if(!m_ch || !m_ch->is_connected(), OP_CONTINUE);
+
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg->body());
+	int count = msg->size() / sizeof(sensor_data_t);
+	std::vector<sensor_data_t> frames;
+	int rotation = 0;
+	bool remap = false;
+
+	if (stream > 0 && is_display_oriented()) {
+		sensor_handler *member = m_manager->get_sensor(m_sync_members[stream - 1]->get_uri());
+
+		if (member) {
+			sensor_info info = member->get_sensor_info();
+			rotation = dbus_listener::get_display_rotation();
+			remap = axis::need_remap(info.get_type(), rotation);
+		}
+	}
+
+	for (int i = 0; i < count; ++i) {
+		sensor_data_t sample = data[i];
+
+		if (remap)
+			axis::remap(rotation, &sample, 1);
+
+		m_sync.push(stream, sample, frames);
+	}
+
+	retv_if(frames.empty(), OP_CONTINUE);
+
+	auto frame_msg = sensor::utils::create_event(frames.data(), frames.size(), *msg);
+	retv_if(!frame_msg, OP_CONTINUE);
+
+	update_event(frame_msg);
+
+	return OP_CONTINUE;
+}
+
+/* Let through only the samples the delivery mode asks for, so that a
+ * listener which cares about changes is not woken up by every sample.
+ * Returns nullptr if no sample of msg must be delivered. */
+std::shared_ptr<ipc::message> sensor_listener_proxy::filter(std::shared_ptr<ipc::message> msg)
+{
+	retv_if(m_filter.get_mode() == SENSORD_DELIVERY_ALL, msg);
+
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg->body());
+	int count = msg->size() / sizeof(sensor_data_t);
+	std::vector<sensor_data_t> kept;
+
+	retv_if(count == 0, msg);
+
+	for (int i = 0; i < count; ++i) {
+		if (!m_filter.push(data[i])) {
+			m_stat_filtered.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		if (count > 1)
+			kept.push_back(data[i]);
+		else
+			return msg;
+	}
 
-	m_last_accuracy = data->accuracy;
+	retv_if(kept.empty(), nullptr);
+	retv_if((int)kept.size() == count, msg);
 
-	sensor_data_t acc_data;
-	acc_data.accuracy = m_last_accuracy;
+	/* a batch lost some of its samples, frame the rest anew */
+	return sensor::utils::create_event(kept.data(), kept.size(), *msg);
+}
+
+int sensor_listener_proxy::on_attribute_changed(std::shared_ptr<ipc::message> msg)
+{
+	retv_if(!m_ch || !m_ch->is_connected(), OP_CONTINUE);
+	_I("Proxy[%zu] call on_attribute_changed\n", get_id());
+	m_ch->send(msg);
+	return OP_CONTINUE;
+}
 
-	auto acc_msg = ipc::message::create();
+bool sensor_listener_proxy::is_display_oriented(void)
+{
+	return m_axis_orientation == SENSORD_AXIS_DISPLAY_ORIENTED;
+}
 
-	retm_if(!acc_msg, "Failed to allocate memory");
+void sensor_listener_proxy::update_event(std::shared_ptr<ipc::message> msg)
+{
+	/* msg is already framed as CMD_LISTENER_EVENT and shared with other listeners */
+	if (!m_ch->send(msg))
+		return;
 
-	acc_msg->header()->type = CMD_LISTENER_ACC_EVENT;
-	acc_msg->header()->err = OP_SUCCESS;
-	acc_msg->enclose(&acc_data, sizeof(acc_data));
+	int count = msg->size() / sizeof(sensor_data_t);
+	m_stat_events.fetch_add(count, std::memory_order_relaxed);
+	ret_if(count == 0);
 
-	m_ch->send(acc_msg);
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg->body());
+	m_stat_period.update(data[count - 1].timestamp, count);
 }
 
 int sensor_listener_proxy::start(bool policy)
@@ -118,14 +418,32 @@ int sensor_listener_proxy::start(bool policy)
 
 	_D("Listener[%d] try to start", get_id());
 
-	ret = sensor->start(this);
-	retv_if(ret < 0, OP_ERROR);
+	/* the current value goes out first, whatever the delivery mode */
+	m_filter.reset();
+	m_aggregator.reset();
+
+	if (m_passive) {
+		/* passive listeners never turn the sensor on */
+		sensor->add_passive_observer(this);
+	} else {
+		ret = sensor->start(this);
+		retv_if(ret < 0, OP_ERROR);
+	}
+
+	m_sync.reset();
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member && member->start(*it) < 0)
+			_E("Listener[%d] failed to start [%s]", get_id(), (*it)->get_uri().c_str());
+	}
 
 	/* m_started is changed only when it is explicitly called by user,
 	 * not automatically determined by any pause policy. */
 	if (policy)
 		return OP_SUCCESS;
 
+	m_pause.start();
 	m_started = true;
 	return OP_SUCCESS;
 }
@@ -138,8 +456,18 @@ int sensor_listener_proxy::stop(bool policy)
 
 	_D("Listener[%d] try to stop", get_id());
 
-	int ret = sensor->stop(this);
-	retv_if(ret < 0, OP_ERROR);
+	if (m_passive) {
+		sensor->remove_passive_observer(this);
+	} else {
+		int ret = sensor->stop(this);
+		retv_if(ret < 0, OP_ERROR);
+	}
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member)
+			member->stop(*it);
+	}
 
 	/* attributes and m_started are changed only when it is explicitly called by user,
 	 * not automatically determined by any policy. */
@@ -150,6 +478,7 @@ int sensor_listener_proxy::stop(bool policy)
 	set_interval(POLL_MAX_HZ_MS);
 	delete_batch_latency();
 
+	m_pause.stop();
 	m_started = false;
 	return OP_SUCCESS;
 }
@@ -161,8 +490,25 @@ int sensor_listener_proxy::set_interval(int32_t interval)
 
 	_D("Listener[%d] try to set interval[%d]", get_id(), interval);
 
-	int ret = sensor->set_interval(this, interval);
-	apply_sensor_handler_need_to_notify_attribute_changed(sensor);
+	int ret = OP_SUCCESS;
+
+	/* passive listeners take no part in the interval arbitration */
+	if (!m_passive) {
+		ret = sensor->set_interval(this, interval);
+		apply_sensor_handler_need_to_notify_attribute_changed(sensor);
+	}
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member)
+			member->set_interval(*it, interval);
+	}
+
+	if (ret >= 0 && m_interval != interval) {
+		m_interval = interval;
+		reset_decimation();
+		m_sync.set_period((unsigned long long)m_interval * 1000);
+	}
 
 	return ret;
 }
@@ -183,8 +529,23 @@ int sensor_listener_proxy::set_max_batch_latency(int32_t max_batch_latency)
 	retv_if(!sensor, -EINVAL);
 
 	_D("Listener[%d] try to set max batch latency[%d]", get_id(), max_batch_latency);
-	int ret = sensor->set_batch_latency(this, max_batch_latency);
-	apply_sensor_handler_need_to_notify_attribute_changed(sensor);
+
+	int ret = OP_SUCCESS;
+
+	/* passive listeners take no part in the latency arbitration */
+	if (!m_passive) {
+		ret = sensor->set_batch_latency(this, max_batch_latency);
+		apply_sensor_handler_need_to_notify_attribute_changed(sensor);
+	}
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member)
+			member->set_batch_latency(*it, max_batch_latency);
+	}
+
+	if (ret >= 0)
+		m_max_batch_latency = max_batch_latency;
 
 	return ret;
 }
@@ -206,16 +567,69 @@ int sensor_listener_proxy::delete_batch_latency(void)
 
 	_I("Listener[%d] try to delete batch latency", get_id());
 
+	m_max_batch_latency = -1;
+
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member)
+			member->delete_batch_latency(*it);
+	}
+
+	retv_if(m_passive, OP_SUCCESS);
+
 	return sensor->delete_batch_latency(this);
 }
 
 int sensor_listener_proxy::set_passive_mode(bool passive)
 {
-	/* TODO: passive mode */
+	sensor_handler *sensor = m_manager->get_sensor(m_uri);
+	retv_if(!sensor, -EINVAL);
+	retv_if(m_passive == passive, OP_SUCCESS);
+
+	_D("Listener[%d] try to set passive mode[%d]", get_id(), passive);
+
+	/* m_started does not tell whether a pause policy detached this listener */
+	bool attached = m_passive ? sensor->has_passive_observer(this) : sensor->has_observer(this);
+
+	if (attached) {
+		if (m_passive)
+			sensor->remove_passive_observer(this);
+		else
+			sensor->stop(this);
+	}
+
+	if (!m_passive) {
+		/* leave the interval/latency arbitration */
+		sensor->set_interval(this, POLL_MAX_HZ_MS);
+		sensor->delete_batch_latency(this);
+	}
+
 	m_passive = passive;
+
+	if (!m_passive) {
+		/* join the arbitration with what this listener asked for */
+		sensor->set_interval(this, m_interval);
+		if (m_max_batch_latency >= 0)
+			sensor->set_batch_latency(this, m_max_batch_latency);
+	}
+
+	if (attached) {
+		if (m_passive) {
+			sensor->add_passive_observer(this);
+		} else {
+			int ret = sensor->start(this);
+			retv_if(ret < 0, OP_ERROR);
+		}
+	}
+
 	return OP_SUCCESS;
 }
 
+bool sensor_listener_proxy::get_passive_mode(void)
+{
+	return m_passive;
+}
+
 int sensor_listener_proxy::set_attribute(int32_t attribute, int32_t value)
 {
 	sensor_handler *sensor = m_manager->get_sensor(m_uri);
@@ -224,8 +638,11 @@ int sensor_listener_proxy::set_attribute(int32_t attribute, int32_t value)
 	_D("Listener[%d] try to set attribute[%d, %d]", get_id(), attribute, value);
 
 	if (attribute == SENSORD_ATTRIBUTE_PAUSE_POLICY) {
-		if (m_pause_policy != value) {
-			m_pause_policy = value;
+		if (m_pause.get_policy() != value) {
+			sensor_policy_monitor::get_instance().set_pause_policy(this, value);
+			/* resumed here, as the monitor no longer notifies a listener
+			 * whose new policy never pauses */
+			apply_pause(m_pause.set_policy(value));
 			set_need_to_notify_attribute_changed(true);
 		}
 		return OP_SUCCESS;
@@ -235,6 +652,30 @@ int sensor_listener_proxy::set_attribute(int32_t attribute, int32_t value)
 			set_need_to_notify_attribute_changed(true);
 		}
 		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_DECIMATION_MODE) {
+		retv_if(value < SENSORD_DECIMATION_NONE || value > SENSORD_DECIMATION_AVERAGE, -EINVAL);
+		if (m_decimation != value) {
+			m_decimation = value;
+			reset_decimation();
+		}
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_DELIVERY_MODE) {
+		retv_if(value < SENSORD_DELIVERY_ALL || value > SENSORD_DELIVERY_DELTA, -EINVAL);
+		m_delivery = value;
+		m_filter.set_mode(m_delivery);
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_HEARTBEAT) {
+		retv_if(value < 0, -EINVAL);
+		m_heartbeat = value;
+		m_filter.set_heartbeat((unsigned long long)m_heartbeat * 1000);
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_AGGREGATION ||
+			attribute == SENSORD_ATTRIBUTE_AGGREGATION_WINDOW ||
+			attribute == SENSORD_ATTRIBUTE_AGGREGATION_HOP) {
+		return set_aggregation(attribute, value);
+	} else if (attribute == SENSORD_ATTRIBUTE_SYNC_MODE ||
+			attribute == SENSORD_ATTRIBUTE_SYNC_TOLERANCE) {
+		return set_sync(attribute, value);
 	} else if (attribute == SENSORD_ATTRIBUTE_FLUSH) {
 		return flush();
 	}
@@ -253,11 +694,35 @@ int sensor_listener_proxy::get_attribute(int32_t attribute, int32_t *value)
 	_D("Listener[%d] try to get attribute[%d] int", get_id(), attribute);
 
 	if (attribute == SENSORD_ATTRIBUTE_PAUSE_POLICY) {
-		*value = m_pause_policy;
+		*value = m_pause.get_policy();
 		return OP_SUCCESS;
 	} else if (attribute == SENSORD_ATTRIBUTE_AXIS_ORIENTATION) {
 		*value = m_axis_orientation;
 		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_DECIMATION_MODE) {
+		*value = m_decimation;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_DELIVERY_MODE) {
+		*value = m_delivery;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_HEARTBEAT) {
+		*value = m_heartbeat;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_AGGREGATION) {
+		*value = m_aggregation;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_AGGREGATION_WINDOW) {
+		*value = m_aggregation_window;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_AGGREGATION_HOP) {
+		*value = m_aggregation_hop;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_SYNC_MODE) {
+		*value = m_sync_mode;
+		return OP_SUCCESS;
+	} else if (attribute == SENSORD_ATTRIBUTE_SYNC_TOLERANCE) {
+		*value = m_sync_tolerance;
+		return OP_SUCCESS;
 	} else if (attribute == SENSORD_ATTRIBUTE_FLUSH) {
 		return -EINVAL;
 	}
@@ -272,6 +737,18 @@ int sensor_listener_proxy::set_attribute(int32_t attribute, const char *value, i
 
 	_D("Listener[%d] try to set string attribute[%d], len[%d]", get_id(), attribute, len);
 
+	if (attribute == SENSORD_ATTRIBUTE_DELTA_THRESHOLD) {
+		int count = len / sizeof(sensord_delta_threshold_s);
+
+		retv_if(len < 0 || len % sizeof(sensord_delta_threshold_s), -EINVAL);
+		retv_if(count > (int)VALUE_COUNT_MAX, -EINVAL);
+
+		const sensord_delta_threshold_s *thresholds =
+				reinterpret_cast<const sensord_delta_threshold_s *>(value);
+		m_filter.set_thresholds(thresholds, count);
+		return OP_SUCCESS;
+	}
+
 	int ret = sensor->set_attribute(this, attribute, value, len);
 	apply_sensor_handler_need_to_notify_attribute_changed(sensor);
 
@@ -285,6 +762,18 @@ int sensor_listener_proxy::get_attribute(int32_t attribute, char **value, int *l
 
 	_D("Listener[%d] try to get attribute str[%d]", get_id(), attribute);
 
+	if (attribute == SENSORD_ATTRIBUTE_DELTA_THRESHOLD) {
+		const std::vector<sensord_delta_threshold_s> &thresholds = m_filter.get_thresholds();
+
+		*len = thresholds.size() * sizeof(sensord_delta_threshold_s);
+		*value = new(std::nothrow) char[*len];
+		retvm_if(!*value, -ENOMEM, "Failed to allocate memory");
+
+		std::copy(thresholds.begin(), thresholds.end(),
+				reinterpret_cast<sensord_delta_threshold_s *>(*value));
+		return OP_SUCCESS;
+	}
+
 	return sensor->get_attribute(attribute, value, len);
 }
 
@@ -293,6 +782,12 @@ int sensor_listener_proxy::flush(void)
 	sensor_handler *sensor = m_manager->get_sensor(m_uri);
 	retv_if(!sensor, -EINVAL);
 
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (member)
+			member->flush(*it);
+	}
+
 	return sensor->flush(this);
 }
 
@@ -301,7 +796,24 @@ int sensor_listener_proxy::get_data(sensor_data_t **data, int *len)
 	sensor_handler *sensor = m_manager->get_sensor(m_uri);
 	retv_if(!sensor, -EINVAL);
 
-	return sensor->get_cache(data, len);
+	int ret = sensor->get_cache(data, len);
+	retv_if(ret < 0, ret);
+
+	int rotation = dbus_listener::get_display_rotation();
+	sensor_info info = sensor->get_sensor_info();
+
+	if (is_display_oriented() && axis::need_remap(info.get_type(), rotation))
+		axis::remap(rotation, *data, *len / sizeof(sensor_data_t));
+
+	return ret;
+}
+
+int sensor_listener_proxy::get_shared_fd(void)
+{
+	sensor_handler *sensor = m_manager->get_sensor(m_uri);
+	retv_if(!sensor, -EINVAL);
+
+	return sensor->get_shared_fd();
 }
 
 std::string sensor_listener_proxy::get_required_privileges(void)
@@ -310,21 +822,55 @@ std::string sensor_listener_proxy::get_required_privileges(void)
 	retv_if(!sensor, "");
 
 	sensor_info info = sensor->get_sensor_info();
-	return info.get_privilege();
+	std::string privileges = info.get_privilege();
+
+	/* a frame carries the samples of every member */
+	for (auto it = m_sync_members.begin(); it != m_sync_members.end(); ++it) {
+		sensor_handler *member = m_manager->get_sensor((*it)->get_uri());
+		if (!member)
+			continue;
+
+		sensor_info member_info = member->get_sensor_info();
+		if (member_info.get_privilege().empty())
+			continue;
+
+		if (!privileges.empty())
+			privileges.append(PRIV_DELIMITER);
+		privileges.append(member_info.get_privilege());
+	}
+
+	return privileges;
+}
+
+void sensor_listener_proxy::get_stats(cmd_listener_stats_t &stats)
+{
+	uint64_t sent;
+
+	stats.listener_id = m_id;
+	stats.started = m_started;
+	stats.events = m_stat_events.load(std::memory_order_relaxed);
+	stats.filtered = m_stat_filtered.load(std::memory_order_relaxed);
+	stats.interval = m_interval;
+	stats.effective_interval = m_stat_period.get() / 1000.0f;
+
+	m_ch->get_stats(sent, stats.bytes, stats.drops, stats.queue_depth);
 }
 
 void sensor_listener_proxy::on_policy_changed(int policy, int value)
 {
-	ret_if(m_started == false);
 	ret_if(policy != SENSORD_ATTRIBUTE_PAUSE_POLICY);
-	ret_if(m_pause_policy == SENSORD_PAUSE_NONE);
 
 	_D("power_save_state[%d], listener[%d] pause policy[%d]",
-			value, get_id(), m_pause_policy);
+			value, get_id(), m_pause.get_policy());
 
-	if (value & m_pause_policy)
+	apply_pause(m_pause.set_power_save_state(value));
+}
+
+void sensor_listener_proxy::apply_pause(int action)
+{
+	if (action == PAUSE_ACTION_STOP)
 		stop(true);
-	if (!(value & m_pause_policy))
+	else if (action == PAUSE_ACTION_RESUME)
 		start(true);
 }
 
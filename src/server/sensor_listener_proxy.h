@@ -22,13 +22,37 @@
 
 #include <channel.h>
 #include <message.h>
+#include <command_types.h>
+#include <atomic>
+#include <vector>
 
 #include "sensor_manager.h"
+#include "window_aggregator.h"
+#include "delivery_filter.h"
+#include "pause_state.h"
+#include "sample_synchronizer.h"
+#include "stat_period.h"
 #include "sensor_observer.h"
 #include "sensor_policy_listener.h"
 
 namespace sensor {
 
+class sensor_listener_proxy;
+
+/* another sensor of a synchronized listener, see sensord_connect_sync() */
+class sensor_sync_member : public sensor_observer {
+public:
+	sensor_sync_member(sensor_listener_proxy *proxy, int stream, std::string uri);
+
+	std::string get_uri(void);
+	int update(const char *uri, std::shared_ptr<ipc::message> msg);
+
+private:
+	sensor_listener_proxy *m_proxy;
+	int m_stream;
+	std::string m_uri;
+};
+
 class sensor_listener_proxy : public sensor_observer, sensor_policy_listener {
 public:
 	sensor_listener_proxy(uint32_t id,
@@ -36,10 +60,12 @@ public:
 	~sensor_listener_proxy();
 
 	uint32_t get_id(void);
+	std::string get_uri(void);
 
 	/* sensor observer */
 	int update(const char *uri, std::shared_ptr<ipc::message> msg);
 	int on_attribute_changed(std::shared_ptr<ipc::message> msg);
+	bool is_display_oriented(void);
 
 	int start(bool policy = false);
 	int stop(bool policy = false);
@@ -50,14 +76,21 @@ public:
 	int get_max_batch_latency(int32_t& max_batch_latency);
 	int delete_batch_latency(void);
 	int set_passive_mode(bool passive);
+	bool get_passive_mode(void);
 	int set_attribute(int32_t attribute, int32_t value);
 	int get_attribute(int32_t attribute, int32_t *value);
 	int set_attribute(int32_t attribute, const char *value, int len);
 	int get_attribute(int32_t attribute, char **value, int *len);
 	int flush(void);
 	int get_data(sensor_data_t **data, int *len);
+	int get_shared_fd(void);
 	std::string get_required_privileges(void);
 
+	int add_sync_sensor(std::string uri);
+	int update_sync(int stream, std::shared_ptr<ipc::message> msg);
+
+	void get_stats(cmd_listener_stats_t &stats);
+
 	/* sensor_policy_listener interface */
 	void on_policy_changed(int policy, int value);
 	bool notify_attribute_changed(int32_t attribute, int32_t value);
@@ -66,8 +99,16 @@ public:
 	void set_need_to_notify_attribute_changed(bool value);
 
 private:
+	std::shared_ptr<ipc::message> decimate(std::shared_ptr<ipc::message> msg);
+	bool decimate(const sensor_data_t &data, sensor_data_t &out);
+	void average(sensor_data_t &data);
+	void reset_decimation(void);
+	std::shared_ptr<ipc::message> aggregate(std::shared_ptr<ipc::message> msg);
+	int set_aggregation(int32_t attribute, int32_t value);
+	std::shared_ptr<ipc::message> filter(std::shared_ptr<ipc::message> msg);
+	int set_sync(int32_t attribute, int32_t value);
 	void update_event(std::shared_ptr<ipc::message> msg);
-	void update_accuracy(std::shared_ptr<ipc::message> msg);
+	void apply_pause(int action);
 	void apply_sensor_handler_need_to_notify_attribute_changed(sensor_handler* handler);
 
 	uint32_t m_id;
@@ -78,10 +119,40 @@ private:
 
 	bool m_started;
 	bool m_passive;
-	int32_t m_pause_policy;
+	pause_state m_pause;
 	int32_t m_axis_orientation;
-	int32_t m_last_accuracy;
 	bool m_need_to_notify_attribute_changed;
+
+	/* per-listener decimation of the shared sensor rate */
+	int32_t m_interval;
+	int32_t m_max_batch_latency;
+	int32_t m_decimation;
+	unsigned long long m_next_timestamp;
+	unsigned long long m_last_timestamp;
+	int m_avg_count;
+	double m_avg_sum[sizeof(sensor_data_t::values) / sizeof(float)];
+
+	/* per-listener windowed aggregation, in place of the decimation */
+	window_aggregator m_aggregator;
+	int32_t m_aggregation;
+	int32_t m_aggregation_window;
+	int32_t m_aggregation_hop;
+
+	/* per-listener delivery filter, after the decimation */
+	delivery_filter m_filter;
+	int32_t m_delivery;
+	int32_t m_heartbeat;
+
+	/* frames of this sensor and the members, in place of all the above */
+	std::vector<sensor_sync_member *> m_sync_members;
+	sample_synchronizer m_sync;
+	int32_t m_sync_mode;
+	int32_t m_sync_tolerance;
+
+	/* statistics of what was handed to the channel */
+	std::atomic<uint64_t> m_stat_events;
+	std::atomic<uint64_t> m_stat_filtered;
+	stat_period m_stat_period;
 };
 
 }
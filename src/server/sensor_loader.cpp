@@ -19,28 +19,46 @@
 
 #include "sensor_loader.h"
 
+#include <stdio.h>
 #include <dirent.h>
 #include <dlfcn.h>
 #include <fusion_sensor.h>
 #include <hal/hal-sensor.h>
+#include <hal/hal-common.h>
 #include <physical_sensor.h>
 #include <sensor_log.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <limits.h>
 
 #include <memory>
+#include <algorithm>
 
 using namespace sensor;
 
-sensor_loader::sensor_loader() {
-  if (hal_sensor_get_backend() != 0) {
-    _E("Failed to load hal sensor backend");
-  }
+#ifndef HAL_BACKEND_PATH
+#define HAL_BACKEND_PATH HAL_LIBDIR "/libhal-backend-sensor.so"
+#endif
+
+static void append_stamp(const std::string &path, std::string &stamp)
+{
+	struct stat buf;
+	char attr[64];
+
+	if (stat(path.c_str(), &buf) != 0) {
+		stamp += path + ",-";
+		return;
+	}
+
+	snprintf(attr, sizeof(attr), ",%lld,%lld", (long long)buf.st_size, (long long)buf.st_mtime);
+	stamp += path + attr;
 }
 
+sensor_loader::sensor_loader() : m_hal_backend(false) {}
+
 sensor_loader::~sensor_loader() {
-  if (hal_sensor_put_backend() != 0) {
+  if (m_hal_backend && hal_sensor_put_backend() != 0) {
     _E("Failed to clear hal sensor backend");
   }
 }
@@ -48,6 +66,14 @@ sensor_loader::~sensor_loader() {
 void sensor_loader::load_hal(device_sensor_registry_t &devices) {
   void **results = nullptr;
 
+  /* the backend is bound on first use, not when the daemon starts */
+  if (!m_hal_backend) {
+    if (hal_sensor_get_backend() != 0)
+      _E("Failed to load hal sensor backend");
+    else
+      m_hal_backend = true;
+  }
+
   int size = hal_sensor_create(&results);
   if (size <= 0 || !results) {
     _E("Failed to get sensor from hal sensor backend");
@@ -128,6 +154,41 @@ bool sensor_loader::load(const std::string &dir_path, std::vector<std::shared_pt
 	return true;
 }
 
+/* Appends the path, size and mtime of every module in the directory,
+ * which changes whenever a module is installed, removed or updated */
+void sensor_loader::get_modules_stamp(const std::string &dir_path, std::string &stamp)
+{
+	std::vector<std::string> module_paths;
+
+	stamp += dir_path + ":";
+
+	if (access(dir_path.c_str(), F_OK) != 0 || !get_module_paths(dir_path, module_paths)) {
+		stamp += "-;";
+		return;
+	}
+
+	std::sort(module_paths.begin(), module_paths.end());
+
+	for (auto &path : module_paths)
+		append_stamp(path, stamp);
+
+	stamp += ";";
+}
+
+/* The backend of hal-api-sensor is updated apart from the sensor modules,
+ * a new one may come with other sensors */
+void sensor_loader::get_hal_stamp(std::string &stamp)
+{
+	char path[PATH_MAX] = {0, };
+
+	if (hal_common_get_backend_library_name(HAL_MODULE_SENSOR, path, sizeof(path)) != 0 || !path[0])
+		snprintf(path, sizeof(path), "%s", HAL_BACKEND_PATH);
+
+	stamp += "hal:";
+	append_stamp(path, stamp);
+	stamp += ";";
+}
+
 bool sensor_loader::get_module_paths(const std::string &dir_path, std::vector<std::string> &paths)
 {
 	DIR *dir = NULL;
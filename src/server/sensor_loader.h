@@ -48,6 +48,9 @@ public:
 
 	void unload(void);
 
+	void get_modules_stamp(const std::string &dir_path, std::string &stamp);
+	void get_hal_stamp(std::string &stamp);
+
 private:
 	template<typename T>
 	bool load(const std::string &path, std::vector<std::shared_ptr<T>> &sensors);
@@ -55,6 +58,7 @@ private:
 	bool get_module_paths(const std::string &dir_path, std::vector<std::string> &paths);
 
 	std::map<std::string, void *> m_modules;
+	bool m_hal_backend;
 };
 
 }
@@ -44,6 +44,10 @@ using namespace sensor;
 #define VIRTUAL_SENSOR_DIR_PATH LIBDIR "/sensor/fusion"
 #define EXTERNAL_SENSOR_DIR_PATH LIBDIR "/sensor/external"
 
+#ifndef SENSOR_MANIFEST_PATH
+#define SENSOR_MANIFEST_PATH "/var/cache/sensord/sensors.manifest"
+#endif
+
 static device_sensor_registry_t devices;
 static physical_sensor_registry_t physical_sensors;
 static fusion_sensor_registry_t fusion_sensors;
@@ -51,7 +55,11 @@ static external_sensor_registry_t external_sensors;
 
 sensor_manager::sensor_manager(ipc::event_loop *loop)
 : m_loop(loop)
+, m_lazy(false)
+, m_manifest(SENSOR_MANIFEST_PATH)
 {
+	for (int i = 0; i < SENSOR_GROUP_MAX; ++i)
+		m_loaded[i] = false;
 }
 
 sensor_manager::~sensor_manager()
@@ -60,33 +68,173 @@ sensor_manager::~sensor_manager()
 
 bool sensor_manager::init(void)
 {
-	m_loader.load_hal(devices);
-	m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY1, devices);
-	m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY2, devices);
-	m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY3, devices);
-	m_loader.load_physical_sensor(PHYSICAL_SENSOR_DIR_PATH, physical_sensors);
-	m_loader.load_fusion_sensor(VIRTUAL_SENSOR_DIR_PATH, fusion_sensors);
-	m_loader.load_external_sensor(EXTERNAL_SENSOR_DIR_PATH, external_sensors);
-
-	retvm_if(devices.empty() && external_sensors.empty(), false, "There is no sensors");
+#ifdef LAZY_LOADING
+	/* advertise the cached descriptors, the modules are loaded on first use */
+	if (load_manifest()) {
+		show();
+		return true;
+	}
+#endif
 
 	/* TODO: support dynamic sensor */
-	create_physical_sensors(devices, physical_sensors);
-	create_fusion_sensors(fusion_sensors);
-	create_external_sensors(external_sensors);
+	for (int i = 0; i < SENSOR_GROUP_MAX; ++i)
+		load_group(i);
 
-	init_sensors();
+	retvm_if(devices.empty() && external_sensors.empty(), false, "There is no sensors");
+
+#ifdef LAZY_LOADING
+	store_manifest();
+#endif
 
 	show();
 
 	return true;
 }
 
+/* Loads the modules of a group once. If the group was advertised from
+ * the manifest, the cached descriptors are replaced by the real sensors
+ * and clients are told about any difference */
+void sensor_manager::load_group(int group)
+{
+	ret_if(group < 0 || group >= SENSOR_GROUP_MAX);
+	ret_if(m_loaded[group]);
+	m_loaded[group] = true;
+
+	/* fusion sensors are built on top of the device sensors */
+	if (group == SENSOR_GROUP_FUSION)
+		load_group(SENSOR_GROUP_DEVICE);
+
+	load_sensors(group);
+
+	ret_if(!m_lazy);
+
+	bool changed = false;
+
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
+		if (get_group(it->second) != group)
+			continue;
+		if (m_lazy_sensors.find(it->first) != m_lazy_sensors.end())
+			continue;
+
+		sensor_info info = it->second->get_sensor_info();
+		send_added_msg(&info);
+		changed = true;
+	}
+
+	for (auto it = m_lazy_sensors.begin(); it != m_lazy_sensors.end();) {
+		if (it->second.group != group) {
+			++it;
+			continue;
+		}
+
+		if (m_sensors.find(it->first) == m_sensors.end()) {
+			send_removed_msg(it->first);
+			changed = true;
+		}
+
+		it = m_lazy_sensors.erase(it);
+	}
+
+	_I("Loaded sensor group[%d] on demand", group);
+
+	if (changed)
+		store_manifest();
+}
+
+void sensor_manager::load_sensors(int group)
+{
+	switch (group) {
+	case SENSOR_GROUP_DEVICE:
+		m_loader.load_hal(devices);
+		m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY1, devices);
+		m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY2, devices);
+		m_loader.load_hal_legacy(DEVICE_HAL_DIR_PATH_LEGACY3, devices);
+		m_loader.load_physical_sensor(PHYSICAL_SENSOR_DIR_PATH, physical_sensors);
+		create_physical_sensors(devices, physical_sensors);
+		break;
+	case SENSOR_GROUP_FUSION:
+		m_loader.load_fusion_sensor(VIRTUAL_SENSOR_DIR_PATH, fusion_sensors);
+		create_fusion_sensors(fusion_sensors);
+		break;
+	case SENSOR_GROUP_EXTERNAL:
+		m_loader.load_external_sensor(EXTERNAL_SENSOR_DIR_PATH, external_sensors);
+		create_external_sensors(external_sensors);
+		break;
+	default:
+		break;
+	}
+}
+
+int sensor_manager::get_group(sensor_handler *sensor)
+{
+	if (dynamic_cast<physical_sensor_handler *>(sensor))
+		return SENSOR_GROUP_DEVICE;
+	if (dynamic_cast<fusion_sensor_handler *>(sensor))
+		return SENSOR_GROUP_FUSION;
+	if (dynamic_cast<external_sensor_handler *>(sensor))
+		return SENSOR_GROUP_EXTERNAL;
+
+	/* application sensors come and go with their providers */
+	return -1;
+}
+
+void sensor_manager::get_modules_stamp(std::string &stamp)
+{
+	m_loader.get_hal_stamp(stamp);
+	m_loader.get_modules_stamp(DEVICE_HAL_DIR_PATH_LEGACY1, stamp);
+	m_loader.get_modules_stamp(DEVICE_HAL_DIR_PATH_LEGACY2, stamp);
+	m_loader.get_modules_stamp(DEVICE_HAL_DIR_PATH_LEGACY3, stamp);
+	m_loader.get_modules_stamp(PHYSICAL_SENSOR_DIR_PATH, stamp);
+	m_loader.get_modules_stamp(VIRTUAL_SENSOR_DIR_PATH, stamp);
+	m_loader.get_modules_stamp(EXTERNAL_SENSOR_DIR_PATH, stamp);
+}
+
+bool sensor_manager::load_manifest(void)
+{
+	std::vector<manifest_entry> entries;
+	std::string stamp;
+
+	get_modules_stamp(stamp);
+	retv_if(!m_manifest.read(stamp, entries), false);
+
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+		m_lazy_sensors[it->info.get_uri()] = *it;
+
+	m_lazy = true;
+
+	_I("Deferred loading of %zu sensors", m_lazy_sensors.size());
+	return true;
+}
+
+void sensor_manager::store_manifest(void)
+{
+	std::vector<manifest_entry> entries;
+	std::string stamp;
+
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
+		manifest_entry entry;
+
+		entry.group = get_group(it->second);
+		if (entry.group < 0)
+			continue;
+
+		entry.info = it->second->get_sensor_info();
+		entries.push_back(entry);
+	}
+
+	for (auto it = m_lazy_sensors.begin(); it != m_lazy_sensors.end(); ++it)
+		entries.push_back(it->second);
+
+	get_modules_stamp(stamp);
+	m_manifest.write(stamp, entries);
+}
+
 bool sensor_manager::deinit(void)
 {
 	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it)
 		delete it->second;
 	m_sensors.clear();
+	m_lazy_sensors.clear();
 
 	external_sensors.clear();
 	fusion_sensors.clear();
@@ -107,7 +255,7 @@ bool sensor_manager::is_supported(std::string uri)
 			return true;
 	}
 
-	return false;
+	return (m_lazy_sensors.find(uri) != m_lazy_sensors.end());
 }
 
 int sensor_manager::serialize(sensor_info *info, char **bytes)
@@ -169,6 +317,8 @@ bool sensor_manager::register_sensor(sensor_handler *sensor)
 
 	auto it = m_sensors.find(info.get_uri());
 	retvm_if(it != m_sensors.end(), false, "There is already a sensor with the same name");
+	retvm_if(m_lazy_sensors.find(info.get_uri()) != m_lazy_sensors.end(), false,
+			"There is already a sensor with the same name");
 
 	m_sensors[info.get_uri()] = sensor;
 
@@ -210,18 +360,32 @@ void sensor_manager::deregister_channel(ipc::channel *ch)
 	}
 }
 
+static bool is_type_of(const std::string &uri, const std::string &type_uri)
+{
+	if (uri == type_uri)
+		return true;
+
+	std::size_t found = uri.find_last_of("/");
+	if (found == std::string::npos)
+		return false;
+
+	return (uri.substr(0, found) == type_uri);
+}
+
 sensor_handler *sensor_manager::get_sensor_by_type(const std::string uri)
 {
 	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
-		if (it->first == uri)
+		if (is_type_of(it->first, uri))
 			return it->second;
+	}
 
-		std::size_t found = it->first.find_last_of("/");
-		if (found == std::string::npos)
+	/* the sensor is known from the manifest, but its modules are not loaded yet */
+	for (auto it = m_lazy_sensors.begin(); it != m_lazy_sensors.end(); ++it) {
+		if (!is_type_of(it->first, uri) || m_loaded[it->second.group])
 			continue;
 
-		if (it->first.substr(0, found) == uri)
-			return it->second;
+		load_group(it->second.group);
+		return get_sensor_by_type(uri);
 	}
 
 	return NULL;
@@ -230,9 +394,19 @@ sensor_handler *sensor_manager::get_sensor_by_type(const std::string uri)
 sensor_handler *sensor_manager::get_sensor(const std::string uri)
 {
 	auto it = m_sensors.find(uri);
-	retv_if(it == m_sensors.end(), NULL);
 
-	return m_sensors[uri];
+	if (it == m_sensors.end()) {
+		auto lazy = m_lazy_sensors.find(uri);
+		retv_if(lazy == m_lazy_sensors.end(), NULL);
+
+		/* the first listener of the sensor pays for loading its modules */
+		load_group(lazy->second.group);
+
+		it = m_sensors.find(uri);
+		retv_if(it == m_sensors.end(), NULL);
+	}
+
+	return it->second;
 }
 
 std::vector<sensor_handler *> sensor_manager::get_sensors(void)
@@ -280,6 +454,9 @@ void sensor_manager::create_physical_sensors(device_sensor_registry_t &devices,
 			retm_if(!psensor, "Failed to allocate memory");
 
 			m_sensors[uri] = psensor;
+
+			/* it doesn't need to deregister handlers, they are consumed in event_loop */
+			register_handler(psensor);
 		}
 	}
 }
@@ -336,6 +513,8 @@ void sensor_manager::create_external_sensors(external_sensor_registry_t &esensor
 
 		sensor_info sinfo = esensor->get_sensor_info();
 		m_sensors[sinfo.get_uri()] = esensor;
+
+		register_handler(esensor);
 	}
 }
 
@@ -349,6 +528,19 @@ static void put_int_to_vec(std::vector<char> &data, int value)
 	std::copy(&buf[0], &buf[sizeof(buf)], back_inserter(data));
 }
 
+static void put_info_to_vec(std::vector<char> &data, sensor_info &info)
+{
+	raw_data_t raw;
+
+	info.serialize(raw);
+
+	/* copy size */
+	put_int_to_vec(data, raw.size());
+
+	/* copy info */
+	std::copy(raw.begin(), raw.end(), std::back_inserter(data));
+}
+
 /* TODO: remove socket fd parameter */
 /* packet format :
  * [count:4] {[size:4] [info:n] [size:4] [info:n] ...}
@@ -358,25 +550,16 @@ size_t sensor_manager::serialize(int sock_fd, char **bytes)
 	sensor_info info;
 	std::vector<char> raw_list;
 
-	put_int_to_vec(raw_list, m_sensors.size());
+	put_int_to_vec(raw_list, m_sensors.size() + m_lazy_sensors.size());
 
 	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
 		info = it->second->get_sensor_info();
-
-		raw_data_t *raw = new(std::nothrow) raw_data_t();
-		retvm_if(!raw, -ENOMEM, "Failed to allocated memory");
-
-		info.serialize(*raw);
-
-		/* copy size */
-		put_int_to_vec(raw_list, raw->size());
-
-		/* copy info */
-		std::copy(raw->begin(), raw->end(), std::back_inserter(raw_list));
-
-		delete raw;
+		put_info_to_vec(raw_list, info);
 	}
 
+	for (auto it = m_lazy_sensors.begin(); it != m_lazy_sensors.end(); ++it)
+		put_info_to_vec(raw_list, it->second.info);
+
 	*bytes = new(std::nothrow) char[raw_list.size()];
 	retvm_if(!*bytes, -ENOMEM, "Failed to allocate memory");
 
@@ -385,20 +568,6 @@ size_t sensor_manager::serialize(int sock_fd, char **bytes)
 	return raw_list.size();
 }
 
-void sensor_manager::init_sensors(void)
-{
-	physical_sensor_handler *sensor;
-
-	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
-		sensor = dynamic_cast<physical_sensor_handler *>(it->second);
-		if (sensor == NULL)
-			continue;
-
-		/* it doesn't need to deregister handlers, they are consumed in event_loop */
-		register_handler(sensor);
-	}
-}
-
 void sensor_manager::register_handler(physical_sensor_handler *sensor)
 {
 	sensor_event_handler *handler = NULL;
@@ -419,7 +588,8 @@ void sensor_manager::register_handler(physical_sensor_handler *sensor)
 	handler->add_sensor(sensor);
 	m_event_handlers[fd] = handler;
 
-	if (m_loop->add_event(fd, ipc::EVENT_IN | ipc::EVENT_HUP | ipc::EVENT_NVAL, handler) == 0) {
+	if (m_loop->add_event(fd, ipc::EVENT_IN | ipc::EVENT_HUP | ipc::EVENT_NVAL, handler,
+			ipc::EVENT_PRIORITY_INGEST) == 0) {
 		_D("Failed to add sensor event handler");
 		handler->remove_sensor(sensor);
 
@@ -431,6 +601,23 @@ void sensor_manager::register_handler(physical_sensor_handler *sensor)
 	}
 }
 
+void sensor_manager::register_handler(external_sensor_handler *sensor)
+{
+	external_sensor_event_handler *handler = NULL;
+	int fd = sensor->get_event_fd();
+
+	ret_if(fd < 0);
+
+	handler = new(std::nothrow) external_sensor_event_handler(sensor);
+	retm_if(!handler, "Failed to allocate memory");
+
+	if (m_loop->add_event(fd, ipc::EVENT_IN | ipc::EVENT_HUP | ipc::EVENT_NVAL, handler,
+			ipc::EVENT_PRIORITY_INGEST) == 0) {
+		_E("Failed to add external sensor event handler");
+		delete handler;
+	}
+}
+
 void sensor_manager::show(void)
 {
 	int index = 0;
@@ -442,5 +629,10 @@ void sensor_manager::show(void)
 		_I("Sensor #%d[%s]: ", ++index, it->first.c_str());
 		info.show();
 	}
+
+	for (auto it = m_lazy_sensors.begin(); it != m_lazy_sensors.end(); ++it) {
+		_I("Sensor #%d[%s]: not loaded yet", ++index, it->first.c_str());
+		it->second.info.show();
+	}
 	_I("===============================================\n");
 }
@@ -30,6 +30,7 @@
 #include "sensor_handler.h"
 #include "sensor_observer.h"
 #include "sensor_loader.h"
+#include "sensor_manifest.h"
 
 #include "physical_sensor_handler.h"
 #include "fusion_sensor_handler.h"
@@ -69,8 +70,16 @@ private:
 	void create_fusion_sensors(fusion_sensor_registry_t &vsensors);
 	void create_external_sensors(external_sensor_registry_t &vsensors);
 
-	void init_sensors(void);
+	bool load_manifest(void);
+	void store_manifest(void);
+	void get_modules_stamp(std::string &stamp);
+
+	void load_group(int group);
+	void load_sensors(int group);
+	int get_group(sensor_handler *sensor);
+
 	void register_handler(physical_sensor_handler *sensor);
+	void register_handler(external_sensor_handler *sensor);
 
 	int serialize(sensor_info *info, char **bytes);
 
@@ -84,6 +93,12 @@ private:
 	sensor_loader m_loader;
 	sensor_map_t m_sensors;
 
+	/* sensors advertised from the manifest, whose modules are not loaded yet */
+	std::map<std::string, manifest_entry> m_lazy_sensors;
+	bool m_loaded[SENSOR_GROUP_MAX];
+	bool m_lazy;
+	sensor_manifest m_manifest;
+
 	std::vector<ipc::channel *> m_channels;
 	std::map<int, sensor_event_handler *> m_event_handlers;
 };
@@ -0,0 +1,143 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "sensor_manifest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sensor_log.h>
+
+#define MANIFEST_MAGIC 0x4d534e53 /* "SNSM" */
+#define MANIFEST_VERSION 1
+#define MANIFEST_MAX_INFO_SIZE (16 * 1024)
+
+using namespace sensor;
+
+static bool read_int(FILE *fp, int &value)
+{
+	return (fread(&value, sizeof(value), 1, fp) == 1);
+}
+
+static bool write_int(FILE *fp, int value)
+{
+	return (fwrite(&value, sizeof(value), 1, fp) == 1);
+}
+
+sensor_manifest::sensor_manifest(const std::string &path)
+: m_path(path)
+{
+}
+
+/* packet format :
+ * [magic:4] [version:4] [size:4] [stamp:n] [count:4]
+ * {[group:4] [size:4] [info:n] [group:4] [size:4] [info:n] ...}
+ */
+bool sensor_manifest::read(const std::string &stamp, std::vector<manifest_entry> &entries)
+{
+	int magic, version, size, count;
+	bool ret = false;
+
+	FILE *fp = fopen(m_path.c_str(), "rb");
+	retvm_if(!fp, false, "There is no sensor manifest[%s]", m_path.c_str());
+
+	std::vector<char> buf;
+
+	if (!read_int(fp, magic) || magic != MANIFEST_MAGIC)
+		goto out;
+	if (!read_int(fp, version) || version != MANIFEST_VERSION)
+		goto out;
+
+	/* modules were added, removed or updated since the manifest was written */
+	if (!read_int(fp, size) || size != (int)stamp.size())
+		goto out;
+	buf.resize(size);
+	if (size > 0 && fread(buf.data(), size, 1, fp) != 1)
+		goto out;
+	if (stamp.compare(0, std::string::npos, buf.data(), size) != 0)
+		goto out;
+
+	if (!read_int(fp, count) || count <= 0)
+		goto out;
+
+	for (int i = 0; i < count; ++i) {
+		manifest_entry entry;
+
+		if (!read_int(fp, entry.group) || entry.group < 0 || entry.group >= SENSOR_GROUP_MAX)
+			goto out;
+		if (!read_int(fp, size) || size <= 0 || size > MANIFEST_MAX_INFO_SIZE)
+			goto out;
+
+		buf.resize(size);
+		if (fread(buf.data(), size, 1, fp) != 1)
+			goto out;
+
+		entry.info.deserialize(buf.data(), size);
+		entries.push_back(entry);
+	}
+
+	ret = true;
+
+out:
+	fclose(fp);
+
+	if (!ret) {
+		entries.clear();
+		_W("Sensor manifest[%s] is outdated or broken", m_path.c_str());
+	}
+
+	return ret;
+}
+
+bool sensor_manifest::write(const std::string &stamp, std::vector<manifest_entry> &entries)
+{
+	bool ret = true;
+	std::string temp = m_path + ".tmp";
+
+	FILE *fp = fopen(temp.c_str(), "wb");
+	retvm_if(!fp, false, "Failed to open sensor manifest[%s]", temp.c_str());
+
+	ret &= write_int(fp, MANIFEST_MAGIC);
+	ret &= write_int(fp, MANIFEST_VERSION);
+	ret &= write_int(fp, stamp.size());
+	if (!stamp.empty())
+		ret &= (fwrite(stamp.data(), stamp.size(), 1, fp) == 1);
+	ret &= write_int(fp, entries.size());
+
+	for (auto it = entries.begin(); it != entries.end(); ++it) {
+		raw_data_t raw;
+		it->info.serialize(raw);
+
+		ret &= write_int(fp, it->group);
+		ret &= write_int(fp, raw.size());
+		ret &= (fwrite(raw.data(), raw.size(), 1, fp) == 1);
+	}
+
+	if (fclose(fp) != 0)
+		ret = false;
+
+	/* replace the old manifest at once, a reader never sees a partial file */
+	if (!ret || rename(temp.c_str(), m_path.c_str()) != 0) {
+		_E("Failed to write sensor manifest[%s]", m_path.c_str());
+		remove(temp.c_str());
+		return false;
+	}
+
+	_I("Wrote %zu sensors to manifest[%s]", entries.size(), m_path.c_str());
+	return true;
+}
@@ -0,0 +1,57 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SENSOR_MANIFEST_H__
+#define __SENSOR_MANIFEST_H__
+
+#include <sensor_info.h>
+#include <string>
+#include <vector>
+
+namespace sensor {
+
+/* sensors that are loaded together, from the same set of modules */
+enum sensor_group_e {
+	SENSOR_GROUP_DEVICE = 0,	/* HAL backends, legacy HALs and physical plugins */
+	SENSOR_GROUP_FUSION,
+	SENSOR_GROUP_EXTERNAL,
+	SENSOR_GROUP_MAX,
+};
+
+typedef struct manifest_entry {
+	int group;
+	sensor_info info;
+} manifest_entry;
+
+/* Cached descriptors of the sensors found by the last full load,
+ * so that they can be advertised before any module is loaded */
+class sensor_manifest {
+public:
+	sensor_manifest(const std::string &path);
+
+	bool read(const std::string &stamp, std::vector<manifest_entry> &entries);
+	bool write(const std::string &stamp, std::vector<manifest_entry> &entries);
+
+private:
+	std::string m_path;
+};
+
+}
+
+#endif /* __SENSOR_MANIFEST_H__ */
@@ -29,6 +29,12 @@ public:
 	virtual ~sensor_observer() {}
 
 	virtual int update(const char *uri, std::shared_ptr<ipc::message> msg) = 0;
+
+	/* the sensor notified all the events it read at once */
+	virtual void update_done(void) {}
+
+	/* whether samples should be remapped to the display rotation */
+	virtual bool is_display_oriented(void) { return false; }
 };
 
 }
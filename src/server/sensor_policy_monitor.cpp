@@ -61,6 +61,7 @@ sensor_policy_monitor& sensor_policy_monitor::get_instance(void)
 }
 
 sensor_policy_monitor::sensor_policy_monitor()
+: m_power_save_state(get_power_save_state())
 {
 	int ret = vconf_notify_key_changed(VCONFKEY_PM_STATE, power_save_state_cb, NULL);
 	if (ret != 0) {
@@ -84,26 +85,64 @@ sensor_policy_monitor::~sensor_policy_monitor()
 	}
 }
 
-void sensor_policy_monitor::add_listener(sensor_policy_listener *listener)
+void sensor_policy_monitor::add_listener(sensor_policy_listener *listener, int pause_policy)
 {
 	ret_if(!listener);
 
-	m_listeners.insert(listener);
+	int bucket = pause_policy & SENSORD_PAUSE_ALL;
+
+	if (m_buckets[bucket].add(listener))
+		m_policies[listener] = bucket;
 }
 
 void sensor_policy_monitor::remove_listener(sensor_policy_listener *listener)
 {
 	ret_if(!listener);
 
-	m_listeners.erase(listener);
+	auto it = m_policies.find(listener);
+	ret_if(it == m_policies.end());
+
+	m_buckets[it->second].remove(listener);
+	m_policies.erase(it);
 }
 
-void sensor_policy_monitor::on_policy_changed(int policy, int value)
+/* The listener is brought in line with the current state right away, or it
+ * would stay paused until the part of the state its new policy covers changed */
+void sensor_policy_monitor::set_pause_policy(sensor_policy_listener *listener, int pause_policy)
 {
-	auto it = m_listeners.begin();
+	auto it = m_policies.find(listener);
+	ret_if(it == m_policies.end());
+
+	int bucket = pause_policy & SENSORD_PAUSE_ALL;
+	ret_if(it->second == bucket);
 
-	while (it != m_listeners.end()) {
+	m_buckets[it->second].remove(listener);
+	m_buckets[bucket].add(listener);
+	it->second = bucket;
+
+	listener->on_policy_changed(SENSORD_ATTRIBUTE_PAUSE_POLICY, m_power_save_state);
+}
+
+void sensor_policy_monitor::notify(int bucket, int policy, int value)
+{
+	for (auto it = m_buckets[bucket].begin(); it != m_buckets[bucket].end(); ++it)
 		(*it)->on_policy_changed(policy, value);
-		++it;
+}
+
+void sensor_policy_monitor::on_policy_changed(int policy, int value)
+{
+	if (policy != SENSORD_ATTRIBUTE_PAUSE_POLICY) {
+		for (int bucket = 0; bucket < SENSORD_PAUSE_END; ++bucket)
+			notify(bucket, policy, value);
+		return;
+	}
+
+	int changed = m_power_save_state ^ value;
+	m_power_save_state = value;
+
+	/* the listeners that never pause are left alone */
+	for (int bucket = SENSORD_PAUSE_NONE + 1; bucket < SENSORD_PAUSE_END; ++bucket) {
+		if (bucket & changed)
+			notify(bucket, policy, value);
 	}
 }
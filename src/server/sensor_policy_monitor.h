@@ -23,9 +23,11 @@
 #include <channel.h>
 #include <message.h>
 #include <vconf.h>
-#include <set>
+#include <sensor_types.h>
+#include <unordered_map>
 
 #include "sensor_policy_listener.h"
+#include "observer_vector.h"
 
 namespace sensor {
 
@@ -35,15 +37,22 @@ public:
 
 	static sensor_policy_monitor& get_instance(void);
 
-	void add_listener(sensor_policy_listener *listener);
+	void add_listener(sensor_policy_listener *listener, int pause_policy);
 	void remove_listener(sensor_policy_listener *listener);
+	void set_pause_policy(sensor_policy_listener *listener, int pause_policy);
 
 	void on_policy_changed(int policy, int value);
 
 private:
 	sensor_policy_monitor();
 
-	std::set<sensor_policy_listener *> m_listeners;
+	void notify(int bucket, int policy, int value);
+
+	/* listeners by their pause policy, so that a change of the power save
+	 * state reaches only the listeners whose policy covers what changed */
+	observer_vector<sensor_policy_listener, sensor_policy_listener> m_buckets[SENSORD_PAUSE_END];
+	std::unordered_map<sensor_policy_listener *, int> m_policies;
+	int m_power_save_state;
 };
 
 }
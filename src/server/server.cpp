@@ -19,8 +19,10 @@
 
 #include "server.h"
 
+#include <stdlib.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
 #include <systemd/sd-daemon.h>
 #include <sensor_log.h>
 #include <command_types.h>
@@ -28,13 +30,27 @@
 
 #include "sensor_manager.h"
 #include "server_channel_handler.h"
+#include "dbus_listener.h"
 
 #define MAX_CONFIG_PATH 255
 #define CAL_CONFIG_PATH "/etc/sensor_cal.conf"
 #define SET_CAL 1
 //#define CAL_NODE_PATH "/sys/class/sensors/ssp_sensor/set_cal_data"
 
-#define MAX_CONNECTION 1000
+/* the limit of client connections, overridden by the environment */
+#define MAX_CONNECTION_ENV "SENSORD_MAX_CONNECTIONS"
+#ifndef MAX_CONNECTION
+#define MAX_CONNECTION 32768
+#endif
+
+/* fds besides the connections: HAL nodes, modules, timers and logs */
+#define RESERVED_FDS 128
+
+/* dispatches per loop iteration of each scheduling class, see event_priority_e */
+#define INGEST_BUDGET 32
+#define DELIVERY_BUDGET 64
+#define CONTROL_BUDGET 8
+#define HOUSEKEEPING_BUDGET 4
 
 using namespace sensor;
 
@@ -85,9 +101,16 @@ bool server::init(void)
 	m_handler = new(std::nothrow) server_channel_handler(m_manager);
 	retvm_if(!m_handler, false, "Failed to allocate memory");
 
+	m_loop.set_budget(ipc::EVENT_PRIORITY_INGEST, INGEST_BUDGET);
+	m_loop.set_budget(ipc::EVENT_PRIORITY_DELIVERY, DELIVERY_BUDGET);
+	m_loop.set_budget(ipc::EVENT_PRIORITY_CONTROL, CONTROL_BUDGET);
+	m_loop.set_budget(ipc::EVENT_PRIORITY_HOUSEKEEPING, HOUSEKEEPING_BUDGET);
+
 	init_calibration();
 	init_server();
 
+	dbus_listener::init();
+
 	is_running.store(true);
 	sd_notify(0, "READY=1");
 
@@ -146,12 +169,55 @@ void server::init_calibration(void)
 	fclose(fp);
 }
 
+static int get_max_connection(void)
+{
+	const char *value = getenv(MAX_CONNECTION_ENV);
+	int max_connection;
+
+	retv_if(!value, MAX_CONNECTION);
+
+	max_connection = atoi(value);
+	retvm_if(max_connection <= 0, MAX_CONNECTION, "Invalid %s[%s]", MAX_CONNECTION_ENV, value);
+
+	return max_connection;
+}
+
+/* every connection takes an fd, so the soft limit of open files has to
+ * follow the connection limit, up to what the hard limit allows */
+static int raise_fd_limit(int max_connection)
+{
+	struct rlimit limit;
+	rlim_t needed = (rlim_t)max_connection + RESERVED_FDS;
+
+	retvm_if(getrlimit(RLIMIT_NOFILE, &limit) != 0, max_connection, "Failed to get fd limit");
+
+	if (limit.rlim_cur < needed) {
+		struct rlimit raised = limit;
+		raised.rlim_cur = (limit.rlim_max < needed) ? limit.rlim_max : needed;
+
+		if (setrlimit(RLIMIT_NOFILE, &raised) == 0)
+			limit = raised;
+		else
+			_E("Failed to raise fd limit to %llu", (unsigned long long)raised.rlim_cur);
+	}
+
+	if (limit.rlim_cur < needed) {
+		max_connection = (limit.rlim_cur > RESERVED_FDS) ? (int)(limit.rlim_cur - RESERVED_FDS) : 1;
+		_W("Connections are limited to %d by the fd limit", max_connection);
+	}
+
+	return max_connection;
+}
+
 void server::init_server(void)
 {
 	m_manager->init();
 
+	int max_connection = raise_fd_limit(get_max_connection());
+	_I("Max connections[%d]", max_connection);
+
 	/* TODO: setting socket option */
-	m_server->set_option("max_connection", MAX_CONNECTION);
+	m_server->set_option("max_connection", max_connection);
 	m_server->set_option(SO_TYPE, SOCK_STREAM);
 	m_server->bind(m_handler, &m_loop);
 }
@@ -19,12 +19,17 @@
 
 #include "server_channel_handler.h"
 
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
 #include <sensor_log.h>
 #include <sensor_info.h>
 #include <sensor_handler.h>
 #include <sensor_utils.h>
 #include <sensor_types_private.h>
 #include <command_types.h>
+#include <latency_histogram.h>
 #include <event_loop.h>
 
 #include "permission_checker.h"
@@ -34,8 +39,6 @@ using namespace sensor;
 using namespace ipc;
 
 /* TODO */
-std::unordered_map<uint32_t, sensor_listener_proxy *> server_channel_handler::m_listeners;
-std::unordered_map<ipc::channel *, uint32_t> server_channel_handler::m_listener_ids;
 std::unordered_map<ipc::channel *, application_sensor_handler *> server_channel_handler::m_app_sensors;
 
 server_channel_handler::server_channel_handler(sensor_manager *manager)
@@ -68,17 +71,16 @@ void server_channel_handler::disconnected(channel *ch)
 		m_app_sensors.erase(ch);
 	}
 
-	auto it_listener = m_listener_ids.find(ch);
-	if (it_listener != m_listener_ids.end()) {
-		_I("Disconnected listener[%u]", it_listener->second);
+	uint32_t id = m_listeners.find(ch);
+	if (id) {
+		_I("Disconnected listener[%u]", id);
 
-		delete m_listeners[it_listener->second];
-		m_listeners.erase(it_listener->second);
-		m_listener_ids.erase(ch);
+		delete m_listeners.get(id);
+		m_listeners.release(id);
 	}
 
 	if (ch->loop()) {
-		ch->loop()->add_idle_event(0, [](size_t, void* data) {
+		ch->loop()->add_idle_event(EVENT_PRIORITY_HOUSEKEEPING, [](size_t, void* data) {
 			channel* c = (channel*)data;
 			delete c;
 		},  ch);
@@ -114,12 +116,18 @@ void server_channel_handler::read(channel *ch, message &msg)
 		err = listener_get_attr_str(ch, msg); break;
 	case CMD_LISTENER_GET_DATA_LIST:
 		err = listener_get_data_list(ch, msg); break;
+	case CMD_LISTENER_GET_DATA_FD:
+		err = listener_get_data_fd(ch, msg); break;
+	case CMD_LISTENER_ADD_SYNC_SENSOR:
+		err = listener_add_sync_sensor(ch, msg); break;
 	case CMD_PROVIDER_CONNECT:
 		err = provider_connect(ch, msg); break;
 	case CMD_PROVIDER_PUBLISH:
 		err = provider_publish(ch, msg); break;
 	case CMD_HAS_PRIVILEGE:
 		err = has_privileges(ch, msg); break;
+	case CMD_GET_STATS:
+		err = get_stats(ch, msg); break;
 	default: break;
 	}
 
@@ -155,18 +163,28 @@ int server_channel_handler::manager_get_sensor_list(channel *ch, message &msg)
 
 int server_channel_handler::listener_connect(channel *ch, message &msg)
 {
-	static uint32_t listener_id = 1;
 	cmd_listener_connect_t buf;
 
 	msg.disclose((char *)&buf, sizeof(buf));
 
+	uint32_t listener_id = m_listeners.acquire();
+	retv_if(listener_id == 0, -EBUSY);
+
 	sensor_listener_proxy *listener;
 	listener = new(std::nothrow) sensor_listener_proxy(listener_id,
 				buf.sensor, m_manager, ch);
-	retvm_if(!listener, OP_ERROR, "Failed to allocate memory");
-	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
-			-EACCES, "Permission denied[%d, %s]",
-			listener_id, m_listeners[listener_id]->get_required_privileges().c_str());
+	if (!listener) {
+		m_listeners.release(listener_id);
+		_E("Failed to allocate memory");
+		return OP_ERROR;
+	}
+
+	if (!has_privileges(ch->get_fd(), listener->get_required_privileges())) {
+		_E("Permission denied[%d, %s]", listener_id, listener->get_required_privileges().c_str());
+		delete listener;
+		m_listeners.release(listener_id);
+		return -EACCES;
+	}
 
 	buf.listener_id = listener_id;
 
@@ -175,13 +193,14 @@ int server_channel_handler::listener_connect(channel *ch, message &msg)
 	reply.enclose((const char *)&buf, sizeof(buf));
 	reply.header()->err = OP_SUCCESS;
 
-	if (!ch->send_sync(reply))
+	if (!ch->send_sync(reply)) {
+		delete listener;
+		m_listeners.release(listener_id);
 		return OP_ERROR;
+	}
 
 	_I("Connected sensor_listener[fd(%d) -> id(%u)]", ch->get_fd(), listener_id);
-	m_listeners[listener_id] = listener;
-	m_listener_ids[ch] = listener_id;
-	listener_id++;
+	m_listeners.attach(listener_id, listener, ch);
 
 	return OP_SUCCESS;
 }
@@ -192,13 +211,13 @@ int server_channel_handler::listener_start(channel *ch, message &msg)
 	msg.disclose((char *)&buf, sizeof(buf));
 	uint32_t id = buf.listener_id;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
-	int ret = m_listeners[id]->start();
+	int ret = listener->start();
 	retvm_if(ret < 0, ret, "Failed to start listener[%d]", id);
 
 	return send_reply(ch, OP_SUCCESS);
@@ -210,13 +229,13 @@ int server_channel_handler::listener_stop(channel *ch, message &msg)
 	msg.disclose((char *)&buf, sizeof(buf));
 	uint32_t id = buf.listener_id;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
-	int ret = m_listeners[id]->stop();
+	int ret = listener->stop();
 	retvm_if(ret < 0, ret, "Failed to stop listener[%d]", id);
 
 	return send_reply(ch, OP_SUCCESS);
@@ -230,23 +249,23 @@ int server_channel_handler::listener_set_attr_int(channel *ch, message &msg)
 
 	int ret = OP_SUCCESS;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
 	switch (buf.attribute) {
 	case SENSORD_ATTRIBUTE_INTERVAL:
-		ret = m_listeners[id]->set_interval(buf.value); break;
+		ret = listener->set_interval(buf.value); break;
 	case SENSORD_ATTRIBUTE_MAX_BATCH_LATENCY:
-		ret = m_listeners[id]->set_max_batch_latency(buf.value); break;
+		ret = listener->set_max_batch_latency(buf.value); break;
 	case SENSORD_ATTRIBUTE_PASSIVE_MODE:
-		ret = m_listeners[id]->set_passive_mode(buf.value); break;
+		ret = listener->set_passive_mode(buf.value); break;
 	case SENSORD_ATTRIBUTE_PAUSE_POLICY:
 	case SENSORD_ATTRIBUTE_AXIS_ORIENTATION:
 	default:
-		ret = m_listeners[id]->set_attribute(buf.attribute, buf.value);
+		ret = listener->set_attribute(buf.attribute, buf.value);
 	}
 	/* TODO : check return value */
 	if (ret < 0)
@@ -254,9 +273,9 @@ int server_channel_handler::listener_set_attr_int(channel *ch, message &msg)
 
 	ret = send_reply(ch, OP_SUCCESS);
 
-	if (m_listeners[id]->need_to_notify_attribute_changed()) {
-		m_listeners[id]->notify_attribute_changed(buf.attribute, buf.value);
-		m_listeners[id]->set_need_to_notify_attribute_changed(false);
+	if (listener->need_to_notify_attribute_changed()) {
+		listener->notify_attribute_changed(buf.attribute, buf.value);
+		listener->set_need_to_notify_attribute_changed(false);
 	}
 
 	return ret;
@@ -273,19 +292,19 @@ int server_channel_handler::listener_set_attr_str(channel *ch, message &msg)
 	msg.disclose((char *)buf, msg.size());
 
 	id = buf->listener_id;
-	auto it = m_listeners.find(id);
-	if (it == m_listeners.end()) {
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	if (!listener) {
 		delete [] buf;
 		return -EINVAL;
 	}
 
-	if (!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges())) {
-		_E("Permission denied[%d, %s]", id, m_listeners[id]->get_required_privileges().c_str());
+	if (!has_privileges(ch->get_fd(), listener->get_required_privileges())) {
+		_E("Permission denied[%d, %s]", id, listener->get_required_privileges().c_str());
 		delete [] buf;
 		return -EACCES;
 	}
 
-	int ret = m_listeners[id]->set_attribute(buf->attribute, buf->value, buf->len);
+	int ret = listener->set_attribute(buf->attribute, buf->value, buf->len);
 	if (ret < 0) {
 		delete [] buf;
 		return ret;
@@ -293,9 +312,9 @@ int server_channel_handler::listener_set_attr_str(channel *ch, message &msg)
 
 	ret = send_reply(ch, OP_SUCCESS);
 
-	if (m_listeners[id]->need_to_notify_attribute_changed()) {
-		m_listeners[id]->notify_attribute_changed(buf->attribute, buf->value, buf->len);
-		m_listeners[id]->set_need_to_notify_attribute_changed(false);
+	if (listener->need_to_notify_attribute_changed()) {
+		listener->notify_attribute_changed(buf->attribute, buf->value, buf->len);
+		listener->set_need_to_notify_attribute_changed(false);
 	}
 
 	delete [] buf;
@@ -311,25 +330,24 @@ int server_channel_handler::listener_get_attr_int(ipc::channel *ch, ipc::message
 	int value = 0;
 	int ret = OP_SUCCESS;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
 	switch (attr) {
 	case SENSORD_ATTRIBUTE_INTERVAL:
-		ret = m_listeners[id]->get_interval(value); break;
+		ret = listener->get_interval(value); break;
 	case SENSORD_ATTRIBUTE_MAX_BATCH_LATENCY:
-		ret = m_listeners[id]->get_max_batch_latency(value); break;
+		ret = listener->get_max_batch_latency(value); break;
 	case SENSORD_ATTRIBUTE_PASSIVE_MODE:
-		// TODO : Are these features required?
-		ret = OP_ERROR;
+		value = listener->get_passive_mode();
 		break;
 	case SENSORD_ATTRIBUTE_PAUSE_POLICY:
 	case SENSORD_ATTRIBUTE_AXIS_ORIENTATION:
 	default:
-		ret = m_listeners[id]->get_attribute(attr, &value);
+		ret = listener->get_attribute(attr, &value);
 	}
 
 	if (ret != OP_SUCCESS) {
@@ -362,22 +380,22 @@ int server_channel_handler::listener_get_attr_str(ipc::channel *ch, ipc::message
 	msg.disclose((char *)buf, msg.size());
 
 	id = buf->listener_id;
-	auto it = m_listeners.find(id);
+	sensor_listener_proxy *listener = m_listeners.get(id);
 	auto attr = buf->attribute;
 	delete [] buf;
 
-	if (it == m_listeners.end()) {
+	if (!listener) {
 		return -EINVAL;
 	}
 
-	if (!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges())) {
-		_E("Permission denied[%d, %s]", id, m_listeners[id]->get_required_privileges().c_str());
+	if (!has_privileges(ch->get_fd(), listener->get_required_privileges())) {
+		_E("Permission denied[%d, %s]", id, listener->get_required_privileges().c_str());
 		return -EACCES;
 	}
 
 	char *value = NULL;
 	int len = 0;
-	int ret = m_listeners[id]->get_attribute(attr, &value, &len);
+	int ret = listener->get_attribute(attr, &value, &len);
 
 	if (ret != OP_SUCCESS) {
 		_E("Failed to listener_get_attr_str");
@@ -415,13 +433,13 @@ int server_channel_handler::listener_get_data(channel *ch, message &msg)
 	msg.disclose((char *)&buf, sizeof(buf));
 	id = buf.listener_id;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
-	int ret = m_listeners[id]->get_data(&data, &len);
+	int ret = listener->get_data(&data, &len);
 	retv_if(ret < 0, ret);
 
 	memcpy(&buf.data, data, sizeof(sensor_data_t));
@@ -438,6 +456,59 @@ int server_channel_handler::listener_get_data(channel *ch, message &msg)
 	return OP_SUCCESS;
 }
 
+int server_channel_handler::listener_add_sync_sensor(channel *ch, message &msg)
+{
+	cmd_listener_add_sync_sensor_t buf;
+	msg.disclose((char *)&buf, sizeof(buf));
+	buf.sensor[NAME_MAX - 1] = '\0';
+	uint32_t id = buf.listener_id;
+
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+
+	sensor_handler *sensor = m_manager->get_sensor(buf.sensor);
+	retv_if(!sensor, -EINVAL);
+
+	sensor_info info = sensor->get_sensor_info();
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()) ||
+			!has_privileges(ch->get_fd(), info.get_privilege()),
+			-EACCES, "Permission denied[%d, %s]", id, buf.sensor);
+
+	int ret = listener->add_sync_sensor(buf.sensor);
+	retv_if(ret < 0, ret);
+
+	return send_reply(ch, OP_SUCCESS);
+}
+
+int server_channel_handler::listener_get_data_fd(ipc::channel *ch, ipc::message &msg)
+{
+	ipc::message reply;
+	cmd_listener_get_data_fd_t buf;
+	uint32_t id;
+
+	msg.disclose((char *)&buf, sizeof(buf));
+	id = buf.listener_id;
+
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
+			-EACCES, "Permission denied[%d, %s]",
+			id, listener->get_required_privileges().c_str());
+
+	int fd = listener->get_shared_fd();
+	retv_if(fd < 0, fd);
+
+	reply.header()->err = OP_SUCCESS;
+	reply.header()->type = CMD_LISTENER_GET_DATA_FD;
+
+	if (ch->send_sync(reply))
+		ch->send_fd(fd);
+
+	::close(fd);
+
+	return OP_SUCCESS;
+}
+
 int server_channel_handler::listener_get_data_list(ipc::channel *ch, ipc::message &msg)
 {
 	ipc::message reply;
@@ -449,13 +520,13 @@ int server_channel_handler::listener_get_data_list(ipc::channel *ch, ipc::messag
 	msg.disclose((char *)&buf, sizeof(buf));
 	id = buf.listener_id;
 
-	auto it = m_listeners.find(id);
-	retv_if(it == m_listeners.end(), -EINVAL);
-	retvm_if(!has_privileges(ch->get_fd(), m_listeners[id]->get_required_privileges()),
+	sensor_listener_proxy *listener = m_listeners.get(id);
+	retv_if(!listener, -EINVAL);
+	retvm_if(!has_privileges(ch->get_fd(), listener->get_required_privileges()),
 			-EACCES, "Permission denied[%d, %s]",
-			id, m_listeners[id]->get_required_privileges().c_str());
+			id, listener->get_required_privileges().c_str());
 
-	int ret = m_listeners[id]->get_data(&data, &len);
+	int ret = listener->get_data(&data, &len);
 	retv_if(ret < 0, ret);
 
 	size_t reply_size = sizeof(cmd_listener_get_data_list_t) + len;
@@ -510,13 +581,17 @@ int server_channel_handler::provider_publish(channel *ch, message &msg)
 	auto it = m_app_sensors.find(ch);
 	retv_if(it == m_app_sensors.end(), -EINVAL);
 
-	size_t size = msg.header()->length;
-	void *data = (void *)malloc(size);
+	size_t size = msg.size();
+	retvm_if(size == 0 || size % sizeof(sensor_data_t) != 0, -EINVAL,
+			"Invalid event size[%zu]", size);
+
+	/* the received body becomes the event itself, without another copy */
+	sensor_data_t *data = reinterpret_cast<sensor_data_t *>(msg.release());
 	retvm_if(!data, -ENOMEM, "Failed to allocate memory");
 
-	msg.disclose(data, size);
+	if (it->second->publish(data, size) < 0)
+		free(data);
 
-	it->second->publish((sensor_data_t*)data, size);
 	return OP_SUCCESS;
 }
 
@@ -537,6 +612,100 @@ int server_channel_handler::has_privileges(channel *ch, message &msg)
 	return send_reply(ch, OP_SUCCESS);
 }
 
+static int get_peer_pid(int fd)
+{
+	struct ucred cred;
+	socklen_t len = sizeof(cred);
+
+	retv_if(getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0, -1);
+	return cred.pid;
+}
+
+int server_channel_handler::get_stats(channel *ch, message &msg)
+{
+	retvm_if(!has_privileges(ch->get_fd(), PRIVILEGE_PLATFORM_URI),
+			-EACCES, "Permission denied[%d]", ch->get_fd());
+
+	std::vector<sensor_handler *> sensors = m_manager->get_sensors();
+	std::unordered_map<std::string, int> indices;
+	size_t capacity = MAX_MSG_CAPACITY - 1 - sizeof(cmd_get_stats_t);
+
+	ipc::message reply;
+	cmd_get_stats_t *stats = reinterpret_cast<cmd_get_stats_t *>(reply.reserve(MAX_MSG_CAPACITY - 1));
+	retvm_if(!stats, -ENOMEM, "Failed to allocate memory");
+
+	stats->latency_cnt = 0;
+	stats->sensor_cnt = 0;
+	stats->listener_cnt = 0;
+	stats->total_sensor_cnt = sensors.size();
+	stats->total_listener_cnt = m_listeners.size();
+
+	char *pos = stats->data;
+
+	/* the later stages are measured by the client library */
+	for (int stage = 0; stage < SENSORD_LATENCY_WRITE_TO_RECEIVE; ++stage) {
+		cmd_latency_stats_t *record = reinterpret_cast<cmd_latency_stats_t *>(pos);
+		latency_histogram &histogram = latency_histogram::get(stage);
+
+		memset(record, 0, sizeof(*record));
+		record->stage = stage;
+		record->count = histogram.count();
+		record->p50 = histogram.percentile(50);
+		record->p99 = histogram.percentile(99);
+		record->p999 = histogram.percentile(99.9);
+		record->max = histogram.max();
+
+		stats->latency_cnt++;
+		pos += sizeof(cmd_latency_stats_t);
+		capacity -= sizeof(cmd_latency_stats_t);
+	}
+
+	for (auto it = sensors.begin(); it != sensors.end(); ++it) {
+		if (capacity < sizeof(cmd_sensor_stats_t))
+			break;
+
+		cmd_sensor_stats_t *record = reinterpret_cast<cmd_sensor_stats_t *>(pos);
+		sensor_info info = (*it)->get_sensor_info();
+
+		memset(record, 0, sizeof(*record));
+		snprintf(record->uri, sizeof(record->uri), "%s", info.get_uri().c_str());
+		(*it)->get_stats(*record);
+
+		indices[info.get_uri()] = stats->sensor_cnt++;
+		pos += sizeof(cmd_sensor_stats_t);
+		capacity -= sizeof(cmd_sensor_stats_t);
+	}
+
+	const std::vector<listener_registry::slot> &slots = m_listeners.slots();
+
+	for (auto it = slots.begin(); it != slots.end(); ++it) {
+		if (capacity < sizeof(cmd_listener_stats_t))
+			break;
+
+		if (!it->listener)
+			continue;
+
+		cmd_listener_stats_t *record = reinterpret_cast<cmd_listener_stats_t *>(pos);
+		memset(record, 0, sizeof(*record));
+		it->listener->get_stats(*record);
+
+		auto index = indices.find(it->listener->get_uri());
+		record->sensor_index = (index != indices.end()) ? index->second : -1;
+		record->pid = get_peer_pid(it->ch->get_fd());
+
+		stats->listener_cnt++;
+		pos += sizeof(cmd_listener_stats_t);
+		capacity -= sizeof(cmd_listener_stats_t);
+	}
+
+	reply.reserve(pos - reinterpret_cast<char *>(stats));
+	reply.set_type(CMD_GET_STATS);
+	reply.header()->err = OP_SUCCESS;
+
+	retvm_if(!ch->send_sync(reply), OP_ERROR, "Failed to send reply");
+	return OP_SUCCESS;
+}
+
 int server_channel_handler::send_reply(channel *ch, int error)
 {
 	message reply(error);
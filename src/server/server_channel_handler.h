@@ -28,6 +28,7 @@
 #include "sensor_manager.h"
 #include "sensor_listener_proxy.h"
 #include "application_sensor_handler.h"
+#include "listener_registry.h"
 
 namespace sensor {
 
@@ -59,12 +60,15 @@ private:
 	int listener_get_attr_int(ipc::channel *ch, ipc::message &msg);
 	int listener_get_attr_str(ipc::channel *ch, ipc::message &msg);
 	int listener_get_data_list(ipc::channel *ch, ipc::message &msg);
+	int listener_get_data_fd(ipc::channel *ch, ipc::message &msg);
+	int listener_add_sync_sensor(ipc::channel *ch, ipc::message &msg);
 
 	int provider_connect(ipc::channel *ch, ipc::message &msg);
 	int provider_disconnect(ipc::channel *ch, ipc::message &msg);
 	int provider_publish(ipc::channel *ch, ipc::message &msg);
 
 	int has_privileges(ipc::channel *ch, ipc::message &msg);
+	int get_stats(ipc::channel *ch, ipc::message &msg);
 
 	bool has_privilege(int fd, std::string &priv);
 	bool has_privileges(int fd, std::string priv);
@@ -73,11 +77,7 @@ private:
 
 	sensor_manager *m_manager;
 
-	/* {id, listener} */
-	static std::unordered_map<uint32_t, sensor_listener_proxy *> m_listeners;
-
-	/* {channel, id} */
-	static std::unordered_map<ipc::channel *, uint32_t> m_listener_ids;
+	listener_registry m_listeners;
 
 	/* {channel, application_sensor_handler} */
 	/* it should move to sensor_manager */
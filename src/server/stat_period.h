@@ -0,0 +1,71 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __STAT_PERIOD_H__
+#define __STAT_PERIOD_H__
+
+#include <stdint.h>
+#include <atomic>
+
+namespace sensor {
+
+/* Moving average of the period between samples, for the statistics.
+ * update() runs on the event path, get() whenever statistics are asked
+ * for, so the average is kept in a relaxed atomic. */
+class stat_period {
+public:
+	stat_period()
+	: m_period(0)
+	, m_timestamp(0)
+	{}
+
+	/* count samples up to the one at timestamp have arrived */
+	void update(unsigned long long timestamp, int count)
+	{
+		if (m_timestamp > 0 && timestamp > m_timestamp) {
+			uint64_t period = (timestamp - m_timestamp) / count;
+			uint64_t average = m_period.load(std::memory_order_relaxed);
+
+			if (average == 0)
+				average = period;
+			else
+				average = average - average / WEIGHT + period / WEIGHT;
+
+			m_period.store(average, std::memory_order_relaxed);
+		}
+
+		m_timestamp = timestamp;
+	}
+
+	/* us, 0 until two samples arrived */
+	uint64_t get(void) const
+	{
+		return m_period.load(std::memory_order_relaxed);
+	}
+
+private:
+	static const uint64_t WEIGHT = 8;
+
+	std::atomic<uint64_t> m_period;
+	unsigned long long m_timestamp;
+};
+
+}
+
+#endif /* __STAT_PERIOD_H__ */
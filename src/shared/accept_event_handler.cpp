@@ -36,7 +36,17 @@ bool accept_event_handler::handle(int fd, event_condition condition)
 	stream_socket *cli_sock = new(std::nothrow) stream_socket();
 	retvm_if(!cli_sock, false, "Failed to allocate memory");
 
-	m_server->accept(*cli_sock);
+	if (!m_server->accept(*cli_sock)) {
+		delete cli_sock;
+		return true;
+	}
+
+	/* taken off the backlog and closed, so that the peer fails right away */
+	if (m_server->is_full()) {
+		_W("Too many connections, refused[%d]", cli_sock->get_fd());
+		delete cli_sock;
+		return true;
+	}
 
 	channel *_ch = new(std::nothrow) channel(cli_sock);
 	retvm_if(!_ch, false, "Failed to allocate memory");
@@ -20,11 +20,15 @@
 #include "channel.h"
 
 #include <stdint.h>
+#include <errno.h>
 #include <unistd.h>
+#include <string.h>
 #include <memory>
 #include <algorithm>
 
 #include "sensor_log.h"
+#include "sensor_utils.h"
+#include "latency_histogram.h"
 #include "channel_event_handler.h"
 
 #define SYSTEMD_SOCK_BUF_SIZE (128*1024)
@@ -117,6 +121,9 @@ channel::channel(socket *sock)
 , m_handler(NULL)
 , m_loop(NULL)
 , m_connected(false)
+, m_stat_sent(0)
+, m_stat_bytes(0)
+, m_stat_drops(0)
 {
 	_D("Create[%p]", this);
 }
@@ -209,7 +216,10 @@ bool channel::send(std::shared_ptr<message> msg)
 	int retry_cnt = 0;
 	int cur_buffer_size = 0;
 
-	retv_if(!m_loop, false);
+	if (!m_loop) {
+		m_stat_drops.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
 
 	while (retry_cnt < 3) {
 		cur_buffer_size = m_socket->get_current_buffer_size();
@@ -218,13 +228,33 @@ bool channel::send(std::shared_ptr<message> msg)
 		usleep(3000);
 		retry_cnt++;
 	}
-	retvm_if(retry_cnt >= 3, false, "Socket buffer[%d] is exceeded", cur_buffer_size);
+	if (retry_cnt >= 3) {
+		m_stat_drops.fetch_add(1, std::memory_order_relaxed);
+		_E("Socket buffer[%d] is exceeded", cur_buffer_size);
+		return false;
+	}
+
+	/* write right away, unless earlier messages are still queued on the loop */
+	if (m_pending_event_id.empty()) {
+		int ret = send_frame(*msg);
+		if (ret != -EAGAIN) {
+			if (ret != 0)
+				m_stat_drops.fetch_add(1, std::memory_order_relaxed);
+			return (ret == 0);
+		}
+	}
 
 	send_event_handler *handler = new(std::nothrow) send_event_handler(this, msg);
-	retvm_if(!handler, false, "Failed to allocate memory");
+	if (!handler) {
+		m_stat_drops.fetch_add(1, std::memory_order_relaxed);
+		_E("Failed to allocate memory");
+		return false;
+	}
 
-	uint64_t event_id = m_loop->add_event(m_socket->get_fd(), (EVENT_OUT | EVENT_HUP | EVENT_NVAL), handler);
+	uint64_t event_id = m_loop->add_event(m_socket->get_fd(), (EVENT_OUT | EVENT_HUP | EVENT_NVAL), handler,
+			EVENT_PRIORITY_DELIVERY);
 	if (event_id == 0) {
+		m_stat_drops.fetch_add(1, std::memory_order_relaxed);
 		_D("Failed to add send event handler");
 		delete handler;
 		return false;
@@ -244,24 +274,115 @@ bool channel::send_sync(message &msg)
 
 	retvm_if(msg.size() >= MAX_MSG_CAPACITY, true, "Invaild message size[%u]", msg.size());
 
+	message_header header = *msg.header();
+	message_trailer trailer;
 	ssize_t size = 0;
 	char *buf = msg.body();
 
+	if (msg.trailer()->notify) {
+		trailer = *msg.trailer();
+		trailer.write = sensor::utils::get_timestamp();
+		header.trailer = sizeof(message_trailer);
+
+		sensor::latency_histogram::get(SENSORD_LATENCY_NOTIFY_TO_WRITE).record(
+				trailer.write - trailer.notify);
+	}
+
 	/* header */
-	size = m_socket->send(reinterpret_cast<void *>(msg.header()),
+	size = m_socket->send(reinterpret_cast<void *>(&header),
 	    sizeof(message_header), true);
 	retvm_if(size <= 0, false, "Failed to send header");
 
-	/* if body size is zero, skip to send body message */
-	retv_if(msg.size() == 0, true);
-
 	/* body */
-	size = m_socket->send(buf, msg.size(), true);
-	retvm_if(size <= 0, false, "Failed to send body");
+	if (msg.size() > 0) {
+		size = m_socket->send(buf, msg.size(), true);
+		retvm_if(size <= 0, false, "Failed to send body");
+	}
+
+	/* trailer */
+	if (header.trailer > 0) {
+		size = m_socket->send(&trailer, header.trailer, true);
+		retvm_if(size <= 0, false, "Failed to send trailer");
+	}
+
+	m_stat_sent.fetch_add(1, std::memory_order_relaxed);
+	m_stat_bytes.fetch_add(sizeof(message_header) + msg.size() + header.trailer,
+			std::memory_order_relaxed);
 
 	return true;
 }
 
+/* Send header, body and trailer with a single non-blocking sendmsg().
+ * The message is not modified, so one message can be shared by many channels.
+ * Returns -EAGAIN if the socket is full and nothing was written. */
+int channel::send_frame(message &msg)
+{
+	AUTOLOCK(m_cmutex);
+	retv_if(!is_connected(), -ENOTCONN);
+	retvm_if(msg.size() >= MAX_MSG_CAPACITY, -EINVAL, "Invalid message size[%zu]", msg.size());
+
+	message_header header = *msg.header();
+	message_trailer trailer;
+	struct iovec iov[3];
+	int count = 0;
+	size_t total;
+	ssize_t size;
+
+	/* event frames stamped by the sensor handler carry their timestamps along */
+	if (msg.trailer()->notify) {
+		trailer = *msg.trailer();
+		trailer.write = sensor::utils::get_timestamp();
+		header.trailer = sizeof(message_trailer);
+
+		sensor::latency_histogram::get(SENSORD_LATENCY_NOTIFY_TO_WRITE).record(
+				trailer.write - trailer.notify);
+	}
+
+	iov[count].iov_base = &header;
+	iov[count++].iov_len = sizeof(message_header);
+
+	if (msg.size() > 0) {
+		iov[count].iov_base = msg.body();
+		iov[count++].iov_len = msg.size();
+	}
+
+	if (header.trailer) {
+		iov[count].iov_base = &trailer;
+		iov[count++].iov_len = sizeof(message_trailer);
+	}
+
+	total = sizeof(message_header) + msg.size() + header.trailer;
+
+	size = m_socket->send_nonblock(iov, count);
+	if (size == -EAGAIN || size == -EWOULDBLOCK)
+		return -EAGAIN;
+	retvm_if(size < 0, size, "Failed to send message");
+
+	size_t sent = size;
+
+	/* the rest of a partially written message must go out before anything else */
+	for (int i = 0; i < count && sent < total; ++i) {
+		if (sent >= iov[i].iov_len) {
+			sent -= iov[i].iov_len;
+			total -= iov[i].iov_len;
+			continue;
+		}
+
+		size = m_socket->send(reinterpret_cast<char *>(iov[i].iov_base) + sent,
+				iov[i].iov_len - sent, true);
+		retvm_if(size <= 0, -EIO, "Failed to send message");
+
+		total -= iov[i].iov_len;
+		sent = 0;
+	}
+
+	m_stat_sent.fetch_add(1, std::memory_order_relaxed);
+	m_stat_bytes.fetch_add(sizeof(message_header) + msg.size() + header.trailer,
+			std::memory_order_relaxed);
+
+	return 0;
+}
+
 bool channel::read(void)
 {
 	retv_if(!m_loop, false);
@@ -290,7 +411,7 @@ bool channel::read_sync(message &msg, bool select)
 
 	message_header header;
 	ssize_t size = 0;
-	char buf[MAX_MSG_CAPACITY];
+	char *buf;
 
 	/* header */
 	size = m_socket->recv(&header, sizeof(message_header), select);
@@ -313,8 +434,12 @@ bool channel::read_sync(message &msg, bool select)
 		return false;
 	}
 
+	/* the body is received in place, so handlers can take it over without a copy */
+	buf = msg.reserve(header.length);
+	retvm_if(!buf, false, "Failed to allocate memory");
+
 	if (header.length > 0) {
-		size = m_socket->recv(&buf, header.length, select);
+		size = m_socket->recv(buf, header.length, select);
 		if (size <= 0) {
 			if (size == -1) {
 				disconnect();
@@ -324,7 +449,37 @@ bool channel::read_sync(message &msg, bool select)
 	}
 
 	buf[header.length] = '\0';
-	msg.enclose(reinterpret_cast<const void *>(buf), header.length);
+
+	/* trailer, the fields of a longer one from a newer peer are skipped */
+	if (header.trailer > 0) {
+		char chunk[sizeof(message_trailer)];
+		message_trailer trailer;
+		size_t offset = 0;
+
+		retvm_if(header.trailer > MAX_TRAILER_SIZE, false,
+				"header.trailer error %u", header.trailer);
+
+		while (offset < header.trailer) {
+			size_t len = std::min(header.trailer - offset, sizeof(chunk));
+
+			size = m_socket->recv(chunk, len, select);
+			if (size <= 0) {
+				if (size == -1) {
+					disconnect();
+				}
+				return false;
+			}
+
+			if (offset < sizeof(message_trailer))
+				::memcpy((char *)&trailer + offset, chunk,
+						std::min(len, sizeof(message_trailer) - offset));
+
+			offset += len;
+		}
+
+		::memcpy(msg.trailer(), &trailer, sizeof(message_trailer));
+	}
+
 	msg.set_type(header.type);
 	msg.header()->err = header.err;
 
@@ -334,6 +489,22 @@ bool channel::read_sync(message &msg, bool select)
 	return true;
 }
 
+bool channel::send_fd(int fd)
+{
+	AUTOLOCK(m_cmutex);
+	retvm_if(!is_connected(), false, "Channel is not connected");
+
+	return m_socket->send_fd(fd);
+}
+
+int channel::read_fd(void)
+{
+	AUTOLOCK(m_cmutex);
+	retvm_if(!is_connected(), -1, "Channel is not connected");
+
+	return m_socket->recv_fd();
+}
+
 bool channel::is_connected(void)
 {
 	return m_connected.load();
@@ -386,3 +557,11 @@ void channel::remove_pending_event_id(uint64_t id)
 		m_pending_event_id.erase(it);
 	}
 }
+
+void channel::get_stats(uint64_t &sent, uint64_t &bytes, uint64_t &drops, int &pending)
+{
+	sent = m_stat_sent.load(std::memory_order_relaxed);
+	bytes = m_stat_bytes.load(std::memory_order_relaxed);
+	drops = m_stat_drops.load(std::memory_order_relaxed);
+	pending = m_pending_event_id.size();
+}
@@ -50,16 +50,23 @@ public:
 
 	bool send(std::shared_ptr<message> msg);
 	bool send_sync(message &msg);
+	int send_frame(message &msg);
 
 	bool read(void);
 	bool read_sync(message &msg, bool select = true);
 
+	/* descriptors go out of band, right after the reply they belong to */
+	bool send_fd(int fd);
+	int read_fd(void);
+
 	bool get_option(int type, int &value) const;
 	bool set_option(int type, int value);
 
 	int get_fd(void) const;
 	void remove_pending_event_id(uint64_t id);
 
+	void get_stats(uint64_t &sent, uint64_t &bytes, uint64_t &drops, int &pending);
+
 	event_loop *loop()
 	{
 		return m_loop;
@@ -75,6 +82,11 @@ private:
 
 	std::atomic<bool> m_connected;
 	sensor::cmutex m_cmutex;
+
+	/* statistics, relaxed because they are only ever read for reporting */
+	std::atomic<uint64_t> m_stat_sent;
+	std::atomic<uint64_t> m_stat_bytes;
+	std::atomic<uint64_t> m_stat_drops;
 };
 
 }
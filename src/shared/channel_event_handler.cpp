@@ -42,19 +42,21 @@ channel_event_handler::~channel_event_handler()
 bool channel_event_handler::handle(int fd, event_condition condition)
 {
 	message msg;
+	channel *ch = m_ch;
 
-	if (!m_ch || !m_ch->is_connected())
+	if (!ch || !ch->is_connected())
 		return false;
 
+	/* disconnecting removes the event, which deletes this handler */
 	if (condition & (EVENT_HUP)) {
 		_D("Disconnect[%p] : The other proccess is dead", this);
-		m_ch->disconnect();
-		m_ch = NULL;
+		ch->disconnect();
 		return false;
 	}
 
-	if (!m_ch->read_sync(msg, false)) {
-		m_ch = NULL;
+	/* a closed peer reads as 0, which leaves the channel connected */
+	if (!ch->read_sync(msg, false)) {
+		ch->disconnect();
 		return false;
 	}
 
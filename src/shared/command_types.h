@@ -39,7 +39,7 @@ enum cmd_type_e {
 
 	/* Listener */
 	CMD_LISTENER_EVENT = 0x200,
-	CMD_LISTENER_ACC_EVENT,
+	CMD_LISTENER_ACC_EVENT, /* unused: accuracy is carried by CMD_LISTENER_EVENT */
 	CMD_LISTENER_CONNECT,
 	CMD_LISTENER_START,
 	CMD_LISTENER_STOP,
@@ -50,6 +50,8 @@ enum cmd_type_e {
 	CMD_LISTENER_GET_ATTR_STR,
 	CMD_LISTENER_GET_DATA_LIST,
 	CMD_LISTENER_CONNECTED,
+	CMD_LISTENER_GET_DATA_FD,
+	CMD_LISTENER_ADD_SYNC_SENSOR,
 
 	/* Provider */
 	CMD_PROVIDER_CONNECT = 0x300,
@@ -61,6 +63,7 @@ enum cmd_type_e {
 
 	/* Etc */
 	CMD_HAS_PRIVILEGE = 0x1000,
+	CMD_GET_STATS,
 
 	CMD_CNT,
 };
@@ -75,6 +78,11 @@ typedef struct {
 	char sensor[NAME_MAX];
 } cmd_listener_connect_t;
 
+typedef struct {
+	int listener_id;
+	char sensor[NAME_MAX];
+} cmd_listener_add_sync_sensor_t;
+
 typedef struct {
 	int listener_id;
 } cmd_listener_start_t;
@@ -109,6 +117,11 @@ typedef struct {
 	sensor_data_t data[0];
 } cmd_listener_get_data_list_t;
 
+/* the reply is followed by the read-only fd of the shared_sample segment */
+typedef struct {
+	int listener_id;
+} cmd_listener_get_data_fd_t;
+
 typedef struct {
 	char info[0];
 } cmd_provider_connect_t;
@@ -132,4 +145,52 @@ typedef struct {
 	char sensor[NAME_MAX];
 } cmd_has_privilege_t ;
 
+typedef struct {
+	char uri[NAME_MAX];
+	uint64_t events_read;		/* read from the HAL, physical sensors only */
+	uint64_t events_notified;
+	uint64_t fusion_evaluations;
+	float rate;			/* Hz, effective output rate */
+	int observer_count;
+	int queue_depth;		/* ingest queue, external sensors only */
+	int queue_max_depth;
+	uint64_t queue_overflows;
+} cmd_sensor_stats_t;
+
+typedef struct {
+	int listener_id;
+	int pid;
+	int sensor_index;		/* into the sensor records, -1 if unknown */
+	int started;
+	uint64_t events;
+	uint64_t bytes;
+	uint64_t drops;
+	uint64_t filtered;		/* withheld by the delivery mode */
+	int queue_depth;
+	int interval;			/* requested, ms */
+	float effective_interval;	/* ms, 0 if nothing was delivered yet */
+} cmd_listener_stats_t;
+
+/* latencies are in us, see sensord_latency_stage_e */
+typedef struct {
+	int stage;
+	uint64_t count;
+	uint64_t p50;
+	uint64_t p99;
+	uint64_t p999;
+	uint64_t max;
+} cmd_latency_stats_t;
+
+/* [cmd_get_stats_t] [cmd_latency_stats_t * latency_cnt]
+ * [cmd_sensor_stats_t * sensor_cnt] [cmd_listener_stats_t * listener_cnt]
+ * records that do not fit into one message are left out, see total_*_cnt */
+typedef struct {
+	int latency_cnt;
+	int sensor_cnt;
+	int listener_cnt;
+	int total_sensor_cnt;
+	int total_listener_cnt;
+	char data[0];
+} cmd_get_stats_t;
+
 #endif /* __COMMAND_TYPES_H__ */
@@ -0,0 +1,117 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "delivery_filter.h"
+
+#include <math.h>
+#include <algorithm>
+
+using namespace sensor;
+
+#define VALUE_COUNT_MAX ((int)(sizeof(sensor_data_t::values) / sizeof(float)))
+
+delivery_filter::delivery_filter()
+: m_mode(SENSORD_DELIVERY_ALL)
+, m_heartbeat(0)
+{
+	reset();
+}
+
+void delivery_filter::set_mode(int mode)
+{
+	if (m_mode == mode)
+		return;
+
+	m_mode = mode;
+	reset();
+}
+
+int delivery_filter::get_mode(void)
+{
+	return m_mode;
+}
+
+void delivery_filter::set_heartbeat(unsigned long long heartbeat)
+{
+	m_heartbeat = heartbeat;
+}
+
+void delivery_filter::set_thresholds(const sensord_delta_threshold_s *thresholds, int count)
+{
+	m_thresholds.assign(thresholds, thresholds + count);
+}
+
+const std::vector<sensord_delta_threshold_s> &delivery_filter::get_thresholds(void)
+{
+	return m_thresholds;
+}
+
+bool delivery_filter::push(const sensor_data_t &data)
+{
+	if (m_mode != SENSORD_DELIVERY_ALL && !need_delivery(data))
+		return false;
+
+	m_last_delivered = data;
+	m_delivered = true;
+
+	return true;
+}
+
+void delivery_filter::reset(void)
+{
+	m_delivered = false;
+}
+
+bool delivery_filter::need_delivery(const sensor_data_t &data)
+{
+	const sensord_delta_threshold_s none = {0, 0};
+
+	/* the first sample, or the sensor was restarted */
+	if (!m_delivered || data.timestamp < m_last_delivered.timestamp)
+		return true;
+
+	if (m_heartbeat > 0 && data.timestamp - m_last_delivered.timestamp >= m_heartbeat)
+		return true;
+
+	if (data.value_count != m_last_delivered.value_count)
+		return true;
+
+	int count = std::min<int>(data.value_count, VALUE_COUNT_MAX);
+
+	for (int i = 0; i < count; ++i) {
+		float last = m_last_delivered.values[i];
+		float diff = fabsf(data.values[i] - last);
+		const sensord_delta_threshold_s &threshold = (m_mode != SENSORD_DELIVERY_DELTA ||
+				m_thresholds.empty()) ? none :
+				m_thresholds[std::min<int>(i, m_thresholds.size() - 1)];
+
+		if (diff == 0)
+			continue;
+
+		/* without a threshold, any change counts */
+		if (threshold.absolute <= 0 && threshold.relative <= 0)
+			return true;
+		if (threshold.absolute > 0 && diff >= threshold.absolute)
+			return true;
+		if (threshold.relative > 0 && diff >= threshold.relative * fabsf(last))
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,67 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __DELIVERY_FILTER_H__
+#define __DELIVERY_FILTER_H__
+
+#include <sensor_types.h>
+#include <vector>
+
+namespace sensor {
+
+/* Decides which samples a listener gets with its delivery mode (see
+ * sensord_delivery_e): all of them, the ones whose values changed since
+ * the last one delivered, or the ones where a value moved by its threshold.
+ * With a heartbeat, a sample is also let through once nothing was
+ * delivered for that long. */
+class delivery_filter {
+public:
+	delivery_filter();
+
+	void set_mode(int mode);
+	int get_mode(void);
+
+	/* heartbeat in us, 0 to disable */
+	void set_heartbeat(unsigned long long heartbeat);
+
+	/* one per value, the last one also applies to the values after it */
+	void set_thresholds(const sensord_delta_threshold_s *thresholds, int count);
+	const std::vector<sensord_delta_threshold_s> &get_thresholds(void);
+
+	/* returns true if data is to be delivered, which makes it the
+	 * sample the next ones are compared with */
+	bool push(const sensor_data_t &data);
+
+	/* the next sample is delivered, whatever the mode */
+	void reset(void);
+
+private:
+	bool need_delivery(const sensor_data_t &data);
+
+	int m_mode;
+	unsigned long long m_heartbeat;
+	std::vector<sensord_delta_threshold_s> m_thresholds;
+
+	bool m_delivered;
+	sensor_data_t m_last_delivered;
+};
+
+}
+
+#endif /* __DELIVERY_FILTER_H__ */
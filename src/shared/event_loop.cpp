@@ -35,6 +35,53 @@
 using namespace ipc;
 using namespace sensor;
 
+static const gint g_priorities[EVENT_PRIORITY_CNT] = {
+	G_PRIORITY_HIGH,
+	G_PRIORITY_HIGH / 2,
+	G_PRIORITY_DEFAULT,
+	G_PRIORITY_DEFAULT_IDLE,
+};
+
+static gint to_g_priority(unsigned int priority)
+{
+	if (priority >= EVENT_PRIORITY_CNT)
+		priority = EVENT_PRIORITY_HOUSEKEEPING;
+
+	return g_priorities[priority];
+}
+
+/* A source that is never ready, but is prepared first at every iteration
+ * of the loop, which is when the budgets start over */
+struct iteration_source {
+	GSource source;
+	event_loop *loop;
+};
+
+static gboolean iteration_prepare(GSource *src, gint *timeout)
+{
+	reinterpret_cast<iteration_source *>(src)->loop->begin_iteration();
+	*timeout = -1;
+
+	return FALSE;
+}
+
+static gboolean iteration_check(GSource *src)
+{
+	return FALSE;
+}
+
+static gboolean iteration_dispatch(GSource *src, GSourceFunc cb, gpointer data)
+{
+	return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs iteration_funcs = {
+	iteration_prepare,
+	iteration_check,
+	iteration_dispatch,
+	NULL,
+};
+
 static gboolean g_io_handler(GIOChannel *ch, GIOCondition condition, gpointer data)
 {
 	uint64_t id;
@@ -62,6 +109,10 @@ static gboolean g_io_handler(GIOChannel *ch, GIOCondition condition, gpointer da
 	if (cond & G_IO_NVAL)
 		return G_SOURCE_REMOVE;
 
+	/* over the budget, the fd is still ready at the next iteration */
+	if (!loop->admit(info->priority, info->g_src))
+		return G_SOURCE_CONTINUE;
+
 	ret = handler->handle(fd, (event_condition)cond);
 
 	if (!ret && !term) {
@@ -85,6 +136,8 @@ event_loop::event_loop()
 , m_running(false)
 , m_terminating(false)
 , m_sequence(1)
+, m_iteration_src(NULL)
+, m_iteration(0)
 , m_term_fd(-1)
 {
 	m_mainloop = g_main_loop_new(NULL, FALSE);
@@ -95,6 +148,8 @@ event_loop::event_loop(GMainLoop *mainloop)
 , m_running(true)
 , m_terminating(false)
 , m_sequence(1)
+, m_iteration_src(NULL)
+, m_iteration(0)
 , m_term_fd(-1)
 {
 	m_mainloop = mainloop;
@@ -115,7 +170,8 @@ void event_loop::set_mainloop(GMainLoop *mainloop)
 	m_mainloop = mainloop;
 }
 
-uint64_t event_loop::add_event(const int fd, const event_condition cond, event_handler *handler)
+uint64_t event_loop::add_event(const int fd, const event_condition cond, event_handler *handler,
+		int priority)
 {
 	AUTOLOCK(m_cmutex);
 	GIOChannel *ch = NULL;
@@ -139,10 +195,14 @@ uint64_t event_loop::add_event(const int fd, const event_condition cond, event_h
 		m_sequence = 1;
 	}
 
-	handler_info *info = new(std::nothrow) handler_info(id, fd, ch, src, handler, this);
+	if (priority < 0 || priority >= EVENT_PRIORITY_CNT)
+		priority = EVENT_PRIORITY_CONTROL;
+
+	handler_info *info = new(std::nothrow) handler_info(id, fd, ch, src, handler, this, priority);
 	retvm_if(!info, BAD_HANDLE, "Failed to allocate memory");
 
 	handler->set_event_id(id);
+	g_source_set_priority(src, to_g_priority(priority));
 	g_source_set_callback(src, (GSourceFunc) g_io_handler, info, NULL);
 	g_source_attach(src, g_main_loop_get_context(m_mainloop));
 
@@ -155,6 +215,9 @@ uint64_t event_loop::add_event(const int fd, const event_condition cond, event_h
 struct idler_data {
 	void (*m_fn)(size_t, void*);
 	void* m_data;
+	event_loop *m_loop;
+	GSource *m_src;
+	unsigned int m_priority;
 };
 
 size_t event_loop::add_idle_event(unsigned int priority, void (*fn)(size_t, void*), void* data)
@@ -168,12 +231,21 @@ size_t event_loop::add_idle_event(unsigned int priority, void (*fn)(size_t, void
 	src = g_idle_source_new();
 	retvm_if(!src, 0, "Failed to allocate memory");
 
+	if (priority >= EVENT_PRIORITY_CNT)
+		priority = EVENT_PRIORITY_HOUSEKEEPING;
+
 	idler_data *id = new idler_data();
 	id->m_fn = fn;
 	id->m_data = data;
+	id->m_loop = this;
+	id->m_src = src;
+	id->m_priority = priority;
 
+	g_source_set_priority(src, to_g_priority(priority));
 	g_source_set_callback(src, [](gpointer gdata) -> gboolean {
 		idler_data *id = (idler_data *)gdata;
+		if (!id->m_loop->admit(id->m_priority, id->m_src))
+			return G_SOURCE_CONTINUE;
 		id->m_fn((size_t)id, id->m_data);
 		delete id;
 		return G_SOURCE_REMOVE;
@@ -185,6 +257,103 @@ size_t event_loop::add_idle_event(unsigned int priority, void (*fn)(size_t, void
 	return (size_t)id;
 }
 
+void event_loop::set_budget(int priority, unsigned int budget)
+{
+	retm_if(priority < 0 || priority >= EVENT_PRIORITY_CNT, "Invalid priority[%d]", priority);
+
+	m_classes[priority].budget = budget;
+}
+
+/*
+ * Called on the loop only, before a source of the class is dispatched.
+ * A class that used up its budget yields: its ready sources step down below
+ * all classes for the next iteration, since GLib polls the lower priorities
+ * only if no higher one is ready. When they come back, the ones served in
+ * the round queue up behind the others.
+ */
+bool event_loop::admit(int priority, GSource *src)
+{
+	retv_if(!m_iteration_src, true);
+
+	class_state &state = m_classes[priority];
+	retv_if(state.budget == 0, true);
+
+	if (!state.yielding && state.round.size() < state.budget) {
+		state.round.push_back(g_source_ref(src));
+		return true;
+	}
+
+	if (!state.yielding) {
+		state.yielding = true;
+		state.yield_iteration = m_iteration;
+
+		for (auto it = state.round.begin(); it != state.round.end(); ++it)
+			defer(state, *it, true);
+
+		end_round(priority);
+	}
+
+	/* unless it was served in the round */
+	if (g_source_get_priority(src) != G_PRIORITY_LOW)
+		defer(state, src, false);
+
+	return false;
+}
+
+void event_loop::end_round(int priority)
+{
+	std::vector<GSource *> &round = m_classes[priority].round;
+
+	for (auto it = round.begin(); it != round.end(); ++it)
+		g_source_unref(*it);
+
+	round.clear();
+}
+
+void event_loop::defer(class_state &state, GSource *src, bool served)
+{
+	deferred_source deferred = {g_source_ref(src), served};
+
+	if (!g_source_is_destroyed(src))
+		g_source_set_priority(src, G_PRIORITY_LOW);
+
+	state.deferred.push_back(deferred);
+}
+
+void event_loop::restore(int priority)
+{
+	class_state &state = m_classes[priority];
+
+	/* a source is appended to the sources of its priority again */
+	for (bool served : {false, true}) {
+		for (auto it = state.deferred.begin(); it != state.deferred.end(); ++it) {
+			if (it->served != served)
+				continue;
+
+			if (!g_source_is_destroyed(it->src))
+				g_source_set_priority(it->src, to_g_priority(priority));
+			g_source_unref(it->src);
+		}
+	}
+
+	state.deferred.clear();
+	state.yielding = false;
+}
+
+/* Called from the prepare of the iteration source, the first one prepared.
+ * Every class starts a new round, so only a class with more ready sources
+ * than its budget in one iteration yields */
+void event_loop::begin_iteration(void)
+{
+	m_iteration++;
+
+	for (int i = 0; i < EVENT_PRIORITY_CNT; ++i) {
+		if (m_classes[i].yielding && m_iteration > m_classes[i].yield_iteration + 1)
+			restore(i);
+		end_round(i);
+	}
+}
+
 bool event_loop::remove_event(uint64_t id, bool close_channel)
 {
 	AUTOLOCK(m_cmutex);
@@ -267,6 +436,13 @@ bool event_loop::run(int timeout)
 
 	add_event(m_term_fd, EVENT_IN | EVENT_HUP | EVENT_NVAL, handler);
 
+	m_iteration_src = g_source_new(&iteration_funcs, sizeof(iteration_source));
+	if (m_iteration_src) {
+		reinterpret_cast<iteration_source *>(m_iteration_src)->loop = this;
+		g_source_set_priority(m_iteration_src, G_PRIORITY_HIGH - 1);
+		g_source_attach(m_iteration_src, g_main_loop_get_context(m_mainloop));
+	}
+
 	m_running.store(true);
 
 	_I("Started");
@@ -286,6 +462,17 @@ void event_loop::terminate(void)
 {
 	remove_all_events();
 
+	for (int i = 0; i < EVENT_PRIORITY_CNT; ++i) {
+		restore(i);
+		end_round(i);
+	}
+
+	if (m_iteration_src) {
+		g_source_destroy(m_iteration_src);
+		g_source_unref(m_iteration_src);
+		m_iteration_src = NULL;
+	}
+
 	if (m_mainloop) {
 		g_main_loop_quit(m_mainloop);
 		g_main_loop_unref(m_mainloop);
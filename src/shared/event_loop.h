@@ -24,6 +24,7 @@
 #include <glib.h>
 #include <atomic>
 #include <map>
+#include <vector>
 
 #include "event_handler.h"
 #include "cmutex.h"
@@ -37,6 +38,18 @@ enum event_condition_e {
 	EVENT_NVAL = G_IO_NVAL,
 };
 
+/* Scheduling classes, the first one first. A ready class is dispatched
+ * before the ones after it, and with a budget it is dispatched that many
+ * times at most in one iteration of the loop before it yields to them for
+ * the next one; its sources are served round-robin. */
+enum event_priority_e {
+	EVENT_PRIORITY_INGEST = 0,	/* HAL reads */
+	EVENT_PRIORITY_DELIVERY,	/* event sends the socket could not take at once */
+	EVENT_PRIORITY_CONTROL,		/* commands and connections */
+	EVENT_PRIORITY_HOUSEKEEPING,	/* deferred deletions */
+	EVENT_PRIORITY_CNT,
+};
+
 /* move it to file */
 class idle_handler {
 	virtual ~idle_handler();
@@ -47,9 +60,11 @@ class event_loop;
 
 class handler_info {
 public:
-	handler_info(uint64_t _id, int _fd, GIOChannel *_ch, GSource *_src, event_handler *_handler, event_loop *_loop)
+	handler_info(uint64_t _id, int _fd, GIOChannel *_ch, GSource *_src, event_handler *_handler, event_loop *_loop,
+			int _priority)
 	: id(_id)
 	, fd(_fd)
+	, priority(_priority)
 	, g_ch(_ch)
 	, g_src(_src)
 	, handler(_handler)
@@ -58,6 +73,7 @@ public:
 
 	uint64_t id;
 	int fd;
+	int priority;
 	GIOChannel *g_ch;
 	GSource *g_src;
 	event_handler *handler;
@@ -75,9 +91,16 @@ public:
 
 	void set_mainloop(GMainLoop *mainloop);
 
-	uint64_t add_event(const int fd, const event_condition cond, event_handler *handler);
+	uint64_t add_event(const int fd, const event_condition cond, event_handler *handler,
+			int priority = EVENT_PRIORITY_CONTROL);
 	size_t add_idle_event(unsigned int priority, void (*fn)(size_t, void*), void* data);
 
+	/* dispatches of a class before the classes after it get their turn,
+	 * 0 (default) for no limit. budgets apply once the loop is run() */
+	void set_budget(int priority, unsigned int budget);
+	bool admit(int priority, GSource *src);
+	void begin_iteration(void);
+
 	bool remove_event(uint64_t id, bool close_channel = false);
 	void remove_all_events(void);
 
@@ -97,6 +120,33 @@ private:
 	std::atomic<uint64_t> m_sequence;
 	std::map<uint64_t, handler_info *> m_handlers;
 
+	struct deferred_source {
+		GSource *src;
+		bool served;
+	};
+
+	struct class_state {
+		class_state()
+		: budget(0)
+		, yielding(false)
+		, yield_iteration(0)
+		{}
+
+		unsigned int budget;
+		bool yielding;
+		uint64_t yield_iteration;
+		std::vector<GSource *> round;	/* dispatched in this iteration */
+		std::vector<deferred_source> deferred;
+	};
+
+	class_state m_classes[EVENT_PRIORITY_CNT];
+	GSource *m_iteration_src;
+	uint64_t m_iteration;
+
+	void end_round(int priority);
+	void defer(class_state &state, GSource *src, bool served);
+	void restore(int priority);
+
 	int m_term_fd;
 	sensor::cmutex m_cmutex;
 };
@@ -0,0 +1,119 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __FAST_MATH_H__
+#define __FAST_MATH_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/* maximum absolute errors in radians, as measured over the whole domain */
+#define FAST_ATAN2_MAX_ERROR 3e-6f
+#define FAST_ASIN_MAX_ERROR 1e-6f
+/* maximum relative error */
+#define FAST_RSQRT_MAX_ERROR 6e-6f
+
+namespace sensor {
+
+/* Single-precision approximations of the libm calls made per sample by
+ * the fusion sensors. atan and asin are Hastings-style minimax
+ * polynomials (asin is Abramowitz & Stegun 4.4.46). They give up a few
+ * decimals for a short, branch-light body that the compiler can inline. */
+namespace fast_math {
+
+static inline float atanf_unit(float t)
+{
+	/* |t| <= 1 */
+	float t2 = t * t;
+
+	return t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f +
+			t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+}
+
+static inline float atan2f(float y, float x)
+{
+	float ax = fabsf(x);
+	float ay = fabsf(y);
+	float hi = fmaxf(ax, ay);
+	float r;
+
+	if (hi == 0)
+		return 0;
+
+	/* selects rather than branches, the octant changes from sample to
+	 * sample when the device is moved */
+	r = atanf_unit(fminf(ax, ay) / hi);
+	r = (ay > ax) ? (float)M_PI_2 - r : r;
+	r = (x < 0) ? (float)M_PI - r : r;
+
+	return copysignf(r, y);
+}
+
+static inline float asinf(float x)
+{
+	float ax = fabsf(x);
+	float r;
+
+	if (ax >= 1)
+		return copysignf((float)M_PI_2, x);
+
+	r = 1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f +
+			ax * (-0.0501743046f + ax * (0.0308918810f + ax * (-0.0170881256f +
+			ax * (0.0066700901f + ax * -0.0012624911f))))));
+	r = (float)M_PI_2 - sqrtf(1 - ax) * r;
+
+	return copysignf(r, x);
+}
+
+static inline float acosf(float x)
+{
+	return (float)M_PI_2 - asinf(x);
+}
+
+/* 1 / sqrt(x) for x > 0, initial guess from the exponent bits refined by
+ * two Newton-Raphson steps */
+static inline float rsqrtf(float x)
+{
+	uint32_t i;
+	float y;
+
+	memcpy(&i, &x, sizeof(i));
+	i = 0x5f375a86 - (i >> 1);
+	memcpy(&y, &i, sizeof(y));
+
+	y = y * (1.5f - 0.5f * x * y * y);
+	y = y * (1.5f - 0.5f * x * y * y);
+
+	return y;
+}
+
+/* Batched conversions of n quaternions (x, y, z, w), read every stride
+ * floats so that the values of a sensor_data_t array can be walked in
+ * place. quat_to_matrix writes 9 floats and quat_to_euler writes azimuth,
+ * pitch and roll in degrees, as quat_to_orientation() of the fusion
+ * plugin, 3 floats per quaternion. */
+void quat_to_matrix(const float *quat, int stride, float *R, int n);
+void quat_to_euler(const float *quat, int stride, float *euler, int n);
+
+}
+
+}
+
+#endif /* __FAST_MATH_H__ */
@@ -0,0 +1,291 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "input_resampler.h"
+
+#include <math.h>
+#include <string.h>
+
+/* below this angle slerp is replaced by a normalized lerp */
+#define SLERP_MIN_DOT 0.9995f
+
+input_resampler::input_resampler(unsigned long long window, unsigned long long period)
+: m_window(window)
+, m_period(period)
+, m_newest(0)
+, m_flushed(0)
+, m_clock(0)
+, m_stream_count(0)
+{
+}
+
+input_resampler::~input_resampler()
+{
+}
+
+int input_resampler::add_stream(int value_count, unsigned long long max_gap,
+		resample_interpolation_e interpolation)
+{
+	if (m_stream_count == RESAMPLER_MAX_STREAMS)
+		return -1;
+
+	stream_s &stream = m_streams[m_stream_count];
+
+	stream.value_count = value_count < RESAMPLER_MAX_VALUES ? value_count : RESAMPLER_MAX_VALUES;
+	stream.max_gap = max_gap;
+	stream.interpolation = interpolation;
+	stream.released = 0;
+	stream.queue.clear();
+
+	return m_stream_count++;
+}
+
+void input_resampler::reset(void)
+{
+	for (int i = 0; i < m_stream_count; ++i) {
+		m_streams[i].released = 0;
+		m_streams[i].queue.clear();
+	}
+
+	m_newest = 0;
+	m_flushed = 0;
+	m_clock = 0;
+}
+
+void input_resampler::flush(void)
+{
+	m_flushed = m_newest;
+}
+
+void input_resampler::push(int stream, unsigned long long timestamp, const float *values)
+{
+	if (stream < 0 || stream >= m_stream_count)
+		return;
+
+	stream_s &s = m_streams[stream];
+
+	/* too late, a newer sample of the stream was already released */
+	if (timestamp < s.released)
+		return;
+
+	resampler_sample_s sample;
+	sample.timestamp = timestamp;
+	memcpy(sample.values, values, s.value_count * sizeof(float));
+
+	/* samples mostly come in order, so sort in from the back */
+	s.queue.push(sample);
+	for (int i = s.queue.size() - 1; i > 0 && s.queue[i - 1].timestamp > timestamp; --i) {
+		s.queue[i] = s.queue[i - 1];
+		s.queue[i - 1] = sample;
+	}
+
+	if (timestamp > m_newest)
+		m_newest = timestamp;
+}
+
+bool input_resampler::pop(resampler_frame_s &frame)
+{
+	if (m_period)
+		return pop_resampled(frame);
+
+	return pop_merged(frame);
+}
+
+bool input_resampler::is_final(unsigned long long timestamp)
+{
+	return timestamp + m_window <= m_newest || timestamp <= m_flushed;
+}
+
+bool input_resampler::is_any_full(void)
+{
+	for (int i = 0; i < m_stream_count; ++i) {
+		if (m_streams[i].queue.full())
+			return true;
+	}
+
+	return false;
+}
+
+bool input_resampler::pop_merged(resampler_frame_s &frame)
+{
+	int oldest = -1;
+
+	for (int i = 0; i < m_stream_count; ++i) {
+		if (m_streams[i].queue.empty())
+			continue;
+		if (oldest < 0 || m_streams[i].queue.front().timestamp <
+				m_streams[oldest].queue.front().timestamp)
+			oldest = i;
+	}
+
+	if (oldest < 0)
+		return false;
+
+	stream_s &s = m_streams[oldest];
+	const resampler_sample_s &sample = s.queue.front();
+
+	/* a full queue is flushed rather than dropping its oldest sample */
+	if (!is_final(sample.timestamp) && !is_any_full())
+		return false;
+
+	frame.timestamp = sample.timestamp;
+	frame.stream = oldest;
+	frame.valid = 1 << oldest;
+	memcpy(frame.values[oldest], sample.values, s.value_count * sizeof(float));
+
+	s.released = sample.timestamp;
+	s.queue.pop();
+
+	return true;
+}
+
+bool input_resampler::pop_resampled(resampler_frame_s &frame)
+{
+	if (m_stream_count == 0)
+		return false;
+
+	if (m_clock == 0) {
+		unsigned long long start = 0;
+
+		/* the clock starts when every stream can be interpolated */
+		for (int i = 0; i < m_stream_count; ++i) {
+			if (m_streams[i].queue.empty())
+				return false;
+			if (m_streams[i].queue.front().timestamp > start)
+				start = m_streams[i].queue.front().timestamp;
+		}
+
+		m_clock = start;
+	}
+
+	if (!is_final(m_clock))
+		return false;
+
+	bool full = is_any_full();
+
+	for (int i = 0; i < m_stream_count; ++i) {
+		const stream_s &s = m_streams[i];
+
+		if (s.queue.empty())
+			return false;
+
+		/* a stream that stopped holds its last value once the others
+		 * have no room left to wait for it */
+		if (full)
+			continue;
+
+		if (s.interpolation == RESAMPLE_HOLD) {
+			if (!is_final(m_clock + m_period) || s.queue.back().timestamp <= m_clock + m_period)
+				return false;
+		} else if (s.queue.back().timestamp < m_clock) {
+			return false;
+		}
+	}
+
+	frame.timestamp = m_clock;
+	frame.stream = -1;
+	frame.valid = 0;
+
+	for (int i = 0; i < m_stream_count; ++i) {
+		if (interpolate(m_streams[i], m_clock, frame.values[i]))
+			frame.valid |= 1 << i;
+	}
+
+	m_clock += m_period;
+
+	return true;
+}
+
+bool input_resampler::interpolate(stream_s &s, unsigned long long timestamp, float *values)
+{
+	unsigned long long newest = timestamp;
+
+	if (s.interpolation == RESAMPLE_HOLD)
+		newest += m_period;
+
+	/* keep the newest sample at or before the timestamp, or the end of
+	 * the step when held */
+	while (s.queue.size() > 1 && s.queue[1].timestamp <= newest) {
+		s.released = s.queue.front().timestamp;
+		s.queue.pop();
+	}
+
+	const resampler_sample_s &a = s.queue.front();
+
+	if (s.interpolation == RESAMPLE_HOLD && a.timestamp > timestamp) {
+		memcpy(values, a.values, s.value_count * sizeof(float));
+		return true;
+	}
+
+	if (s.queue.size() == 1 || a.timestamp >= timestamp) {
+		memcpy(values, a.values, s.value_count * sizeof(float));
+		unsigned long long gap = (a.timestamp > timestamp) ?
+			a.timestamp - timestamp : timestamp - a.timestamp;
+		return !s.max_gap || gap <= s.max_gap;
+	}
+
+	const resampler_sample_s &b = s.queue[1];
+
+	if (s.max_gap && b.timestamp - a.timestamp > s.max_gap)
+		return false;
+
+	float t = (float)(timestamp - a.timestamp) / (b.timestamp - a.timestamp);
+
+	if (s.interpolation == RESAMPLE_SLERP && s.value_count == 4) {
+		float dot = 0;
+		float sign = 1;
+
+		for (int i = 0; i < 4; ++i)
+			dot += a.values[i] * b.values[i];
+
+		/* q and -q are the same rotation, take the shorter arc */
+		if (dot < 0) {
+			dot = -dot;
+			sign = -1;
+		}
+
+		if (dot < SLERP_MIN_DOT) {
+			float theta = acosf(dot);
+			float inv_sin = 1.0f / sinf(theta);
+			float wa = sinf((1 - t) * theta) * inv_sin;
+			float wb = sinf(t * theta) * inv_sin * sign;
+
+			for (int i = 0; i < 4; ++i)
+				values[i] = wa * a.values[i] + wb * b.values[i];
+			return true;
+		}
+
+		float norm = 0;
+
+		for (int i = 0; i < 4; ++i) {
+			values[i] = (1 - t) * a.values[i] + t * sign * b.values[i];
+			norm += values[i] * values[i];
+		}
+
+		norm = sqrtf(norm);
+		for (int i = 0; i < 4; ++i)
+			values[i] /= norm;
+		return true;
+	}
+
+	for (int i = 0; i < s.value_count; ++i)
+		values[i] = (1 - t) * a.values[i] + t * b.values[i];
+
+	return true;
+}
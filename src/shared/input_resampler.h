@@ -0,0 +1,141 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __INPUT_RESAMPLER_H__
+#define __INPUT_RESAMPLER_H__
+
+#include "ring_buffer.h"
+
+#define RESAMPLER_MAX_STREAMS 4
+#define RESAMPLER_MAX_VALUES 4
+/* pending samples per stream, a little more than a 1s FIFO burst at 200Hz.
+ * a longer burst releases its oldest samples before the window ends */
+#define RESAMPLER_QUEUE_SIZE 256
+
+enum resample_interpolation_e {
+	RESAMPLE_LINEAR = 0,
+	/* spherical interpolation of unit quaternions */
+	RESAMPLE_SLERP,
+	/* the newest sample of the period after the step, linear only when
+	 * there is none. a step is released once a sample past that period
+	 * arrived. this is the output of the former pedometer compensator,
+	 * on which the step detection is tuned */
+	RESAMPLE_HOLD,
+};
+
+struct resampler_sample_s {
+	unsigned long long timestamp;
+	float values[RESAMPLER_MAX_VALUES];
+};
+
+/************************************************************************
+ * one step of the resampler.
+ *
+ * when resampling, every stream is interpolated at timestamp and stream
+ * is -1. when only merging, stream is the stream the sample came from and
+ * only its values are set. valid has the bit (1 << stream) of each stream
+ * with values, a stream has none in a gap longer than its max_gap.
+ */
+struct resampler_frame_s {
+	unsigned long long timestamp;
+	int stream;
+	unsigned int valid;
+	float values[RESAMPLER_MAX_STREAMS][RESAMPLER_MAX_VALUES];
+};
+
+/************************************************************************
+ * reorders and resamples the inputs of a fusion sensor.
+ *
+ * samples of several streams may be pushed in any order as long as they
+ * are no more than the window late, i.e. older than the newest sample
+ * pushed minus the window. they are released in timestamp order once
+ * no earlier sample can arrive anymore. with a period, the streams are
+ * interpolated on a common clock of that period instead, so that the
+ * filter is run in fixed steps whatever the rates and batching of its
+ * inputs. timestamps are in any unit, as long as it is the same for the
+ * samples, the window and the period.
+ */
+class input_resampler {
+public:
+
+	input_resampler(unsigned long long window, unsigned long long period = 0);
+
+	~input_resampler();
+
+	/************************************************************************
+	 * adds an input stream, samples more than max_gap apart are not
+	 * interpolated, 0 interpolates over any gap.
+	 *
+	 * @return index of the stream, -1 if there are too many streams.
+	 */
+	int add_stream(int value_count, unsigned long long max_gap = 0,
+			resample_interpolation_e interpolation = RESAMPLE_LINEAR);
+
+	/************************************************************************
+	 * queues a sample, samples later than the window are dropped.
+	 */
+	void push(int stream, unsigned long long timestamp, const float *values);
+
+	/************************************************************************
+	 * @return true and the next frame if one is complete.
+	 */
+	bool pop(resampler_frame_s &frame);
+
+	/************************************************************************
+	 * releases the pending samples without waiting for the window, once
+	 * no earlier sample can arrive anymore, e.g. after the FIFO bursts of
+	 * every stream were pushed.
+	 */
+	void flush(void);
+
+	/************************************************************************
+	 * drops the pending samples and restarts the clock.
+	 */
+	void reset(void);
+
+private:
+	struct stream_s {
+		int value_count;
+		unsigned long long max_gap;
+		resample_interpolation_e interpolation;
+		/* newest sample released, nothing older is accepted */
+		unsigned long long released;
+		ring_buffer<resampler_sample_s, RESAMPLER_QUEUE_SIZE> queue;
+	};
+
+	bool pop_merged(resampler_frame_s &frame);
+	bool pop_resampled(resampler_frame_s &frame);
+	bool interpolate(stream_s &stream, unsigned long long timestamp, float *values);
+	bool is_final(unsigned long long timestamp);
+	bool is_any_full(void);
+
+	unsigned long long m_window;
+	unsigned long long m_period;
+	/* newest timestamp pushed to any stream */
+	unsigned long long m_newest;
+	/* newest timestamp pushed when flushed, nothing older is held */
+	unsigned long long m_flushed;
+	/* next step of the common clock, 0 until every stream has a sample */
+	unsigned long long m_clock;
+
+	stream_s m_streams[RESAMPLER_MAX_STREAMS];
+	int m_stream_count;
+};
+
+#endif /* __INPUT_RESAMPLER_H__ */
@@ -27,12 +27,55 @@
 
 using namespace ipc;
 
-#define MAX_CONNECTIONS 1000
+/* pending connections, unless a limit of connections is set */
+#define MAX_BACKLOG 1000
+
+ipc_server::counting_handler::counting_handler(ipc_server *server)
+: m_server(server)
+{
+}
+
+void ipc_server::counting_handler::connected(channel *ch)
+{
+	m_server->m_connections.fetch_add(1, std::memory_order_relaxed);
+
+	if (m_server->m_handler)
+		m_server->m_handler->connected(ch);
+}
+
+void ipc_server::counting_handler::disconnected(channel *ch)
+{
+	m_server->m_connections.fetch_sub(1, std::memory_order_relaxed);
+
+	if (m_server->m_handler)
+		m_server->m_handler->disconnected(ch);
+}
+
+void ipc_server::counting_handler::read(channel *ch, message &msg)
+{
+	if (m_server->m_handler)
+		m_server->m_handler->read(ch, msg);
+}
+
+void ipc_server::counting_handler::read_complete(channel *ch)
+{
+	if (m_server->m_handler)
+		m_server->m_handler->read_complete(ch);
+}
+
+void ipc_server::counting_handler::error_caught(channel *ch, int error)
+{
+	if (m_server->m_handler)
+		m_server->m_handler->error_caught(ch, error);
+}
 
 ipc_server::ipc_server(const std::string &path)
 : m_event_loop(NULL)
 , m_handler(NULL)
 , m_accept_handler(NULL)
+, m_counter(this)
+, m_max_connections(0)
+, m_connections(0)
 {
 	m_accept_sock.create(path);
 }
@@ -49,15 +92,31 @@ bool ipc_server::set_option(int option, int value)
 
 bool ipc_server::set_option(const std::string &option, int value)
 {
+	if (option == "max_connection") {
+		retvm_if(value <= 0, false, "Invalid max_connection[%d]", value);
+		m_max_connections = value;
+		return true;
+	}
+
 	/* TODO */
 	return true;
 }
 
-void ipc_server::accept(ipc::socket &cli_sock)
+bool ipc_server::accept(ipc::socket &cli_sock)
 {
-	m_accept_sock.accept(cli_sock);
+	retv_if(!m_accept_sock.accept(cli_sock), false);
 
 	_D("Accepted[%d]", cli_sock.get_fd());
+	return true;
+}
+
+/* no limit unless "max_connection" is set */
+bool ipc_server::is_full(void)
+{
+	if (m_max_connections == 0)
+		return false;
+
+	return m_connections.load(std::memory_order_relaxed) >= m_max_connections;
 }
 
 bool ipc_server::bind(channel_handler *handler, event_loop *loop)
@@ -66,7 +125,7 @@ bool ipc_server::bind(channel_handler *handler, event_loop *loop)
 	m_event_loop = loop;
 
 	m_accept_sock.bind();
-	m_accept_sock.listen(MAX_CONNECTIONS);
+	m_accept_sock.listen(m_max_connections ? m_max_connections : MAX_BACKLOG);
 
 	register_acceptor();
 
@@ -76,7 +135,7 @@ bool ipc_server::bind(channel_handler *handler, event_loop *loop)
 
 void ipc_server::register_channel(int fd, channel *ch)
 {
-	channel_event_handler *ev_handler = new(std::nothrow) channel_event_handler(ch, m_handler);
+	channel_event_handler *ev_handler = new(std::nothrow) channel_event_handler(ch, &m_counter);
 	retm_if(!ev_handler, "Failed to allocate memory");
 
 	uint64_t id = ch->bind(ev_handler, m_event_loop, true);
@@ -21,6 +21,7 @@
 #define __IPC_SERVER_H__
 
 #include <string>
+#include <atomic>
 
 #include "stream_socket.h"
 #include "channel.h"
@@ -42,16 +43,36 @@ public:
 	bool close(void);
 
 	/* TODO: only accept_handler should use these functions */
-	void accept(ipc::socket &cli_sock);
+	bool accept(ipc::socket &cli_sock);
+	bool is_full(void);
 	void register_channel(int fd, channel *ch);
 	void register_acceptor(void);
 
 private:
+	/* passes the events on to the handler, counting open connections */
+	class counting_handler : public channel_handler {
+	public:
+		counting_handler(ipc_server *server);
+
+		void connected(channel *ch);
+		void disconnected(channel *ch);
+		void read(channel *ch, message &msg);
+		void read_complete(channel *ch);
+		void error_caught(channel *ch, int error);
+
+	private:
+		ipc_server *m_server;
+	};
+
 	stream_socket m_accept_sock;
 
 	event_loop *m_event_loop;
 	channel_handler *m_handler;
 	accept_event_handler *m_accept_handler;
+	counting_handler m_counter;
+
+	int m_max_connections;
+	std::atomic<int> m_connections;
 };
 
 }
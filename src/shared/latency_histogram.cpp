@@ -0,0 +1,122 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "latency_histogram.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace sensor;
+
+latency_histogram::latency_histogram()
+{
+	reset();
+}
+
+int latency_histogram::index(uint64_t value)
+{
+	if (value < LATENCY_SUB_BUCKETS)
+		return value;
+
+	if (value >= (1ULL << (LATENCY_MAX_BITS + 1)))
+		return LATENCY_BUCKETS - 1;
+
+	/* keep the top LATENCY_SUB_BUCKET_BITS bits of the value */
+	int msb = 63 - __builtin_clzll(value);
+	int shift = msb - (LATENCY_SUB_BUCKET_BITS - 1);
+	int top = value >> shift;
+
+	return LATENCY_SUB_BUCKETS + (shift - 1) * LATENCY_HALF_BUCKETS + (top - LATENCY_HALF_BUCKETS);
+}
+
+uint64_t latency_histogram::upper(int index)
+{
+	if (index < LATENCY_SUB_BUCKETS)
+		return index;
+
+	int shift = (index - LATENCY_SUB_BUCKETS) / LATENCY_HALF_BUCKETS + 1;
+	uint64_t top = (index - LATENCY_SUB_BUCKETS) % LATENCY_HALF_BUCKETS + LATENCY_HALF_BUCKETS;
+
+	return ((top + 1) << shift) - 1;
+}
+
+void latency_histogram::record(uint64_t value)
+{
+	m_counts[index(value)].fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t max = m_max.load(std::memory_order_relaxed);
+	while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+		;
+}
+
+void latency_histogram::reset(void)
+{
+	for (int i = 0; i < LATENCY_BUCKETS; ++i)
+		m_counts[i].store(0, std::memory_order_relaxed);
+
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t latency_histogram::count(void)
+{
+	uint64_t total = 0;
+
+	for (int i = 0; i < LATENCY_BUCKETS; ++i)
+		total += m_counts[i].load(std::memory_order_relaxed);
+
+	return total;
+}
+
+uint64_t latency_histogram::max(void)
+{
+	return m_max.load(std::memory_order_relaxed);
+}
+
+/* Returns the upper bound of the bucket holding the percentile, in the
+ * unit of the recorded values, or 0 if nothing was recorded */
+uint64_t latency_histogram::percentile(double percentile)
+{
+	uint64_t total = count();
+	if (total == 0)
+		return 0;
+
+	uint64_t rank = (uint64_t)std::ceil(percentile / 100.0 * total);
+	uint64_t seen = 0;
+
+	if (rank == 0)
+		rank = 1;
+
+	for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+		seen += m_counts[i].load(std::memory_order_relaxed);
+		if (seen >= rank)
+			return std::min(upper(i), max());
+	}
+
+	return max();
+}
+
+latency_histogram &latency_histogram::get(int stage)
+{
+	static latency_histogram histograms[SENSORD_LATENCY_STAGE_MAX];
+
+	if (stage < 0 || stage >= SENSORD_LATENCY_STAGE_MAX)
+		stage = SENSORD_LATENCY_END_TO_END;
+
+	return histograms[stage];
+}
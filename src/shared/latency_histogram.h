@@ -0,0 +1,66 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __LATENCY_HISTOGRAM_H__
+#define __LATENCY_HISTOGRAM_H__
+
+#include <stdint.h>
+#include <sensor_types.h>
+#include <atomic>
+
+/* 2^5 sub-buckets per power of two, so a bucket is at most 1/16 wide */
+#define LATENCY_SUB_BUCKET_BITS 5
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_HALF_BUCKETS (LATENCY_SUB_BUCKETS / 2)
+
+/* values from 2^(LATENCY_MAX_BITS + 1) on share the last bucket */
+#define LATENCY_MAX_BITS 36
+#define LATENCY_BUCKETS \
+	(LATENCY_SUB_BUCKETS + (LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_HALF_BUCKETS)
+
+namespace sensor {
+
+/* Log-linear histogram in the style of HdrHistogram.
+ * Recording is a couple of relaxed atomic increments, so it is safe to
+ * call from any thread and cheap enough to stay on in production. */
+class latency_histogram {
+public:
+	latency_histogram();
+
+	void record(uint64_t value);
+	void reset(void);
+
+	uint64_t count(void);
+	uint64_t max(void);
+	uint64_t percentile(double percentile);
+
+	/* per-process histograms, one per sensord_latency_stage_e */
+	static latency_histogram &get(int stage);
+
+private:
+	static int index(uint64_t value);
+	static uint64_t upper(int index);
+
+	std::atomic<uint64_t> m_counts[LATENCY_BUCKETS];
+	std::atomic<uint64_t> m_max;
+};
+
+}
+
+#endif /* __LATENCY_HISTOGRAM_H__ */
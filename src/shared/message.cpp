@@ -56,6 +56,7 @@ message::message(const message &msg)
 	, m_msg((char *)malloc(sizeof(char) * msg.m_capacity))
 {
 	::memcpy(&m_header, &msg.m_header, sizeof(message_header));
+	::memcpy(&m_trailer, &msg.m_trailer, sizeof(message_trailer));
 	::memcpy(m_msg, msg.m_msg, msg.m_size);
 }
 
@@ -106,6 +107,45 @@ void message::disclose(void *msg, const size_t size)
 	::memcpy(msg, m_msg, m_size);
 }
 
+/* Make room for a body of the given size that is written in place,
+ * e.g. straight from a socket. One more byte is kept for a terminator. */
+char *message::reserve(const size_t size)
+{
+	if (!m_msg || m_capacity <= size) {
+		char *msg = (char *)realloc(m_msg, size + 1);
+		retvm_if(!msg, NULL, "Failed to allocate memory");
+
+		m_msg = msg;
+		m_capacity = size + 1;
+	}
+
+	m_size = size;
+	m_header.length = size;
+
+	return m_msg;
+}
+
+/* Hand the body over to the caller, who must free() it.
+ * The message is left empty. */
+char *message::release(void)
+{
+	char *msg = m_msg;
+
+	/* do not pin a whole capacity-sized buffer for a small body */
+	if (msg && m_size > 0 && m_size < m_capacity) {
+		char *shrunk = (char *)realloc(msg, m_size);
+		if (shrunk)
+			msg = shrunk;
+	}
+
+	m_msg = NULL;
+	m_size = 0;
+	m_capacity = 0;
+	m_header.length = 0;
+
+	return msg;
+}
+
 uint32_t message::type(void)
 {
 	return m_header.type;
@@ -126,6 +166,11 @@ message_header *message::header(void)
 	return &m_header;
 }
 
+message_trailer *message::trailer(void)
+{
+	return &m_trailer;
+}
+
 char *message::body(void)
 {
 	return m_msg;
@@ -26,6 +26,7 @@
 
 #define MAX_MSG_CAPACITY (32*1024)
 #define MAX_HEADER_RESERVED 3
+#define MAX_TRAILER_SIZE 1024
 
 namespace ipc {
 
@@ -34,9 +35,17 @@ typedef struct message_header {
 	uint32_t type { 0 };
 	size_t length { 0 };
 	int32_t err { 0 };
+	uint32_t trailer { 0 };	/* size of the trailer following the body */
 	void *ancillary[MAX_HEADER_RESERVED] { nullptr };
 } message_header;
 
+/* Optional delivery timestamps (us, CLOCK_MONOTONIC) sent after the body */
+typedef struct message_trailer {
+	uint64_t read { 0 };	/* read from the HAL */
+	uint64_t notify { 0 };	/* passed to the sensor handler */
+	uint64_t write { 0 };	/* written to the socket */
+} message_trailer;
+
 class message {
 public:
 	template <class... Args>
@@ -56,6 +65,9 @@ public:
 	void enclose(int error);
 	void disclose(void *msg, const size_t size);
 
+	char *reserve(const size_t size);
+	char *release(void);
+
 	uint32_t type(void);
 	void set_type(uint32_t type);
 
@@ -66,10 +78,12 @@ public:
 	int  ref_count(void);
 
 	message_header *header(void);
+	message_trailer *trailer(void);
 	char *body(void);
 
 private:
 	message_header m_header;
+	message_trailer m_trailer;
 	size_t m_size;
 	size_t m_capacity;
 
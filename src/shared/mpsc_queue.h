@@ -0,0 +1,149 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <new>
+
+namespace sensor {
+
+/* Bounded lock-free queue for many producer threads and a single consumer.
+ * Each cell carries a sequence number telling whose turn it is, so producers
+ * only contend on the enqueue position and never block the consumer. */
+template <typename T>
+class mpsc_queue {
+public:
+	/* capacity is rounded up to a power of two */
+	mpsc_queue(size_t capacity)
+	: m_cells(NULL)
+	, m_mask(0)
+	, m_enqueue_pos(0)
+	, m_dequeue_pos(0)
+	{
+		size_t size = 2;
+
+		while (size < capacity)
+			size <<= 1;
+
+		m_cells = new(std::nothrow) cell[size];
+		if (!m_cells)
+			return;
+
+		m_mask = size - 1;
+
+		for (size_t i = 0; i < size; ++i)
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~mpsc_queue()
+	{
+		delete [] m_cells;
+	}
+
+	bool is_valid(void) const
+	{
+		return m_cells != NULL;
+	}
+
+	/* may be called from any thread, returns false if the queue is full */
+	bool push(const T &item)
+	{
+		if (!m_cells)
+			return false;
+
+		cell *c;
+		size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+		for (;;) {
+			c = &m_cells[pos & m_mask];
+			size_t seq = c->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+			if (diff == 0) {
+				if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = m_enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		c->data = item;
+		c->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/* must only be called from the consumer thread */
+	bool pop(T &item)
+	{
+		if (!m_cells)
+			return false;
+
+		size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+		cell *c = &m_cells[pos & m_mask];
+		size_t seq = c->sequence.load(std::memory_order_acquire);
+
+		if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+			return false;
+
+		item = c->data;
+		c->sequence.store(pos + m_mask + 1, std::memory_order_release);
+		m_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	/* approximate while producers are running */
+	size_t size(void) const
+	{
+		size_t head = m_enqueue_pos.load(std::memory_order_relaxed);
+		size_t tail = m_dequeue_pos.load(std::memory_order_relaxed);
+
+		return (head > tail) ? (head - tail) : 0;
+	}
+
+	size_t capacity(void) const
+	{
+		return m_cells ? (m_mask + 1) : 0;
+	}
+
+private:
+	struct cell {
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	cell *m_cells;
+	size_t m_mask;
+
+	/* keep producers and the consumer off each other's cache line */
+	std::atomic<size_t> m_enqueue_pos;
+	char m_padding[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> m_dequeue_pos;
+};
+
+}
+
+#endif /* __MPSC_QUEUE_H__ */
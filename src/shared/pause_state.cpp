@@ -0,0 +1,79 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "pause_state.h"
+
+using namespace sensor;
+
+pause_state::pause_state(int policy)
+: m_policy(policy)
+, m_state(0)
+, m_started(false)
+, m_paused(false)
+{
+}
+
+int pause_state::set_policy(int policy)
+{
+	m_policy = policy;
+	return update();
+}
+
+int pause_state::get_policy(void)
+{
+	return m_policy;
+}
+
+int pause_state::set_power_save_state(int state)
+{
+	m_state = state;
+	return update();
+}
+
+void pause_state::start(void)
+{
+	m_started = true;
+	m_paused = false;
+}
+
+void pause_state::stop(void)
+{
+	m_started = false;
+	m_paused = false;
+}
+
+bool pause_state::is_paused(void)
+{
+	return m_paused;
+}
+
+int pause_state::update(void)
+{
+	if (!m_started)
+		return PAUSE_ACTION_NONE;
+
+	bool paused = (m_state & m_policy) != 0;
+
+	if (paused == m_paused)
+		return PAUSE_ACTION_NONE;
+
+	m_paused = paused;
+
+	return paused ? PAUSE_ACTION_STOP : PAUSE_ACTION_RESUME;
+}
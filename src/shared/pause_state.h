@@ -0,0 +1,60 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __PAUSE_STATE_H__
+#define __PAUSE_STATE_H__
+
+namespace sensor {
+
+enum pause_action_e {
+	PAUSE_ACTION_NONE = 0,
+	PAUSE_ACTION_STOP,	/* the listener is to be stopped for its policy */
+	PAUSE_ACTION_RESUME,	/* the listener is to run again */
+};
+
+/* Whether a started listener is paused by its pause policy (see
+ * sensord_pause_e) in the current power save state. Each change returns
+ * what the listener has to do about it, so that a listener is resumed
+ * however it stopped being covered, be it by the state or by its policy. */
+class pause_state {
+public:
+	pause_state(int policy);
+
+	int set_policy(int policy);
+	int get_policy(void);
+	int set_power_save_state(int state);
+
+	/* started and stopped by the user, which clears the pause */
+	void start(void);
+	void stop(void);
+
+	bool is_paused(void);
+
+private:
+	int update(void);
+
+	int m_policy;
+	int m_state;
+	bool m_started;
+	bool m_paused;
+};
+
+}
+
+#endif /* __PAUSE_STATE_H__ */
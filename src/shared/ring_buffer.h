@@ -0,0 +1,113 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+/************************************************************************
+ * fixed capacity FIFO for the windowed detectors.
+ *
+ * nothing is allocated after construction. pushing to a full buffer
+ * drops the oldest element, so the capacity has to cover the window at
+ * the fastest rate the detector is fed.
+ */
+template <typename T, int N>
+class ring_buffer {
+public:
+	ring_buffer()
+	: m_head(0)
+	, m_count(0)
+	{
+	}
+
+	void push(const T &value)
+	{
+		m_buffer[(m_head + m_count) % N] = value;
+
+		if (m_count < N)
+			++m_count;
+		else
+			m_head = (m_head + 1) % N;
+	}
+
+	void pop(void)
+	{
+		if (m_count == 0)
+			return;
+
+		m_head = (m_head + 1) % N;
+		--m_count;
+	}
+
+	/* oldest element */
+	const T &front(void) const
+	{
+		return m_buffer[m_head];
+	}
+
+	/* newest element */
+	const T &back(void) const
+	{
+		return m_buffer[(m_head + m_count - 1) % N];
+	}
+
+	/* i-th element, counted from the oldest */
+	T &operator[](int i)
+	{
+		return m_buffer[(m_head + i) % N];
+	}
+
+	const T &operator[](int i) const
+	{
+		return m_buffer[(m_head + i) % N];
+	}
+
+	int size(void) const
+	{
+		return m_count;
+	}
+
+	bool empty(void) const
+	{
+		return m_count == 0;
+	}
+
+	bool full(void) const
+	{
+		return m_count == N;
+	}
+
+	void clear(void)
+	{
+		m_head = 0;
+		m_count = 0;
+	}
+
+	static int capacity(void)
+	{
+		return N;
+	}
+
+private:
+	T m_buffer[N];
+	int m_head;
+	int m_count;
+};
+
+#endif /* __RING_BUFFER_H__ */
@@ -0,0 +1,198 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "sample_synchronizer.h"
+
+#include <string.h>
+#include <algorithm>
+
+/* samples kept per stream, a stream far ahead of the clock loses the oldest */
+#define SYNC_QUEUE_SIZE 256
+/* ticks the clock may lag behind the newest sample, e.g. after a pause,
+ * before it jumps forward rather than making a frame for each of them */
+#define SYNC_MAX_LAG 16
+
+#define VALUE_COUNT_MAX ((int)(sizeof(sensor_data_t::values) / sizeof(float)))
+
+using namespace sensor;
+
+sample_synchronizer::sample_synchronizer()
+: m_mode(SENSORD_SYNC_NEAREST)
+, m_period(0)
+, m_tolerance(0)
+, m_clock(0)
+, m_newest(0)
+{
+}
+
+void sample_synchronizer::set_streams(int count)
+{
+	m_queues.resize(std::min(std::max(count, 0), SYNC_MAX_STREAMS));
+	reset();
+}
+
+int sample_synchronizer::get_streams(void)
+{
+	return m_queues.size();
+}
+
+void sample_synchronizer::set_period(unsigned long long period)
+{
+	if (m_period == period)
+		return;
+
+	m_period = period;
+	reset();
+}
+
+void sample_synchronizer::set_mode(int mode, unsigned long long tolerance)
+{
+	m_mode = mode;
+	m_tolerance = tolerance;
+}
+
+void sample_synchronizer::reset(void)
+{
+	for (auto it = m_queues.begin(); it != m_queues.end(); ++it)
+		it->clear();
+
+	m_clock = 0;
+	m_newest = 0;
+}
+
+unsigned long long sample_synchronizer::get_tolerance(void)
+{
+	if (m_tolerance > 0)
+		return m_tolerance;
+
+	return (m_mode == SENSORD_SYNC_INTERPOLATE) ? m_period * 2 : m_period / 2;
+}
+
+void sample_synchronizer::push(int stream, const sensor_data_t &data, std::vector<sensor_data_t> &frames)
+{
+	int count = m_queues.size();
+
+	if (stream < 0 || stream >= count || m_period == 0)
+		return;
+
+	std::deque<sensor_data_t> &queue = m_queues[stream];
+
+	/* a sample older than the last one of its stream cannot be placed */
+	if (!queue.empty() && data.timestamp <= queue.back().timestamp)
+		return;
+
+	if (queue.size() >= SYNC_QUEUE_SIZE)
+		queue.pop_front();
+
+	queue.push_back(data);
+	m_newest = std::max(m_newest, data.timestamp);
+
+	if (m_clock == 0)
+		m_clock = data.timestamp;
+
+	if (m_newest > m_clock + m_period * SYNC_MAX_LAG)
+		m_clock += ((m_newest - m_clock) / m_period - SYNC_MAX_LAG) * m_period;
+
+	while (is_final(m_clock)) {
+		size_t frame = frames.size();
+
+		frames.resize(frame + count);
+
+		for (int i = 0; i < count; ++i)
+			make_record(i, m_clock, frames[frame + i]);
+
+		trim(m_clock);
+		m_clock += m_period;
+	}
+}
+
+bool sample_synchronizer::is_final(unsigned long long tick)
+{
+	if (m_newest >= tick + m_period + get_tolerance())
+		return true;
+
+	for (auto it = m_queues.begin(); it != m_queues.end(); ++it) {
+		if (it->empty() || it->back().timestamp < tick)
+			return false;
+	}
+
+	return true;
+}
+
+void sample_synchronizer::make_record(int stream, unsigned long long tick, sensor_data_t &out)
+{
+	std::deque<sensor_data_t> &queue = m_queues[stream];
+	const sensor_data_t *before = NULL;
+	const sensor_data_t *after = NULL;
+	unsigned long long tolerance = get_tolerance();
+
+	for (auto it = queue.begin(); it != queue.end(); ++it) {
+		if (it->timestamp > tick) {
+			after = &(*it);
+			break;
+		}
+		before = &(*it);
+	}
+
+	if (before && before->timestamp == tick) {
+		out = *before;
+		return;
+	}
+
+	if (m_mode == SENSORD_SYNC_INTERPOLATE) {
+		if (before && after && after->timestamp - before->timestamp <= tolerance) {
+			float ratio = (float)(tick - before->timestamp) /
+					(after->timestamp - before->timestamp);
+
+			out = *before;
+			out.accuracy = std::min(before->accuracy, after->accuracy);
+			out.timestamp = tick;
+			out.value_count = std::min(std::min(before->value_count, after->value_count),
+					VALUE_COUNT_MAX);
+
+			for (int i = 0; i < out.value_count; ++i)
+				out.values[i] += (after->values[i] - before->values[i]) * ratio;
+			return;
+		}
+	} else {
+		const sensor_data_t *nearest = before;
+
+		if (after && (!before || after->timestamp - tick < tick - before->timestamp))
+			nearest = after;
+
+		if (nearest && std::max(nearest->timestamp, tick) - std::min(nearest->timestamp, tick) <= tolerance) {
+			out = *nearest;
+			return;
+		}
+	}
+
+	/* nothing fits, the record says so */
+	memset(&out, 0, sizeof(out));
+	out.accuracy = -1;
+	out.timestamp = tick;
+}
+
+/* keeps the last sample at or before the tick, the next ticks may need it */
+void sample_synchronizer::trim(unsigned long long tick)
+{
+	for (auto it = m_queues.begin(); it != m_queues.end(); ++it) {
+		while (it->size() > 1 && (*it)[1].timestamp <= tick)
+			it->pop_front();
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SAMPLE_SYNCHRONIZER_H__
+#define __SAMPLE_SYNCHRONIZER_H__
+
+#include <sensor_types.h>
+#include <deque>
+#include <vector>
+
+#define SYNC_MAX_STREAMS SENSORD_SYNC_MAX_SENSORS
+
+namespace sensor {
+
+/* Aligns the samples of several sensors on the ticks of a common clock
+ * (see sensord_sync_e), so that they can be delivered as one frame per
+ * tick. A tick is made once every stream has a sample at or after it,
+ * or, for a stream that stalls, once the others are a period and the
+ * tolerance past it. The clock runs on the sample timestamps. */
+class sample_synchronizer {
+public:
+	sample_synchronizer();
+
+	void set_streams(int count);
+	int get_streams(void);
+
+	/* period and tolerance in us, a tolerance of 0 is the mode's default */
+	void set_period(unsigned long long period);
+	void set_mode(int mode, unsigned long long tolerance);
+
+	/* queues a sample of a stream, and appends the frames it completed to
+	 * frames, a record per stream each */
+	void push(int stream, const sensor_data_t &data, std::vector<sensor_data_t> &frames);
+	void reset(void);
+
+private:
+	unsigned long long get_tolerance(void);
+	bool is_final(unsigned long long tick);
+	void make_record(int stream, unsigned long long tick, sensor_data_t &out);
+	void trim(unsigned long long tick);
+
+	std::vector<std::deque<sensor_data_t>> m_queues;
+	int m_mode;
+	unsigned long long m_period;
+	unsigned long long m_tolerance;
+
+	/* next tick, 0 before the first sample */
+	unsigned long long m_clock;
+	unsigned long long m_newest;
+};
+
+}
+
+#endif /* __SAMPLE_SYNCHRONIZER_H__ */
@@ -31,6 +31,7 @@
 #include <sensor_log.h>
 #include <sensor_types.h>
 #include <sensor_types_private.h>
+#include <command_types.h>
 
 #ifndef PATH_MAX
 #define PATH_MAX 256
@@ -285,3 +286,19 @@ std::vector<std::string> sensor::utils::tokenize(const std::string &in, const ch
 	g_free(input);
 	return tokens;
 }
+
+std::shared_ptr<ipc::message> sensor::utils::create_event(const sensor_data_t *data, size_t count,
+		ipc::message &src)
+{
+	/* a size_t, an int would pick the error constructor of the message */
+	size_t size = count * sizeof(sensor_data_t);
+	auto msg = ipc::message::create(size);
+	retvm_if(!msg, nullptr, "Failed to allocate memory");
+
+	msg->header()->type = CMD_LISTENER_EVENT;
+	msg->header()->err = OP_SUCCESS;
+	msg->enclose(data, size);
+	*msg->trailer() = *src.trailer();
+
+	return msg;
+}
@@ -22,8 +22,10 @@
 
 #include <time.h>
 #include <sensor_types.h>
+#include <message.h>
 #include <string>
 #include <vector>
+#include <memory>
 
 namespace sensor {
 
@@ -39,6 +41,11 @@ namespace utils {
 	bool get_proc_name(pid_t pid, char *process_name);
 
 	std::vector<std::string> tokenize(const std::string &in, const char *delim);
+
+	/* count samples framed as a listener event with the delivery
+	 * timestamps of src, e.g. what is left of a batch of src */
+	std::shared_ptr<ipc::message> create_event(const sensor_data_t *data, size_t count,
+			ipc::message &src);
 }
 
 }
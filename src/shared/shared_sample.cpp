@@ -0,0 +1,198 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "shared_sample.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "sensor_log.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+/* a reader gives up after this, the writer only takes a memcpy */
+#define MAX_READ_RETRIES 64
+
+using namespace sensor;
+
+static int create_memfd(const char *name)
+{
+#ifdef __NR_memfd_create
+	return syscall(__NR_memfd_create, name, MFD_CLOEXEC);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+shared_sample::shared_sample()
+: m_fd(-1)
+, m_slot(NULL)
+, m_writable(false)
+{
+}
+
+shared_sample::~shared_sample()
+{
+	detach();
+}
+
+bool shared_sample::create(void)
+{
+	void *addr;
+
+	retv_if(is_valid(), false);
+
+	m_fd = create_memfd("sensord-sample");
+	if (m_fd < 0) {
+		_ERRNO(errno, _E, "Failed to create memfd");
+		return false;
+	}
+
+	if (ftruncate(m_fd, sizeof(shared_sample_slot_t)) < 0) {
+		_ERRNO(errno, _E, "Failed to resize memfd[%d]", m_fd);
+		detach();
+		return false;
+	}
+
+	addr = mmap(NULL, sizeof(shared_sample_slot_t), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	if (addr == MAP_FAILED) {
+		_ERRNO(errno, _E, "Failed to map memfd[%d]", m_fd);
+		detach();
+		return false;
+	}
+
+	/* ftruncate() zero-fills, so the sequence starts at 0: no sample yet */
+	m_slot = static_cast<shared_sample_slot_t *>(addr);
+	m_writable = true;
+
+	return true;
+}
+
+bool shared_sample::attach(int fd)
+{
+	void *addr;
+
+	retv_if(fd < 0, false);
+
+	if (is_valid())
+		detach();
+
+	m_fd = fd;
+
+	addr = mmap(NULL, sizeof(shared_sample_slot_t), PROT_READ, MAP_SHARED, m_fd, 0);
+	if (addr == MAP_FAILED) {
+		_ERRNO(errno, _E, "Failed to map fd[%d]", m_fd);
+		detach();
+		return false;
+	}
+
+	m_slot = static_cast<shared_sample_slot_t *>(addr);
+	m_writable = false;
+
+	return true;
+}
+
+void shared_sample::detach(void)
+{
+	if (m_slot)
+		munmap(m_slot, sizeof(shared_sample_slot_t));
+
+	if (m_fd >= 0)
+		::close(m_fd);
+
+	m_slot = NULL;
+	m_fd = -1;
+	m_writable = false;
+}
+
+bool shared_sample::is_valid(void) const
+{
+	return m_slot != NULL;
+}
+
+/* Reopening the memfd through /proc gives a new open file description
+ * with read-only access, so a client cannot map the segment writable
+ * even though the daemon's own descriptor is read-write */
+int shared_sample::get_readonly_fd(void) const
+{
+	char path[32];
+	int fd;
+
+	retv_if(m_fd < 0, -1);
+
+	snprintf(path, sizeof(path), "/proc/self/fd/%d", m_fd);
+
+	fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		_ERRNO(errno, _E, "Failed to reopen memfd[%d] read-only", m_fd);
+
+	return fd;
+}
+
+void shared_sample::write(const sensor_data_t &data, const sensor_data_t &display)
+{
+	ret_if(!m_writable);
+
+	uint32_t seq = __atomic_load_n(&m_slot->seq, __ATOMIC_RELAXED);
+
+	__atomic_store_n(&m_slot->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	memcpy(&m_slot->data, &data, sizeof(sensor_data_t));
+	memcpy(&m_slot->display, &display, sizeof(sensor_data_t));
+
+	__atomic_store_n(&m_slot->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+bool shared_sample::read(sensor_data_t &data, bool display, uint32_t &seq) const
+{
+	const sensor_data_t *src;
+	uint32_t begin;
+
+	retv_if(!m_slot, false);
+
+	src = display ? &m_slot->display : &m_slot->data;
+
+	for (int i = 0; i < MAX_READ_RETRIES; ++i) {
+		begin = __atomic_load_n(&m_slot->seq, __ATOMIC_ACQUIRE);
+
+		if (begin == seq)
+			return false;
+		if (begin & 1)
+			continue;
+
+		memcpy(&data, src, sizeof(sensor_data_t));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (__atomic_load_n(&m_slot->seq, __ATOMIC_RELAXED) == begin) {
+			seq = begin;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,69 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SHARED_SAMPLE_H__
+#define __SHARED_SAMPLE_H__
+
+#include <stdint.h>
+#include <sensor_types.h>
+
+namespace sensor {
+
+/* The latest sample of a sensor, in a memfd segment the daemon writes and
+ * the clients map read-only. The sequence is odd while a sample is being
+ * written, so a reader copies the sample out and retries if the sequence
+ * was odd or moved meanwhile (seqlock). There is a single writer per
+ * segment, the thread that notifies the sensor. */
+typedef struct {
+	uint32_t seq;
+	uint32_t reserved;
+	sensor_data_t data;	/* device oriented */
+	sensor_data_t display;	/* display oriented */
+} shared_sample_slot_t;
+
+class shared_sample {
+public:
+	shared_sample();
+	~shared_sample();
+
+	/* daemon: makes a new writable segment */
+	bool create(void);
+	/* client: maps a segment read-only, the fd is owned from now on */
+	bool attach(int fd);
+	void detach(void);
+	bool is_valid(void) const;
+
+	/* a new read-only descriptor of the segment, closed by the caller */
+	int get_readonly_fd(void) const;
+
+	void write(const sensor_data_t &data, const sensor_data_t &display);
+
+	/* copies the sample out if it is newer than seq, which is updated.
+	 * returns false if there is nothing new or the writer did not finish. */
+	bool read(sensor_data_t &data, bool display, uint32_t &seq) const;
+
+private:
+	int m_fd;
+	shared_sample_slot_t *m_slot;
+	bool m_writable;
+};
+
+}
+
+#endif /* __SHARED_SAMPLE_H__ */
@@ -302,6 +302,107 @@ ssize_t socket::send(const void *buffer, size_t size, bool select) const
 	return on_send(buffer, size);
 }
 
+/* gather-write in one syscall, never blocks; returns -errno on failure */
+ssize_t socket::send_nonblock(const struct iovec *iov, int count) const
+{
+	struct msghdr mh;
+	ssize_t len;
+
+	memset(&mh, 0, sizeof(mh));
+	mh.msg_iov = const_cast<struct iovec *>(iov);
+	mh.msg_iovlen = count;
+
+	do {
+		len = ::sendmsg(m_sock_fd, &mh, MSG_DONTWAIT | MSG_NOSIGNAL);
+	} while (len < 0 && errno == EINTR);
+
+	if (len < 0)
+		return -errno;
+
+	return len;
+}
+
+bool socket::send_fd(int fd) const
+{
+	char byte = 0;
+	char control[CMSG_SPACE(sizeof(int))];
+	struct iovec iov = {&byte, sizeof(byte)};
+	struct msghdr mh;
+	struct cmsghdr *cmsg;
+	fd_set write_fds;
+	ssize_t len;
+
+	memset(&mh, 0, sizeof(mh));
+	memset(control, 0, sizeof(control));
+	mh.msg_iov = &iov;
+	mh.msg_iovlen = 1;
+	mh.msg_control = control;
+	mh.msg_controllen = sizeof(control);
+
+	cmsg = CMSG_FIRSTHDR(&mh);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+	FD_ZERO(&write_fds);
+	FD_SET(m_sock_fd, &write_fds);
+	retvm_if(!select_fds(m_sock_fd, NULL, &write_fds, SOCK_TIMEOUT), false,
+			"Failed to send fd(timeout)");
+
+	do {
+		len = ::sendmsg(m_sock_fd, &mh, MSG_NOSIGNAL);
+	} while (len < 0 && errno == EINTR);
+
+	if (len != sizeof(byte)) {
+		_ERRNO(errno, _E, "Failed to send fd to socket[%d]", m_sock_fd);
+		return false;
+	}
+
+	return true;
+}
+
+int socket::recv_fd(void) const
+{
+	char byte;
+	char control[CMSG_SPACE(sizeof(int))];
+	struct iovec iov = {&byte, sizeof(byte)};
+	struct msghdr mh;
+	struct cmsghdr *cmsg;
+	fd_set read_fds;
+	ssize_t len;
+	int fd = -1;
+
+	memset(&mh, 0, sizeof(mh));
+	mh.msg_iov = &iov;
+	mh.msg_iovlen = 1;
+	mh.msg_control = control;
+	mh.msg_controllen = sizeof(control);
+
+	FD_ZERO(&read_fds);
+	FD_SET(m_sock_fd, &read_fds);
+	retvm_if(!select_fds(m_sock_fd, &read_fds, NULL, SOCK_TIMEOUT), -1,
+			"Failed to receive fd(timeout)");
+
+	do {
+		len = ::recvmsg(m_sock_fd, &mh, MSG_CMSG_CLOEXEC);
+	} while (len < 0 && errno == EINTR);
+
+	if (len != sizeof(byte)) {
+		_ERRNO(errno, _E, "Failed to receive fd from socket[%d]", m_sock_fd);
+		return -1;
+	}
+
+	cmsg = CMSG_FIRSTHDR(&mh);
+	if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+			cmsg->cmsg_len == CMSG_LEN(sizeof(int)))
+		memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+
+	retvm_if(fd < 0, -1, "No fd in the message from socket[%d]", m_sock_fd);
+
+	return fd;
+}
+
 ssize_t socket::recv(void* buffer, size_t size, bool select) const
 {
 	if (select) {
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <string>
 #include <atomic>
 
@@ -60,6 +61,11 @@ public:
 
 	ssize_t send(const void *buffer, size_t size, bool select = false) const;
 	ssize_t recv(void* buffer, size_t size, bool select = false) const;
+	ssize_t send_nonblock(const struct iovec *iov, int count) const;
+
+	/* passes a descriptor to the peer (SCM_RIGHTS), along with one byte */
+	bool send_fd(int fd) const;
+	int  recv_fd(void) const;
 
 protected:
 	bool create_by_type(const std::string &path, int type);
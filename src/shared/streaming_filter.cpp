@@ -0,0 +1,138 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "streaming_filter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+moving_average::moving_average(int size)
+: m_size(size)
+, m_index(0)
+, m_count(0)
+, m_sum(0)
+{
+	m_window = (double *)calloc(size, sizeof(double));
+}
+
+moving_average::~moving_average()
+{
+	free(m_window);
+}
+
+double moving_average::filter(double value)
+{
+	if (m_count < m_size) {
+		m_count++;
+		m_sum += value;
+	} else {
+		m_sum += value - m_window[m_index];
+	}
+
+	m_window[m_index++] = value;
+
+	if (m_index >= m_size) {
+		m_index = 0;
+
+		/* re-normalize against the drift of the running sum */
+		m_sum = 0;
+		for (int i = 0; i < m_count; ++i)
+			m_sum += m_window[i];
+	}
+
+	return m_sum / m_count;
+}
+
+void moving_average::filter(const float *in, float *out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = filter(in[i]);
+}
+
+double moving_average::sum(void) const
+{
+	return m_sum;
+}
+
+int moving_average::count(void) const
+{
+	return m_count;
+}
+
+void moving_average::reset(void)
+{
+	m_index = 0;
+	m_count = 0;
+	m_sum = 0;
+}
+
+fir_filter::fir_filter(const double *coefs, int size)
+: m_size(size)
+, m_index(0)
+, m_empty(true)
+{
+	m_coefs = (double *)malloc(size * sizeof(double));
+	m_buffer = (double *)calloc(2 * size, sizeof(double));
+
+	if (m_coefs)
+		memcpy(m_coefs, coefs, size * sizeof(double));
+}
+
+fir_filter::~fir_filter()
+{
+	free(m_coefs);
+	free(m_buffer);
+}
+
+double fir_filter::filter(double value)
+{
+	if (m_empty) {
+		for (int i = 0; i < 2 * m_size; ++i)
+			m_buffer[i] = value;
+		m_index = 0;
+		m_empty = false;
+		return value;
+	}
+
+	m_buffer[m_index] = value;
+	m_buffer[m_index + m_size] = value;
+
+	if (++m_index >= m_size)
+		m_index = 0;
+
+	/* the window of the last size samples, oldest first */
+	const double *window = m_buffer + m_index;
+	double result = 0;
+
+	for (int i = 0; i < m_size; ++i)
+		result += window[i] * m_coefs[i];
+
+	return result;
+}
+
+void fir_filter::filter(const float *in, float *out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = filter(in[i]);
+}
+
+void fir_filter::reset(void)
+{
+	m_empty = true;
+}
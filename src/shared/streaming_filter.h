@@ -0,0 +1,113 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __STREAMING_FILTER_H__
+#define __STREAMING_FILTER_H__
+
+/************************************************************************
+ * moving average over the last samples, updated with a running sum.
+ *
+ * until the window is full the average is taken over the samples seen
+ * so far. the sum is recomputed from the window once per window length
+ * so that rounding errors of the running sum do not accumulate.
+ */
+class moving_average {
+public:
+
+	moving_average(int size);
+
+	~moving_average();
+
+	/************************************************************************
+	 * adds a sample and returns the average of the window.
+	 */
+	double filter(double value);
+
+	/************************************************************************
+	 * filters n samples, in and out may be the same buffer.
+	 */
+	void filter(const float *in, float *out, int n);
+
+	/************************************************************************
+	 * @return sum of the samples in the window.
+	 */
+	double sum(void) const;
+
+	/************************************************************************
+	 * @return number of samples in the window.
+	 */
+	int count(void) const;
+
+	/************************************************************************
+	 * resets the filter to its initial, empty state.
+	 */
+	void reset(void);
+
+private:
+	double *m_window;
+	int m_size;
+	int m_index;
+	int m_count;
+	double m_sum;
+};
+
+/************************************************************************
+ * FIR filter over a ring buffer, e.g. a Savitzky-Golay smoother.
+ *
+ * samples are stored twice, at i and i + size, so the last size samples
+ * are always contiguous and no sample is ever shifted. the first sample
+ * after a reset fills the whole window and is returned as is.
+ */
+class fir_filter {
+public:
+
+	/************************************************************************
+	 * @param coefs
+	 *              coefficients, coefs[0] weights the oldest sample.
+	 * @param size
+	 *              number of coefficients.
+	 */
+	fir_filter(const double *coefs, int size);
+
+	~fir_filter();
+
+	/************************************************************************
+	 * adds a sample and returns the filtered value.
+	 */
+	double filter(double value);
+
+	/************************************************************************
+	 * filters n samples, in and out may be the same buffer.
+	 */
+	void filter(const float *in, float *out, int n);
+
+	/************************************************************************
+	 * resets the filter to its initial, empty state.
+	 */
+	void reset(void);
+
+private:
+	double *m_coefs;
+	double *m_buffer;
+	int m_size;
+	int m_index;
+	bool m_empty;
+};
+
+#endif /* __STREAMING_FILTER_H__ */
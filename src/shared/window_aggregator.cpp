@@ -0,0 +1,247 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "window_aggregator.h"
+
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+using namespace sensor;
+
+window_aggregator::window_aggregator()
+: m_function(SENSORD_AGGREGATION_NONE)
+, m_window(0)
+, m_hop(0)
+{
+	reset();
+}
+
+void window_aggregator::set_window(int function, unsigned long long window, unsigned long long hop)
+{
+	m_function = function;
+	m_window = window;
+	m_hop = (hop == 0 || hop >= window) ? window : hop;
+
+	reset();
+}
+
+int window_aggregator::get_function(void)
+{
+	return m_function;
+}
+
+bool window_aggregator::sliding(void)
+{
+	return m_hop < m_window;
+}
+
+void window_aggregator::reset(void)
+{
+	m_end = 0;
+	m_value_count = 0;
+	m_accuracy = 0;
+	m_count = 0;
+	m_expired = 0;
+
+	std::fill(m_shift, m_shift + AGGREGATOR_VALUE_COUNT, 0);
+	std::fill(m_sum, m_sum + AGGREGATOR_VALUE_COUNT, 0);
+	std::fill(m_sum_sq, m_sum_sq + AGGREGATOR_VALUE_COUNT, 0);
+
+	m_samples.clear();
+	m_extremes.clear();
+}
+
+bool window_aggregator::push(const sensor_data_t &data, sensor_data_t &out)
+{
+	bool closed = false;
+
+	if (m_function == SENSORD_AGGREGATION_NONE || m_window == 0)
+		return false;
+
+	/* the sensor was restarted or changed its values, start over */
+	if (m_end > 0 && (data.timestamp + m_window < m_end ||
+			std::min<int>(data.value_count, AGGREGATOR_VALUE_COUNT) != m_value_count))
+		reset();
+
+	if (m_end == 0) {
+		m_end = data.timestamp + m_window;
+		m_value_count = std::min<int>(data.value_count, AGGREGATOR_VALUE_COUNT);
+
+		for (int i = 0; i < m_value_count; ++i)
+			m_shift[i] = data.values[i];
+	}
+
+	if (data.timestamp >= m_end) {
+		if (sliding())
+			expire(m_end - m_window);
+
+		if (m_count > 0) {
+			aggregate(out);
+			out.timestamp = m_end;
+			closed = true;
+		}
+
+		/* on to the first window which holds the sample, skipping a gap */
+		m_end += ((data.timestamp - m_end) / m_hop + 1) * m_hop;
+
+		if (sliding()) {
+			expire(m_end - m_window);
+		} else {
+			m_count = 0;
+			std::fill(m_sum, m_sum + AGGREGATOR_VALUE_COUNT, 0);
+			std::fill(m_sum_sq, m_sum_sq + AGGREGATOR_VALUE_COUNT, 0);
+		}
+	}
+
+	add(data);
+
+	return closed;
+}
+
+void window_aggregator::add(const sensor_data_t &data)
+{
+	m_accuracy = data.accuracy;
+
+	for (int i = 0; i < m_value_count; ++i) {
+		float value = data.values[i];
+		double diff = value - m_shift[i];
+
+		m_sum[i] += diff;
+		m_sum_sq[i] += diff * diff;
+
+		if (m_count == 0 || value < m_min[i])
+			m_min[i] = value;
+		if (m_count == 0 || value > m_max[i])
+			m_max[i] = value;
+	}
+
+	m_count++;
+
+	if (!sliding())
+		return;
+
+	sample s;
+	s.timestamp = data.timestamp;
+	memcpy(s.values, data.values, m_value_count * sizeof(float));
+	m_samples.push_back(s);
+
+	if (m_function != SENSORD_AGGREGATION_MIN && m_function != SENSORD_AGGREGATION_MAX)
+		return;
+
+	m_extremes.resize(m_value_count);
+
+	/* a value is dropped once a later one is as extreme, so the front
+	 * of each queue is the extreme of the window */
+	for (int i = 0; i < m_value_count; ++i) {
+		extreme_queue &queue = m_extremes[i];
+		float value = data.values[i];
+
+		if (m_function == SENSORD_AGGREGATION_MIN) {
+			while (!queue.empty() && queue.back().second >= value)
+				queue.pop_back();
+		} else {
+			while (!queue.empty() && queue.back().second <= value)
+				queue.pop_back();
+		}
+
+		queue.push_back(std::make_pair(data.timestamp, value));
+	}
+}
+
+void window_aggregator::expire(unsigned long long start)
+{
+	while (!m_samples.empty() && m_samples.front().timestamp < start) {
+		const sample &s = m_samples.front();
+
+		for (int i = 0; i < m_value_count; ++i) {
+			double diff = s.values[i] - m_shift[i];
+
+			m_sum[i] -= diff;
+			m_sum_sq[i] -= diff * diff;
+		}
+
+		m_samples.pop_front();
+		m_count--;
+		m_expired++;
+	}
+
+	for (auto it = m_extremes.begin(); it != m_extremes.end(); ++it) {
+		while (!it->empty() && it->front().first < start)
+			it->pop_front();
+	}
+
+	/* the sums drift as samples come and go, so take them anew once as
+	 * many samples went as are kept */
+	if (m_expired > (int)m_samples.size())
+		resum();
+}
+
+void window_aggregator::resum(void)
+{
+	std::fill(m_sum, m_sum + AGGREGATOR_VALUE_COUNT, 0);
+	std::fill(m_sum_sq, m_sum_sq + AGGREGATOR_VALUE_COUNT, 0);
+
+	for (auto it = m_samples.begin(); it != m_samples.end(); ++it) {
+		for (int i = 0; i < m_value_count; ++i) {
+			double diff = it->values[i] - m_shift[i];
+
+			m_sum[i] += diff;
+			m_sum_sq[i] += diff * diff;
+		}
+	}
+
+	m_expired = 0;
+}
+
+void window_aggregator::aggregate(sensor_data_t &out)
+{
+	memset(&out, 0, sizeof(out));
+	out.accuracy = m_accuracy;
+	out.value_count = m_value_count;
+
+	if (m_function == SENSORD_AGGREGATION_COUNT) {
+		out.value_count = 1;
+		out.values[0] = m_count;
+		return;
+	}
+
+	for (int i = 0; i < m_value_count; ++i) {
+		double mean = m_sum[i] / m_count;
+		double variance = std::max(m_sum_sq[i] / m_count - mean * mean, 0.0);
+
+		switch (m_function) {
+		case SENSORD_AGGREGATION_MIN:
+			out.values[i] = sliding() ? m_extremes[i].front().second : m_min[i];
+			break;
+		case SENSORD_AGGREGATION_MAX:
+			out.values[i] = sliding() ? m_extremes[i].front().second : m_max[i];
+			break;
+		case SENSORD_AGGREGATION_MEAN:
+			out.values[i] = m_shift[i] + mean;
+			break;
+		case SENSORD_AGGREGATION_VARIANCE:
+			out.values[i] = variance;
+			break;
+		case SENSORD_AGGREGATION_RMS:
+			out.values[i] = sqrt(variance + (m_shift[i] + mean) * (m_shift[i] + mean));
+			break;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __WINDOW_AGGREGATOR_H__
+#define __WINDOW_AGGREGATOR_H__
+
+#include <sensor_types.h>
+#include <deque>
+#include <vector>
+
+#define AGGREGATOR_VALUE_COUNT (sizeof(sensor_data_t::values) / sizeof(float))
+
+namespace sensor {
+
+/* Min/max/mean/variance/RMS/count of each value of the samples over time
+ * windows (see sensord_aggregation_e), updated in amortized O(1) per sample.
+ * Tumbling windows keep running sums only. Sliding windows also keep their
+ * samples, for the sums to let them go, and a monotonic queue per value
+ * for min and max. */
+class window_aggregator {
+public:
+	window_aggregator();
+
+	/* window and hop in us. a hop of 0, or not shorter than the window,
+	 * makes tumbling windows. */
+	void set_window(int function, unsigned long long window, unsigned long long hop);
+	int get_function(void);
+
+	/* returns true if the sample closed a window, whose record is put in
+	 * out. a window without samples makes no record. */
+	bool push(const sensor_data_t &data, sensor_data_t &out);
+	void reset(void);
+
+private:
+	struct sample {
+		unsigned long long timestamp;
+		float values[AGGREGATOR_VALUE_COUNT];
+	};
+
+	typedef std::deque<std::pair<unsigned long long, float>> extreme_queue;
+
+	bool sliding(void);
+	void add(const sensor_data_t &data);
+	void expire(unsigned long long start);
+	void resum(void);
+	void aggregate(sensor_data_t &out);
+
+	int m_function;
+	unsigned long long m_window;
+	unsigned long long m_hop;
+
+	/* end of the window the next record is made for, 0 before a sample */
+	unsigned long long m_end;
+	int m_value_count;
+	int m_accuracy;
+
+	/* sums are taken around the first sample to keep the variance exact */
+	int m_count;
+	double m_shift[AGGREGATOR_VALUE_COUNT];
+	double m_sum[AGGREGATOR_VALUE_COUNT];
+	double m_sum_sq[AGGREGATOR_VALUE_COUNT];
+	float m_min[AGGREGATOR_VALUE_COUNT];
+	float m_max[AGGREGATOR_VALUE_COUNT];
+
+	/* sliding windows only */
+	std::deque<sample> m_samples;
+	std::vector<extreme_queue> m_extremes;
+	int m_expired;
+};
+
+}
+
+#endif /* __WINDOW_AGGREGATOR_H__ */
@@ -0,0 +1,53 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <sensor_log.h>
+#include <hal/hal-sensor-types.h>
+#include <vector>
+
+#include "synthetic_device.h"
+
+#define SYNTHETIC_CONF_ENV "SENSORD_SYNTHETIC_CONF"
+
+#ifndef SYNTHETIC_CONF_PATH
+#define SYNTHETIC_CONF_PATH "/etc/sensord/synthetic-hal.conf"
+#endif
+
+static std::vector<sensor_device_t> devices;
+
+extern "C" int create(sensor_device_t **fdevices)
+{
+	const char *path = getenv(SYNTHETIC_CONF_ENV);
+	synthetic_device *device;
+
+	device = new(std::nothrow) synthetic_device;
+	retvm_if(!device, 0, "Failed to allocate memory");
+
+	if (!device->init(path ? path : SYNTHETIC_CONF_PATH)) {
+		_E("Failed to create synthetic sensor device");
+		delete device;
+		return 0;
+	}
+
+	devices.push_back(device);
+	*fdevices = &devices[0];
+
+	return devices.size();
+}
@@ -0,0 +1,313 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "synthetic_device.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sensor_log.h>
+#include <sensor_utils.h>
+
+#define MAX_LINE 1024
+#define MAX_EVENTS 32
+#define FLUSH_EVENT_ID UINT32_MAX
+
+#define MODEL_NAME "synthetic"
+#define VENDOR_NAME "sensord"
+
+typedef struct {
+	const char *name;
+	sensor_device_type type;
+	int value_count;
+	float min_range;
+	float max_range;
+	float resolution;
+} synthetic_type_t;
+
+static const synthetic_type_t synthetic_types[] = {
+	{"accelerometer", SENSOR_DEVICE_ACCELEROMETER, 3, -19.6133f, 19.6133f, 0.0024f},
+	{"gravity", SENSOR_DEVICE_GRAVITY, 3, -19.6133f, 19.6133f, 0.0024f},
+	{"linear_accel", SENSOR_DEVICE_LINEAR_ACCELERATION, 3, -19.6133f, 19.6133f, 0.0024f},
+	{"magnetic", SENSOR_DEVICE_GEOMAGNETIC, 3, -1200.0f, 1200.0f, 0.6f},
+	{"gyroscope", SENSOR_DEVICE_GYROSCOPE, 3, -573.0f, 573.0f, 0.06f},
+	{"light", SENSOR_DEVICE_LIGHT, 1, 0.0f, 65536.0f, 1.0f},
+	{"proximity", SENSOR_DEVICE_PROXIMITY, 1, 0.0f, 5.0f, 5.0f},
+	{"pressure", SENSOR_DEVICE_PRESSURE, 1, 260.0f, 1260.0f, 0.01f},
+};
+
+/* used if there is no configuration file */
+static const char *default_conf[] = {
+	"accelerometer 100 0 0 sine:9.8:0.2",
+	"gyroscope 100 0 0 sine:30:0.5",
+	"magnetic 50 0 0 noise:5:30",
+	"light 10 0 0 saw:500:0.1:500",
+};
+
+synthetic_device::synthetic_device()
+: m_poll_fd(-1)
+, m_flush_fd(-1)
+{
+}
+
+synthetic_device::~synthetic_device()
+{
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it)
+		delete *it;
+
+	if (m_flush_fd >= 0)
+		close(m_flush_fd);
+	if (m_poll_fd >= 0)
+		close(m_poll_fd);
+}
+
+bool synthetic_device::init(const char *conf_path)
+{
+	struct epoll_event event;
+
+	m_poll_fd = epoll_create1(EPOLL_CLOEXEC);
+	retvm_if(m_poll_fd < 0, false, "Failed to create epoll[%d]", errno);
+
+	/* wakes sensord up when a flush was requested */
+	m_flush_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	retvm_if(m_flush_fd < 0, false, "Failed to create eventfd[%d]", errno);
+
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u32 = FLUSH_EVENT_ID;
+	retvm_if(epoll_ctl(m_poll_fd, EPOLL_CTL_ADD, m_flush_fd, &event) < 0, false,
+			"Failed to add eventfd[%d]", errno);
+
+	if (!load_conf(conf_path)) {
+		_I("Use the default synthetic sensors");
+
+		for (size_t i = 0; i < sizeof(default_conf) / sizeof(default_conf[0]); ++i)
+			add_sensor(default_conf[i]);
+	}
+
+	retvm_if(m_sensors.empty(), false, "No synthetic sensor");
+
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it)
+		m_infos.push_back((*it)->get_info());
+
+	return true;
+}
+
+/* Each line describes a sensor:
+ *   <type> <rate(Hz)> <fifo(samples)> <jitter(us)> <signal> [fixed]
+ * e.g. "accelerometer 400 64 200 sine:2:1:9.8 fixed" */
+bool synthetic_device::load_conf(const char *path)
+{
+	retv_if(!path, false);
+
+	FILE *fp = fopen(path, "r");
+	retv_if(!fp, false);
+
+	char line[MAX_LINE];
+
+	while (fgets(line, sizeof(line), fp)) {
+		line[strcspn(line, "\r\n")] = '\0';
+
+		if (line[0] == '#' || line[strspn(line, " \t")] == '\0')
+			continue;
+
+		if (!add_sensor(line))
+			_E("Invalid line in %s : %s", path, line);
+	}
+
+	fclose(fp);
+
+	_I("Loaded %d synthetic sensors from %s", (int)m_sensors.size(), path);
+	return true;
+}
+
+bool synthetic_device::add_sensor(const std::string &line)
+{
+	char type_name[64];
+	char spec[MAX_LINE];
+	char option[16] = "";
+	float rate;
+	int fifo;
+	int jitter;
+	const synthetic_type_t *type = NULL;
+	synthetic_signal signal;
+
+	int count = sscanf(line.c_str(), "%63s %f %d %d %1023s %15s",
+			type_name, &rate, &fifo, &jitter, spec, option);
+	retv_if(count < 5 || rate <= 0 || fifo < 0 || jitter < 0, false);
+
+	for (size_t i = 0; i < sizeof(synthetic_types) / sizeof(synthetic_types[0]); ++i) {
+		if (!strcmp(synthetic_types[i].name, type_name))
+			type = &synthetic_types[i];
+	}
+
+	retvm_if(!type, false, "Unknown sensor type[%s]", type_name);
+	retv_if(!signal.parse(spec), false);
+
+	/* sensors of the same type get distinct names, and so distinct URIs */
+	int index = 0;
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
+		if ((*it)->get_info().type == type->type)
+			index++;
+	}
+
+	std::string name = std::string(MODEL_NAME "_") + type->name;
+	if (index > 0)
+		name += std::to_string(index);
+
+	unsigned long long period = 1000000ULL / rate;
+	sensor_info_t info;
+
+	memset(&info, 0, sizeof(info));
+	info.id = m_sensors.size() + 1;
+	info.name = name.c_str();
+	info.type = type->type;
+	info.event_type = (type->type << 16) | 0x0001;
+	info.model_name = MODEL_NAME;
+	info.vendor = VENDOR_NAME;
+	info.min_range = type->min_range;
+	info.max_range = type->max_range;
+	info.resolution = type->resolution;
+	info.min_interval = std::max<int>(period / 1000, 1);
+	info.max_interval = 1000;
+	info.max_batch_count = fifo;
+	info.wakeup_supported = false;
+
+	synthetic_sensor *sensor = new(std::nothrow) synthetic_sensor(info,
+			type->value_count, period, jitter, !strcmp(option, "fixed"), signal);
+	retvm_if(!sensor, false, "Failed to allocate memory");
+
+	struct epoll_event event;
+
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u32 = info.id;
+
+	if (!sensor->init() || epoll_ctl(m_poll_fd, EPOLL_CTL_ADD, sensor->get_fd(), &event) < 0) {
+		_E("Failed to initialize %s", name.c_str());
+		delete sensor;
+		return false;
+	}
+
+	m_sensors.push_back(sensor);
+	return true;
+}
+
+synthetic_sensor *synthetic_device::get_sensor(uint32_t id)
+{
+	retv_if(id == 0 || id > m_sensors.size(), NULL);
+
+	return m_sensors[id - 1];
+}
+
+int synthetic_device::get_poll_fd(void)
+{
+	return m_poll_fd;
+}
+
+int synthetic_device::get_sensors(const sensor_info_t **sensors)
+{
+	*sensors = m_infos.data();
+	return m_infos.size();
+}
+
+bool synthetic_device::enable(uint32_t id)
+{
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, false);
+
+	return sensor->enable();
+}
+
+bool synthetic_device::disable(uint32_t id)
+{
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, false);
+
+	return sensor->disable();
+}
+
+int synthetic_device::read_fd(uint32_t **ids)
+{
+	struct epoll_event events[MAX_EVENTS];
+	unsigned long long now = sensor::utils::get_timestamp();
+	uint64_t value;
+
+	m_ids.clear();
+
+	int count = epoll_wait(m_poll_fd, events, MAX_EVENTS, 0);
+
+	for (int i = 0; i < count; ++i) {
+		if (events[i].data.u32 != FLUSH_EVENT_ID)
+			continue;
+
+		if (read(m_flush_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+			_E("Failed to read eventfd[%d]", errno);
+	}
+
+	/* every sensor is checked, since one may be ready without its timer, e.g. when flushed */
+	for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it) {
+		if ((*it)->update(now))
+			m_ids.push_back((*it)->get_info().id);
+	}
+
+	*ids = m_ids.data();
+	return m_ids.size();
+}
+
+int synthetic_device::get_data(uint32_t id, sensor_data_t **data, int *length)
+{
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, -EINVAL);
+
+	return sensor->get_data(data, length);
+}
+
+bool synthetic_device::set_interval(uint32_t id, unsigned long val)
+{
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, false);
+
+	return sensor->set_interval(val);
+}
+
+bool synthetic_device::set_batch_latency(uint32_t id, unsigned long val)
+{
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, false);
+
+	return sensor->set_batch_latency(val);
+}
+
+bool synthetic_device::flush(uint32_t id)
+{
+	uint64_t value = 1;
+	synthetic_sensor *sensor = get_sensor(id);
+	retv_if(!sensor, false);
+
+	sensor->flush();
+
+	retvm_if(write(m_flush_fd, &value, sizeof(value)) < 0, false,
+			"Failed to write eventfd[%d]", errno);
+
+	return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SYNTHETIC_DEVICE_H__
+#define __SYNTHETIC_DEVICE_H__
+
+#include <hal/hal-sensor-types.h>
+#include <string>
+#include <vector>
+
+#include "synthetic_sensor.h"
+
+/* A sensor_device whose sensors are generated instead of read from
+ * hardware, so the whole daemon can be loaded without real sensors.
+ * All sensors share one epoll fd, which is what sensord polls. */
+class synthetic_device : public sensor_device {
+public:
+	synthetic_device();
+	virtual ~synthetic_device();
+
+	bool init(const char *conf_path);
+
+	int get_poll_fd(void);
+	int get_sensors(const sensor_info_t **sensors);
+
+	bool enable(uint32_t id);
+	bool disable(uint32_t id);
+
+	int read_fd(uint32_t **ids);
+	int get_data(uint32_t id, sensor_data_t **data, int *length);
+
+	bool set_interval(uint32_t id, unsigned long val);
+	bool set_batch_latency(uint32_t id, unsigned long val);
+	bool flush(uint32_t id);
+
+private:
+	bool load_conf(const char *path);
+	bool add_sensor(const std::string &line);
+	synthetic_sensor *get_sensor(uint32_t id);
+
+	int m_poll_fd;
+	int m_flush_fd;
+
+	std::vector<synthetic_sensor *> m_sensors;
+	std::vector<sensor_info_t> m_infos;
+	std::vector<uint32_t> m_ids;
+};
+
+#endif /* __SYNTHETIC_DEVICE_H__ */
@@ -0,0 +1,245 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "synthetic_sensor.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <algorithm>
+#include <sensor_log.h>
+#include <sensor_utils.h>
+
+#define US_PER_MS 1000ULL
+#define US_PER_SEC 1000000ULL
+
+synthetic_sensor::synthetic_sensor(const sensor_info_t &info, int value_count,
+		unsigned long long period, unsigned long long jitter,
+		bool fixed, const synthetic_signal &signal)
+: m_info(info)
+, m_name(info.name)
+, m_model(info.model_name)
+, m_vendor(info.vendor)
+, m_signal(signal)
+, m_fd(-1)
+, m_value_count(std::min(value_count, SENSOR_DATA_VALUE_SIZE))
+, m_enabled(false)
+, m_fixed(fixed)
+, m_flush(false)
+, m_min_period(std::max(period, 1ULL))
+, m_period(m_min_period)
+, m_latency(0)
+, m_jitter(jitter)
+, m_nominal(0)
+, m_next(0)
+, m_seed(info.id + 1)
+{
+	/* the info must not point into the caller's strings */
+	m_info.name = m_name.c_str();
+	m_info.model_name = m_model.c_str();
+	m_info.vendor = m_vendor.c_str();
+}
+
+synthetic_sensor::~synthetic_sensor()
+{
+	if (m_fd >= 0)
+		close(m_fd);
+}
+
+bool synthetic_sensor::init(void)
+{
+	m_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	retvm_if(m_fd < 0, false, "Failed to create timerfd[%d]", errno);
+
+	return true;
+}
+
+int synthetic_sensor::get_fd(void)
+{
+	return m_fd;
+}
+
+const sensor_info_t &synthetic_sensor::get_info(void)
+{
+	return m_info;
+}
+
+bool synthetic_sensor::enable(void)
+{
+	retv_if(m_enabled, true);
+
+	m_enabled = true;
+	m_fifo.clear();
+	m_nominal = sensor::utils::get_timestamp() + m_period;
+	m_next = m_nominal;
+
+	schedule();
+	return true;
+}
+
+bool synthetic_sensor::disable(void)
+{
+	struct itimerspec spec;
+
+	retv_if(!m_enabled, true);
+
+	memset(&spec, 0, sizeof(spec));
+	timerfd_settime(m_fd, 0, &spec, NULL);
+
+	m_enabled = false;
+	m_fifo.clear();
+
+	return true;
+}
+
+/* interval and latency are in ms, like every HAL */
+bool synthetic_sensor::set_interval(unsigned long interval)
+{
+	/* a sensor with a fixed output rate leaves the thinning out to sensord */
+	retv_if(m_fixed, true);
+
+	m_period = std::max(interval * US_PER_MS, m_min_period);
+
+	if (m_enabled) {
+		m_nominal = sensor::utils::get_timestamp() + m_period;
+		m_next = m_nominal;
+		schedule();
+	}
+
+	return true;
+}
+
+bool synthetic_sensor::set_batch_latency(unsigned long latency)
+{
+	m_latency = latency * US_PER_MS;
+	return true;
+}
+
+bool synthetic_sensor::flush(void)
+{
+	m_flush = true;
+	return true;
+}
+
+void synthetic_sensor::schedule(void)
+{
+	struct itimerspec spec;
+
+	memset(&spec, 0, sizeof(spec));
+	spec.it_value.tv_sec = m_next / US_PER_SEC;
+	spec.it_value.tv_nsec = (m_next % US_PER_SEC) * 1000;
+
+	if (timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0)
+		_E("Failed to set timerfd[%d]", errno);
+}
+
+void synthetic_sensor::push(unsigned long long timestamp)
+{
+	sensor_data_t data;
+	size_t capacity = (m_info.max_batch_count > 0) ?
+			m_info.max_batch_count : SYNTHETIC_QUEUE_MAX;
+
+	memset(&data, 0, sizeof(data));
+	data.accuracy = SENSOR_ACCURACY_GOOD;
+	data.timestamp = timestamp;
+	data.value_count = m_value_count;
+	m_signal.generate(timestamp, data.values, m_value_count);
+
+	/* a full FIFO overwrites its oldest sample, as hardware does */
+	if (m_fifo.size() >= capacity)
+		m_fifo.erase(m_fifo.begin());
+
+	m_fifo.push_back(data);
+}
+
+bool synthetic_sensor::update(unsigned long long now)
+{
+	uint64_t expirations;
+
+	/* the timerfd is non-blocking, nothing to read is fine */
+	if (read(m_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+		_E("Failed to read timerfd[%d]", errno);
+
+	if (m_enabled) {
+		int count = 0;
+
+		/* every slot that passed is generated, even if sensord was late */
+		while (m_next <= now) {
+			/* after a long stall, start over instead of catching up */
+			if (++count > SYNTHETIC_QUEUE_MAX) {
+				m_nominal = now + m_period;
+				m_next = m_nominal;
+				break;
+			}
+
+			unsigned long long last = m_next;
+
+			push(m_next);
+
+			m_nominal += m_period;
+			m_next = m_nominal;
+
+			if (m_jitter > 0) {
+				long long offset = (long long)(rand_r(&m_seed) % (2 * m_jitter + 1)) - m_jitter;
+				m_next = std::max<long long>(m_nominal + offset, last + 1);
+			}
+		}
+
+		schedule();
+	}
+
+	return is_ready(now);
+}
+
+bool synthetic_sensor::is_ready(unsigned long long now)
+{
+	retv_if(m_fifo.empty(), false);
+	retv_if(m_flush || m_latency == 0 || m_info.max_batch_count <= 0, true);
+
+	unsigned long long watermark = std::max<unsigned long long>(m_latency / m_period, 1);
+
+	if (m_fifo.size() >= std::min<unsigned long long>(watermark, m_info.max_batch_count))
+		return true;
+
+	return (now - m_fifo.front().timestamp >= m_latency);
+}
+
+int synthetic_sensor::get_data(sensor_data_t **data, int *length)
+{
+	*data = NULL;
+	*length = 0;
+
+	retv_if(m_fifo.empty(), 0);
+
+	size_t size = m_fifo.size() * sizeof(sensor_data_t);
+
+	/* sensord takes the ownership and frees it */
+	*data = (sensor_data_t *)malloc(size);
+	retvm_if(!*data, -ENOMEM, "Failed to allocate memory");
+
+	memcpy(*data, m_fifo.data(), size);
+	*length = size;
+
+	m_fifo.clear();
+	m_flush = false;
+
+	return 0;
+}
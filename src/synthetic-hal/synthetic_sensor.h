@@ -0,0 +1,86 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SYNTHETIC_SENSOR_H__
+#define __SYNTHETIC_SENSOR_H__
+
+#include <hal/hal-sensor-types.h>
+#include <string>
+#include <vector>
+
+#include "synthetic_signal.h"
+
+/* samples kept while nobody reads them, if the sensor has no FIFO of its own */
+#define SYNTHETIC_QUEUE_MAX 1024
+
+/* One sensor generating samples on a timerfd.
+ * Samples are timestamped on a regular grid plus jitter, go into a
+ * simulated FIFO and are reported once the batch latency allows it. */
+class synthetic_sensor {
+public:
+	/* period is the shortest one in us, jitter the largest deviation in us */
+	synthetic_sensor(const sensor_info_t &info, int value_count,
+			unsigned long long period, unsigned long long jitter,
+			bool fixed, const synthetic_signal &signal);
+	~synthetic_sensor();
+
+	bool init(void);
+
+	int get_fd(void);
+	const sensor_info_t &get_info(void);
+
+	bool enable(void);
+	bool disable(void);
+	bool set_interval(unsigned long interval);
+	bool set_batch_latency(unsigned long latency);
+	bool flush(void);
+
+	/* generates the samples that are due, returns true if they should be read */
+	bool update(unsigned long long now);
+	int get_data(sensor_data_t **data, int *length);
+
+private:
+	void schedule(void);
+	void push(unsigned long long timestamp);
+	bool is_ready(unsigned long long now);
+
+	sensor_info_t m_info;
+	std::string m_name;
+	std::string m_model;
+	std::string m_vendor;
+	synthetic_signal m_signal;
+
+	int m_fd;
+	int m_value_count;
+	bool m_enabled;
+	bool m_fixed;
+	bool m_flush;
+
+	unsigned long long m_min_period;	/* us */
+	unsigned long long m_period;	/* us */
+	unsigned long long m_latency;	/* us */
+	unsigned long long m_jitter;	/* us */
+	unsigned long long m_nominal;	/* next sample without jitter */
+	unsigned long long m_next;	/* next sample */
+	unsigned int m_seed;
+
+	std::vector<sensor_data_t> m_fifo;
+};
+
+#endif /* __SYNTHETIC_SENSOR_H__ */
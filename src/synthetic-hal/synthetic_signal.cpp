@@ -0,0 +1,155 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "synthetic_signal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sensor_log.h>
+
+#define AXIS_PHASE (2.0 * M_PI / 3.0)
+#define MAX_LINE 1024
+
+synthetic_signal::synthetic_signal()
+: m_type(SIGNAL_CONST)
+, m_amplitude(0)
+, m_frequency(0)
+, m_offset(0)
+, m_seed(1)
+, m_index(0)
+{
+}
+
+bool synthetic_signal::parse(const std::string &spec)
+{
+	std::string kind = spec.substr(0, spec.find(':'));
+	std::string args = (kind.size() < spec.size()) ? spec.substr(kind.size() + 1) : "";
+	float params[3] = {0, 0, 0};
+	int count = 0;
+
+	if (kind == "file") {
+		m_type = SIGNAL_FILE;
+		return load(args);
+	}
+
+	count = sscanf(args.c_str(), "%f:%f:%f", &params[0], &params[1], &params[2]);
+
+	if (kind == "const" && count >= 1) {
+		m_type = SIGNAL_CONST;
+		m_offset = params[0];
+	} else if (kind == "noise" && count >= 1) {
+		m_type = SIGNAL_NOISE;
+		m_amplitude = params[0];
+		m_offset = params[1];
+	} else if ((kind == "sine" || kind == "square" || kind == "saw") && count >= 2) {
+		m_type = (kind == "sine") ? SIGNAL_SINE : (kind == "square") ? SIGNAL_SQUARE : SIGNAL_SAW;
+		m_amplitude = params[0];
+		m_frequency = params[1];
+		m_offset = params[2];
+	} else {
+		_E("Invalid signal[%s]", spec.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool synthetic_signal::load(const std::string &path)
+{
+	FILE *fp = fopen(path.c_str(), "r");
+	retvm_if(!fp, false, "Failed to open %s", path.c_str());
+
+	char line[MAX_LINE];
+
+	while (fgets(line, sizeof(line), fp)) {
+		std::vector<float> sample;
+		char *pos = line;
+		char *end;
+
+		if (line[0] == '#')
+			continue;
+
+		while (true) {
+			float value = strtof(pos, &end);
+			if (end == pos)
+				break;
+
+			sample.push_back(value);
+			pos = end + strspn(end, " \t,");
+		}
+
+		if (!sample.empty())
+			m_samples.push_back(sample);
+	}
+
+	fclose(fp);
+
+	retvm_if(m_samples.empty(), false, "No samples in %s", path.c_str());
+	return true;
+}
+
+/* one period of the waveform, in [-1, 1] */
+float synthetic_signal::wave(double phase)
+{
+	double cycle = phase / (2.0 * M_PI);
+
+	cycle -= floor(cycle);
+
+	switch (m_type) {
+	case SIGNAL_SINE:
+		return sin(phase);
+	case SIGNAL_SQUARE:
+		return (cycle < 0.5) ? 1.0f : -1.0f;
+	case SIGNAL_SAW:
+		return 2.0 * cycle - 1.0;
+	default:
+		return 0;
+	}
+}
+
+void synthetic_signal::generate(unsigned long long timestamp, float *values, int count)
+{
+	double phase = 2.0 * M_PI * m_frequency * (timestamp / 1000000.0);
+
+	if (m_type == SIGNAL_FILE) {
+		const std::vector<float> &sample = m_samples[m_index];
+
+		for (int i = 0; i < count; ++i)
+			values[i] = (i < (int)sample.size()) ? sample[i] : 0;
+
+		m_index = (m_index + 1) % m_samples.size();
+		return;
+	}
+
+	for (int i = 0; i < count; ++i) {
+		switch (m_type) {
+		case SIGNAL_CONST:
+			values[i] = m_offset;
+			break;
+		case SIGNAL_NOISE:
+			values[i] = m_offset + m_amplitude * (2.0f * rand_r(&m_seed) / RAND_MAX - 1.0f);
+			break;
+		default:
+			values[i] = m_offset + m_amplitude * wave(phase + i * AXIS_PHASE);
+			break;
+		}
+	}
+}
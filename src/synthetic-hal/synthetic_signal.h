@@ -0,0 +1,63 @@
+/*
+ * sensord
+ *
+ * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __SYNTHETIC_SIGNAL_H__
+#define __SYNTHETIC_SIGNAL_H__
+
+#include <string>
+#include <vector>
+
+/* Source of the values of a synthetic sensor, parsed from a spec:
+ *   const:<value>
+ *   sine|square|saw:<amplitude>:<frequency>[:<offset>]
+ *   noise:<amplitude>[:<offset>]
+ *   file:<path>	one sample per line, replayed in a loop */
+class synthetic_signal {
+public:
+	synthetic_signal();
+
+	bool parse(const std::string &spec);
+
+	/* timestamp is in us, the axes of a waveform are 120 degrees apart */
+	void generate(unsigned long long timestamp, float *values, int count);
+
+private:
+	enum signal_type {
+		SIGNAL_CONST,
+		SIGNAL_SINE,
+		SIGNAL_SQUARE,
+		SIGNAL_SAW,
+		SIGNAL_NOISE,
+		SIGNAL_FILE,
+	};
+
+	bool load(const std::string &path);
+	float wave(double phase);
+
+	signal_type m_type;
+	float m_amplitude;
+	float m_frequency;
+	float m_offset;
+	unsigned int m_seed;
+
+	std::vector<std::vector<float>> m_samples;
+	size_t m_index;
+};
+
+#endif /* __SYNTHETIC_SIGNAL_H__ */